@@ -338,6 +338,12 @@ installers.  The most commonly-used variables are:
 
   Other compression methods ignore this value and use only one thread.
 
+  .. versionadded:: 4.2
+
+    When :variable:`CPACK_COMPONENTS_PARALLEL` is enabled, the Archive
+    and DEB generators write several component packages at once and
+    share these threads among their compressors.
+
 Variables for Source Package Generators
 ^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
 
@@ -84,6 +84,22 @@ The following variables influence the component-specific packaging:
  * ALL_COMPONENTS_IN_ONE : create a single package with all requested
    components
 
+.. variable:: CPACK_COMPONENTS_PARALLEL
+
+ .. versionadded:: 4.2
+
+ If enabled, the Archive and DEB generators write the packages of
+ the components or component groups concurrently.  A positive integer
+ gives the number of packages written at the same time.  Any other true
+ value writes as many packages at the same time as the host has logical
+ processors.  By default packages are written one after the other.
+
+ This setting does not depend on :variable:`CPACK_THREADS`, which
+ defaults to a single thread.  The compression threads it gives are
+ shared by the packages written at the same time, with at least one
+ thread for each package.  The install step and the package scripts
+ still run one at a time.
+
 .. variable:: CPACK_COMPONENT_<compName>_DISPLAY_NAME
 
  The name to be displayed for a component.
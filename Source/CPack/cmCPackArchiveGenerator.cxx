@@ -4,6 +4,8 @@
 
 #include <map>
 #include <ostream>
+#include <sstream>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -41,21 +43,21 @@ private:
    * @brief Compares a file with already processed files.
    *
    * @param path The path of the file to compare.
-   * @param localTopLevel The top-level directory for the file.
+   * @param fullPath The path of the file on disk.
    * @return DeduplicateStatus indicating whether to add, skip, or flag an
    * error for the file.
    */
   DeduplicateStatus CompareFile(std::string const& path,
-                                std::string const& localTopLevel)
+                                std::string const& fullPath)
   {
     auto fileItr = this->Files.find(path);
     if (fileItr != this->Files.end()) {
-      return cmSystemTools::FilesDiffer(path, fileItr->second)
+      return cmSystemTools::FilesDiffer(fullPath, fileItr->second)
         ? DeduplicateStatus::Error
         : DeduplicateStatus::Skip;
     }
 
-    this->Files[path] = cmStrCat(localTopLevel, '/', path);
+    this->Files[path] = fullPath;
     return DeduplicateStatus::Add;
   }
 
@@ -79,14 +81,16 @@ private:
    * @brief Compares a symlink with already processed symlinks.
    *
    * @param path The path of the symlink to compare.
+   * @param fullPath The path of the symlink on disk.
    * @return DeduplicateStatus indicating whether to add, skip, or flag an
    * error for the symlink.
    */
-  DeduplicateStatus CompareSymlink(std::string const& path)
+  DeduplicateStatus CompareSymlink(std::string const& path,
+                                   std::string const& fullPath)
   {
     auto symlinkItr = this->Symlink.find(path);
     std::string symlinkValue;
-    auto status = cmSystemTools::ReadSymlink(path, symlinkValue);
+    auto status = cmSystemTools::ReadSymlink(fullPath, symlinkValue);
     if (!status.IsSuccess()) {
       return DeduplicateStatus::Error;
     }
@@ -115,13 +119,14 @@ public:
   DeduplicateStatus IsDeduplicate(std::string const& path,
                                   std::string const& localTopLevel)
   {
+    std::string const fullPath = cmStrCat(localTopLevel, '/', path);
     DeduplicateStatus status;
-    if (cmSystemTools::FileIsDirectory(path)) {
+    if (cmSystemTools::FileIsDirectory(fullPath)) {
       status = this->CompareFolder(path);
-    } else if (cmSystemTools::FileIsSymlink(path)) {
-      status = this->CompareSymlink(path);
+    } else if (cmSystemTools::FileIsSymlink(fullPath)) {
+      status = this->CompareSymlink(path, fullPath);
     } else {
-      status = this->CompareFile(path, localTopLevel);
+      status = this->CompareFile(path, fullPath);
     }
 
     return status;
@@ -245,34 +250,45 @@ int cmCPackArchiveGenerator::InitializeInternal()
   return this->Superclass::InitializeInternal();
 }
 
-int cmCPackArchiveGenerator::addOneComponentToArchive(
-  cmArchiveWrite& archive, cmCPackComponent* component,
-  Deduplicator* deduplicator)
+cmCPackArchiveGenerator::ComponentFiles
+cmCPackArchiveGenerator::GetComponentFiles(cmCPackComponent const& component)
 {
-  cmCPackLogger(cmCPackLog::LOG_VERBOSE,
-                "   - packaging component: " << component->Name << std::endl);
-  // Add the files of this component to the archive
-  std::string localToplevel(this->GetOption("CPACK_TEMPORARY_DIRECTORY"));
-  localToplevel += "/" + this->GetSanitizedDirOrFileName(component->Name);
-  // Change to local toplevel
-  cmWorkingDirectory workdir(localToplevel);
-  if (workdir.Failed()) {
-    cmCPackLogger(cmCPackLog::LOG_ERROR, workdir.GetError() << std::endl);
-    return 0;
-  }
-  std::string filePrefix;
+  ComponentFiles result;
+  result.Name = component.Name;
+  result.Directory =
+    cmStrCat(this->GetOption("CPACK_TEMPORARY_DIRECTORY"), '/',
+             this->GetSanitizedDirOrFileName(component.Name));
   if (this->IsOn("CPACK_COMPONENT_INCLUDE_TOPLEVEL_DIRECTORY")) {
-    filePrefix = cmStrCat(this->GetOption("CPACK_PACKAGE_FILE_NAME"), '/');
+    result.Prefix = cmStrCat(this->GetOption("CPACK_PACKAGE_FILE_NAME"), '/');
   }
   cmValue installPrefix = this->GetOption("CPACK_PACKAGING_INSTALL_PREFIX");
   if (installPrefix && installPrefix->size() > 1 &&
       (*installPrefix)[0] == '/') {
     // add to file prefix and remove the leading '/'
-    filePrefix += installPrefix->substr(1);
-    filePrefix += "/";
+    result.Prefix += installPrefix->substr(1);
+    result.Prefix += "/";
   }
-  for (std::string const& file : component->Files) {
-    std::string rp = filePrefix + file;
+  result.Files = &component.Files;
+  return result;
+}
+
+int cmCPackArchiveGenerator::addOneComponentToArchive(
+  cmArchiveWrite& archive, ComponentFiles const& component,
+  Deduplicator* deduplicator) const
+{
+  cmCPackLogger(cmCPackLog::LOG_VERBOSE,
+                "   - packaging component: " << component.Name << std::endl);
+  // Add the files of this component to the archive
+  std::string const& localToplevel = component.Directory;
+  if (!cmSystemTools::FileIsDirectory(localToplevel)) {
+    cmCPackLogger(cmCPackLog::LOG_ERROR,
+                  "Cannot find the directory of component <"
+                    << component.Name << ">: \"" << localToplevel << "\""
+                    << std::endl);
+    return 0;
+  }
+  for (std::string const& file : *component.Files) {
+    std::string rp = component.Prefix + file;
 
     DeduplicateStatus status = DeduplicateStatus::Add;
     if (deduplicator) {
@@ -281,7 +297,9 @@ int cmCPackArchiveGenerator::addOneComponentToArchive(
 
     if (!deduplicator || status == DeduplicateStatus::Add) {
       cmCPackLogger(cmCPackLog::LOG_DEBUG, "Adding file: " << rp << std::endl);
-      archive.Add(rp, 0, nullptr, false);
+      // Name the file relative to the directory of the component.
+      archive.Add(cmStrCat(localToplevel, '/', rp), localToplevel.size() + 1,
+                  nullptr, false);
     } else if (status == DeduplicateStatus::Error) {
       cmCPackLogger(cmCPackLog::LOG_ERROR,
                     "ERROR The data in files with the "
@@ -302,6 +320,56 @@ int cmCPackArchiveGenerator::addOneComponentToArchive(
   return 1;
 }
 
+bool cmCPackArchiveGenerator::GetArchiveHeader(
+  std::string const& packageFileName, std::string& header)
+{
+  std::ostringstream os;
+  if (!this->GenerateHeader(&os)) {
+    cmCPackLogger(cmCPackLog::LOG_ERROR,
+                  "Problem to generate Header for archive <"
+                    << packageFileName << ">." << std::endl);
+    return false;
+  }
+  header = os.str();
+  return true;
+}
+
+bool cmCPackArchiveGenerator::WriteArchive(
+  std::string const& packageFileName, std::string const& header,
+  std::vector<ComponentFiles> const& components, bool deduplicate,
+  int threads) const
+{
+  cmGeneratedFileStream gf;
+  gf.Open(packageFileName, false, true);
+  gf << header;
+  cmArchiveWrite archive(gf, this->Compress, this->ArchiveFormat, 0, threads);
+  if (!archive.Open()) {
+    cmCPackLogger(cmCPackLog::LOG_ERROR,
+                  "Problem to open archive <"
+                    << packageFileName << ">, ERROR = " << archive.GetError()
+                    << std::endl);
+    return false;
+  }
+  if (!archive) {
+    cmCPackLogger(cmCPackLog::LOG_ERROR,
+                  "Problem to create archive <"
+                    << packageFileName << ">, ERROR = " << archive.GetError()
+                    << std::endl);
+    return false;
+  }
+
+  Deduplicator deduplicator;
+  bool result = true;
+  for (ComponentFiles const& component : components) {
+    if (!this->addOneComponentToArchive(
+          archive, component, deduplicate ? &deduplicator : nullptr)) {
+      result = false;
+    }
+  }
+  // The destructor of cmArchiveWrite will close and finish the write
+  return result;
+}
+
 /*
  * The macro will open/create a file 'filename'
  * an declare and open the associated
@@ -338,30 +406,43 @@ int cmCPackArchiveGenerator::addOneComponentToArchive(
 int cmCPackArchiveGenerator::PackageComponents(bool ignoreGroup)
 {
   this->packageFileNames.clear();
+  // Collect everything the archives need from the options first, so that
+  // they can be written concurrently.
+  std::vector<PackageJob> jobs;
+  auto addArchive = [this, &jobs](std::string const& name, bool isGroupName,
+                                  std::vector<ComponentFiles> components,
+                                  bool deduplicate) -> bool {
+    std::string packageFileName =
+      cmStrCat(this->toplevel, '/',
+               this->GetArchiveComponentFileName(name, isGroupName));
+    std::string header;
+    if (!this->GetArchiveHeader(packageFileName, header)) {
+      return false;
+    }
+    jobs.emplace_back([this, packageFileName, header, components,
+                       deduplicate](int threads) -> bool {
+      return this->WriteArchive(packageFileName, header, components,
+                                deduplicate, threads);
+    });
+    // add the generated package to package file names list
+    this->packageFileNames.push_back(std::move(packageFileName));
+    return true;
+  };
+
   // The default behavior is to have one package by component group
   // unless CPACK_COMPONENTS_IGNORE_GROUP is specified.
   if (!ignoreGroup) {
     for (auto const& compG : this->ComponentGroups) {
       cmCPackLogger(cmCPackLog::LOG_VERBOSE,
                     "Packaging component group: " << compG.first << std::endl);
-      // Begin the archive for this group
-      std::string packageFileName = std::string(this->toplevel) + "/" +
-        this->GetArchiveComponentFileName(compG.first, true);
-
-      Deduplicator deduplicator;
-
-      // open a block in order to automatically close archive
-      // at the end of the block
-      {
-        DECLARE_AND_OPEN_ARCHIVE(packageFileName, archive);
-        // now iterate over the component of this group
-        for (cmCPackComponent* comp : (compG.second).Components) {
-          // Add the files of this component to the archive
-          this->addOneComponentToArchive(archive, comp, &deduplicator);
-        }
+      // Begin the archive for this group, with the components of the group
+      std::vector<ComponentFiles> components;
+      for (cmCPackComponent* comp : (compG.second).Components) {
+        components.push_back(this->GetComponentFiles(*comp));
+      }
+      if (!addArchive(compG.first, true, std::move(components), true)) {
+        return 0;
       }
-      // add the generated package to package file names list
-      this->packageFileNames.push_back(std::move(packageFileName));
     }
     // Handle Orphan components (components not belonging to any groups)
     for (auto& comp : this->Components) {
@@ -373,17 +454,10 @@ int cmCPackArchiveGenerator::PackageComponents(bool ignoreGroup)
             << comp.second.Name
             << "> does not belong to any group, package it separately."
             << std::endl);
-        std::string packageFileName = std::string(this->toplevel);
-        packageFileName +=
-          "/" + this->GetArchiveComponentFileName(comp.first, false);
-
-        {
-          DECLARE_AND_OPEN_ARCHIVE(packageFileName, archive);
-          // Add the files of this component to the archive
-          this->addOneComponentToArchive(archive, &(comp.second), nullptr);
+        if (!addArchive(comp.first, false,
+                        { this->GetComponentFiles(comp.second) }, false)) {
+          return 0;
         }
-        // add the generated package to package file names list
-        this->packageFileNames.push_back(std::move(packageFileName));
       }
     }
   }
@@ -391,20 +465,13 @@ int cmCPackArchiveGenerator::PackageComponents(bool ignoreGroup)
   // We build 1 package per component
   else {
     for (auto& comp : this->Components) {
-      std::string packageFileName = std::string(this->toplevel);
-      packageFileName +=
-        "/" + this->GetArchiveComponentFileName(comp.first, false);
-
-      {
-        DECLARE_AND_OPEN_ARCHIVE(packageFileName, archive);
-        // Add the files of this component to the archive
-        this->addOneComponentToArchive(archive, &(comp.second), nullptr);
+      if (!addArchive(comp.first, false,
+                      { this->GetComponentFiles(comp.second) }, false)) {
+        return 0;
       }
-      // add the generated package to package file names list
-      this->packageFileNames.push_back(std::move(packageFileName));
     }
   }
-  return 1;
+  return this->WritePackages(jobs, this->GetThreadCount()) ? 1 : 0;
 }
 
 int cmCPackArchiveGenerator::PackageComponentsAllInOne()
@@ -417,18 +484,20 @@ int cmCPackArchiveGenerator::PackageComponentsAllInOne()
                 "Packaging all groups in one package..."
                 "(CPACK_COMPONENTS_ALL_GROUPS_IN_ONE_PACKAGE is set)"
                   << std::endl);
-  DECLARE_AND_OPEN_ARCHIVE(packageFileNames[0], archive);
-
-  Deduplicator deduplicator;
+  std::string header;
+  if (!this->GetArchiveHeader(this->packageFileNames[0], header)) {
+    return 0;
+  }
 
   // The ALL COMPONENTS in ONE package case
+  std::vector<ComponentFiles> components;
   for (auto& comp : this->Components) {
-    // Add the files of this component to the archive
-    this->addOneComponentToArchive(archive, &(comp.second), &deduplicator);
+    components.push_back(this->GetComponentFiles(comp.second));
   }
-
-  // archive goes out of scope so it will finalized and closed.
-  return 1;
+  return this->WriteArchive(this->packageFileNames[0], header, components,
+                            true, this->GetThreadCount())
+    ? 1
+    : 0;
 }
 
 int cmCPackArchiveGenerator::PackageFiles()
@@ -6,6 +6,7 @@
 
 #include <iosfwd>
 #include <string>
+#include <vector>
 
 #include "cmArchiveWrite.h"
 #include "cmCPackGenerator.h"
@@ -51,6 +52,35 @@ private:
 
   class Deduplicator;
 
+  /**
+   * The files of a component as installed for packaging.  Archives are
+   * written from these without looking at the options again.
+   */
+  struct ComponentFiles
+  {
+    std::string Name;
+    // The directory the component was installed to.
+    std::string Directory;
+    // The prefix of the names of the files in the archive.
+    std::string Prefix;
+    std::vector<std::string> const* Files = nullptr;
+  };
+
+  ComponentFiles GetComponentFiles(cmCPackComponent const& component);
+
+  // Generate the header of an archive to be written later.
+  bool GetArchiveHeader(std::string const& packageFileName,
+                        std::string& header);
+
+  /**
+   * Write an archive with the files of the given components.  This may
+   * run on any thread.
+   */
+  bool WriteArchive(std::string const& packageFileName,
+                    std::string const& header,
+                    std::vector<ComponentFiles> const& components,
+                    bool deduplicate, int threads) const;
+
 protected:
   int InitializeInternal() override;
   /**
@@ -61,8 +91,8 @@ protected:
    * @param[in] deduplicator file deduplicator utility.
    */
   int addOneComponentToArchive(cmArchiveWrite& archive,
-                               cmCPackComponent* component,
-                               Deduplicator* deduplicator);
+                               ComponentFiles const& component,
+                               Deduplicator* deduplicator) const;
 
   /**
    * The main package file method.
@@ -74,7 +104,8 @@ protected:
   /**
    * The method used to package files when component
    * install is used. This will create one
-   * archive for each component group.
+   * archive for each component group.  The archives are written
+   * concurrently if CPACK_COMPONENTS_PARALLEL is enabled.
    */
   int PackageComponents(bool ignoreGroup);
   /**
@@ -5,11 +5,14 @@
 #include <algorithm>
 #include <cstring>
 #include <map>
+#include <memory>
 #include <ostream>
 #include <set>
 #include <stdexcept>
 #include <utility>
 
+#include <cm/optional>
+
 #include "cmsys/Glob.hxx"
 
 #include "cm_sys_stat.h"
@@ -19,6 +22,7 @@
 #include "cmCPackGenerator.h"
 #include "cmCPackLog.h"
 #include "cmCryptoHash.h"
+#include "cmFileDigestManifest.h"
 #include "cmGeneratedFileStream.h"
 #include "cmList.h"
 #include "cmStringAlgorithms.h"
@@ -32,20 +36,21 @@ class DebGenerator
 public:
   DebGenerator(cmCPackLog* logger, std::string outputName, std::string workDir,
                std::string topLevelDir, std::string temporaryDir,
-               cmValue debianCompressionType, cmValue numThreads,
-               cmValue debianArchiveType,
+               cmValue debianCompressionType, cmValue debianArchiveType,
                std::map<std::string, std::string> controlValues,
                bool genShLibs, std::string shLibsFilename, bool genPostInst,
                std::string postInst, bool genPostRm, std::string postRm,
                cmValue controlExtra, bool permissionStrctPolicy,
-               std::vector<std::string> packageFiles);
+               std::vector<std::string> packageFiles,
+               cmFileDigestManifest const& stagedDigests);
 
-  bool generate() const;
+  // Write the package.  This may run on any thread.
+  bool generate(int numThreads) const;
 
 private:
   void generateDebianBinaryFile() const;
   void generateControlFile() const;
-  bool generateDataTar() const;
+  bool generateDataTar(int numThreads) const;
   std::string generateMD5File() const;
   bool generateControlTar(std::string const& md5Filename) const;
   bool generateDeb() const;
@@ -57,7 +62,6 @@ private:
   std::string const TopLevelDir;
   std::string const TemporaryDir;
   std::string const DebianArchiveType;
-  long NumThreads;
   std::map<std::string, std::string> const ControlValues;
   bool const GenShLibs;
   std::string const ShLibsFilename;
@@ -65,20 +69,22 @@ private:
   std::string const PostInst;
   bool const GenPostRm;
   std::string const PostRm;
-  cmValue ControlExtra;
+  cm::optional<std::string> const ControlExtra;
   bool const PermissionStrictPolicy;
   std::vector<std::string> const PackageFiles;
+  cmFileDigestManifest const& StagedDigests;
   cmArchiveWrite::Compress TarCompressionType;
 };
 
 DebGenerator::DebGenerator(
   cmCPackLog* logger, std::string outputName, std::string workDir,
   std::string topLevelDir, std::string temporaryDir,
-  cmValue debCompressionType, cmValue numThreads, cmValue debianArchiveType,
+  cmValue debCompressionType, cmValue debianArchiveType,
   std::map<std::string, std::string> controlValues, bool genShLibs,
   std::string shLibsFilename, bool genPostInst, std::string postInst,
   bool genPostRm, std::string postRm, cmValue controlExtra,
-  bool permissionStrictPolicy, std::vector<std::string> packageFiles)
+  bool permissionStrictPolicy, std::vector<std::string> packageFiles,
+  cmFileDigestManifest const& stagedDigests)
   : Logger(logger)
   , OutputName(std::move(outputName))
   , WorkDir(std::move(workDir))
@@ -92,9 +98,11 @@ DebGenerator::DebGenerator(
   , PostInst(std::move(postInst))
   , GenPostRm(genPostRm)
   , PostRm(std::move(postRm))
-  , ControlExtra(controlExtra)
+  , ControlExtra(controlExtra ? cm::optional<std::string>(*controlExtra)
+                              : cm::nullopt)
   , PermissionStrictPolicy(permissionStrictPolicy)
   , PackageFiles(std::move(packageFiles))
+  , StagedDigests(stagedDigests)
 {
   std::string debianCompressionType = "gzip";
   if (debCompressionType) {
@@ -124,24 +132,13 @@ DebGenerator::DebGenerator(
                   "Error unrecognized compression type: "
                     << debianCompressionType << std::endl);
   }
-
-  if (numThreads) {
-    if (!cmStrToLong(*numThreads, &this->NumThreads)) {
-      this->NumThreads = 1;
-      cmCPackLogger(cmCPackLog::LOG_ERROR,
-                    "Unrecognized number of threads: " << numThreads
-                                                       << std::endl);
-    }
-  } else {
-    this->NumThreads = 1;
-  }
 }
 
-bool DebGenerator::generate() const
+bool DebGenerator::generate(int numThreads) const
 {
   this->generateDebianBinaryFile();
   this->generateControlFile();
-  if (!this->generateDataTar()) {
+  if (!this->generateDataTar(numThreads)) {
     return false;
   }
   std::string md5Filename = this->generateMD5File();
@@ -179,7 +176,7 @@ void DebGenerator::generateControlFile() const
   out << "Installed-Size: " << (totalSize + 1023) / 1024 << "\n";
 }
 
-bool DebGenerator::generateDataTar() const
+bool DebGenerator::generateDataTar(int numThreads) const
 {
   std::string filename_data_tar =
     this->WorkDir + "/data.tar" + this->CompressionSuffix;
@@ -192,8 +189,7 @@ bool DebGenerator::generateDataTar() const
     return false;
   }
   cmArchiveWrite data_tar(fileStream_data_tar, this->TarCompressionType,
-                          this->DebianArchiveType, 0,
-                          static_cast<int>(this->NumThreads));
+                          this->DebianArchiveType, 0, numThreads);
   if (!data_tar.Open()) {
     cmCPackLogger(cmCPackLog::LOG_ERROR,
                   "Error opening the archive \""
@@ -290,8 +286,12 @@ std::string DebGenerator::generateMD5File() const
       continue;
     }
 
-    cmCryptoHash hasher(cmCryptoHash::AlgoMD5);
-    std::string output = hasher.HashFile(file);
+    // Use the digest computed while the file was installed, if any.
+    std::string output = this->StagedDigests.GetDigest(file, "MD5");
+    if (output.empty()) {
+      cmCryptoHash hasher(cmCryptoHash::AlgoMD5);
+      output = hasher.HashFile(file);
+    }
     if (output.empty()) {
       cmCPackLogger(cmCPackLog::LOG_ERROR,
                     "Problem computing the md5 of " << file << std::endl);
@@ -428,7 +428,7 @@ bool DebGenerator::generateControlTar(std::string const& md5Filename) const
     // default
     control_tar.ClearPermissions();
 
-    cmList controlExtraList{ this->ControlExtra };
+    cmList controlExtraList{ *this->ControlExtra };
     for (std::string const& i : controlExtraList) {
       std::string filenamename = cmsys::SystemTools::GetFilenameName(i);
       std::string localcopy = this->WorkDir + "/" + filenamename;
@@ -576,6 +576,7 @@ int cmCPackDebGenerator::PackageComponents(bool ignoreGroup)
   // Reset package file name list it will be populated during the
   // component packaging run
   this->packageFileNames.clear();
+  this->PackageJobs.clear();
   std::string initialTopLevel(this->GetOption("CPACK_TEMPORARY_DIRECTORY"));
 
   int retval = 1;
@@ -587,7 +588,7 @@ int cmCPackDebGenerator::PackageComponents(bool ignoreGroup)
     for (auto const& comp : this->Components) {
       retval &= this->PackageOnePack(initialTopLevel, comp.first);
     }
-    return retval;
+    return this->WritePackageJobs() && retval;
   }
 
   for (auto const& compG : this->ComponentGroups) {
@@ -610,7 +611,7 @@ int cmCPackDebGenerator::PackageComponents(bool ignoreGroup)
       retval &= this->PackageOnePack(initialTopLevel, comp.first);
     }
   }
-  return retval;
+  return this->WritePackageJobs() && retval;
 }
 
 //----------------------------------------------------------------------
@@ -620,6 +621,7 @@ int cmCPackDebGenerator::PackageComponentsAllInOne(
   /* Reset package file name list it will be populated during the
    * component packaging run*/
   this->packageFileNames.clear();
+  this->PackageJobs.clear();
   std::string initialTopLevel(this->GetOption("CPACK_TEMPORARY_DIRECTORY"));
 
   cmCPackLogger(cmCPackLog::LOG_VERBOSE,
@@ -659,7 +661,8 @@ int cmCPackDebGenerator::PackageComponentsAllInOne(
     return 0;
   }
 
-  return this->createDebPackages();
+  int retval = this->createDebPackages();
+  return this->WritePackageJobs() && retval;
 }
 
 int cmCPackDebGenerator::PackageFiles()
@@ -716,6 +719,22 @@ bool cmCPackDebGenerator::createDebPackages()
   return static_cast<int>(retval);
 }
 
+bool cmCPackDebGenerator::WritePackageJobs()
+{
+  std::vector<PackageJob> jobs = std::move(this->PackageJobs);
+  this->PackageJobs.clear();
+
+  long threads = 1;
+  if (cmValue v = this->GetOption("CPACK_THREADS")) {
+    if (!cmStrToLong(*v, &threads)) {
+      threads = 1;
+      cmCPackLogger(cmCPackLog::LOG_ERROR,
+                    "Unrecognized number of threads: " << *v << std::endl);
+    }
+  }
+  return this->WritePackages(jobs, static_cast<int>(threads));
+}
+
 bool cmCPackDebGenerator::createDeb()
 {
   std::map<std::string, std::string> controlValues;
@@ -841,20 +860,21 @@ bool cmCPackDebGenerator::createDeb()
            "fi\n";
   }
 
-  DebGenerator gen(
+  auto gen = std::make_shared<DebGenerator>(
     this->Logger, this->GetOption("GEN_CPACK_OUTPUT_FILE_NAME"), strGenWDIR,
     this->GetOption("CPACK_TOPLEVEL_DIRECTORY"),
     this->GetOption("CPACK_TEMPORARY_DIRECTORY"),
     this->GetOption("GEN_CPACK_DEBIAN_COMPRESSION_TYPE"),
-    this->GetOption("CPACK_THREADS"),
     this->GetOption("GEN_CPACK_DEBIAN_ARCHIVE_TYPE"), controlValues, gen_shibs,
     shlibsfilename, this->IsOn("GEN_CPACK_DEBIAN_GENERATE_POSTINST"), postinst,
     this->IsOn("GEN_CPACK_DEBIAN_GENERATE_POSTRM"), postrm,
     this->GetOption("GEN_CPACK_DEBIAN_PACKAGE_CONTROL_EXTRA"),
     this->IsSet("GEN_CPACK_DEBIAN_PACKAGE_CONTROL_STRICT_PERMISSION"),
-    this->packageFiles);
+    this->packageFiles, this->StagedFileDigests);
 
-  return gen.generate();
+  this->PackageJobs.emplace_back(
+    [gen](int threads) -> bool { return gen->generate(threads); });
+  return true;
 }
 
 bool cmCPackDebGenerator::createDbgsymDDeb()
@@ -895,19 +915,20 @@ bool cmCPackDebGenerator::createDbgsymDDeb()
     controlValues["Build-Ids"] = *debian_build_ids;
   }
 
-  DebGenerator gen(
+  auto gen = std::make_shared<DebGenerator>(
     this->Logger, this->GetOption("GEN_CPACK_DBGSYM_OUTPUT_FILE_NAME"),
     this->GetOption("GEN_DBGSYMDIR"),
     this->GetOption("CPACK_TOPLEVEL_DIRECTORY"),
     this->GetOption("CPACK_TEMPORARY_DIRECTORY"),
     this->GetOption("GEN_CPACK_DEBIAN_COMPRESSION_TYPE"),
-    this->GetOption("CPACK_THREADS"),
     this->GetOption("GEN_CPACK_DEBIAN_ARCHIVE_TYPE"), controlValues, false, "",
     false, "", false, "", nullptr,
     this->IsSet("GEN_CPACK_DEBIAN_PACKAGE_CONTROL_STRICT_PERMISSION"),
-    this->packageFiles);
+    this->packageFiles, this->StagedFileDigests);
 
-  return gen.generate();
+  this->PackageJobs.emplace_back(
+    [gen](int threads) -> bool { return gen->generate(threads); });
+  return true;
 }
 
 bool cmCPackDebGenerator::SupportsComponentInstallation() const
@@ -915,6 +936,13 @@ bool cmCPackDebGenerator::SupportsComponentInstallation() const
   return this->IsOn("CPACK_DEB_COMPONENT_INSTALL");
 }
 
+std::vector<std::string> cmCPackDebGenerator::GetStagedFileDigestAlgorithms()
+  const
+{
+  // The md5sums file lists the digest of every packaged file.
+  return { "MD5" };
+}
+
 std::string cmCPackDebGenerator::GetComponentInstallSuffix(
   std::string const& componentName)
 {
@@ -59,6 +59,7 @@ protected:
   int PackageFiles() override;
   char const* GetOutputExtension() override { return ".deb"; }
   bool SupportsComponentInstallation() const override;
+  std::vector<std::string> GetStagedFileDigestAlgorithms() const override;
   std::string GetComponentInstallSuffix(
     std::string const& componentName) override;
   std::string GetComponentInstallDirNameSuffix(
@@ -66,8 +67,12 @@ protected:
 
 private:
   bool createDebPackages();
+  // Prepare a package to be written by WritePackageJobs.
   bool createDeb();
   bool createDbgsymDDeb();
+  // Write the prepared packages, concurrently if requested.
+  bool WritePackageJobs();
 
   std::vector<std::string> packageFiles;
+  std::vector<PackageJob> PackageJobs;
 };
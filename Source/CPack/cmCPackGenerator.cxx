@@ -3,8 +3,11 @@
 #include "cmCPackGenerator.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <iterator>
 #include <memory>
+#include <thread>
 #include <utility>
 
 #include <cmext/string_view>
@@ -222,6 +225,15 @@ int cmCPackGenerator::InstallProject()
   cmCPackLogger(cmCPackLog::LOG_OUTPUT, "Install projects" << std::endl);
   this->CleanTemporaryDirectory();
 
+  // Ask CMake projects to hash the files they install for us.
+  this->StagedFileDigestsFile.clear();
+  if (!this->GetStagedFileDigestAlgorithms().empty() &&
+      cmFileDigestManifest::IsSupported()) {
+    this->StagedFileDigestsFile = cmStrCat(
+      this->GetOption("CPACK_TOPLEVEL_DIRECTORY"), "/StagedFileDigests.txt");
+    cmSystemTools::RemoveFile(this->StagedFileDigestsFile);
+  }
+
   std::string bareTempInstallDirectory =
     this->GetOption("CPACK_TEMPORARY_DIRECTORY");
   std::string tempInstallDirectory = bareTempInstallDirectory;
@@ -322,6 +334,13 @@ int cmCPackGenerator::InstallProject()
     cmSystemTools::PutEnv("DESTDIR=");
   }
 
+  if (!this->StagedFileDigestsFile.empty()) {
+    this->StagedFileDigests.Load(this->StagedFileDigestsFile);
+    cmCPackLogger(cmCPackLog::LOG_DEBUG,
+                  "Got digests of " << this->StagedFileDigests.GetCount()
+                                    << " installed files" << std::endl);
+  }
+
   return res;
 }
 
@@ -923,6 +942,14 @@ int cmCPackGenerator::InstallCMakeProject(
       this->IsOn("CPACK_ERROR_ON_ABSOLUTE_INSTALL_DESTINATION")) {
     mf.AddDefinition("CMAKE_ERROR_ON_ABSOLUTE_INSTALL_DESTINATION", "1");
   }
+  // Hash the installed files while copying them if the generator needs
+  // their digests.
+  if (!this->StagedFileDigestsFile.empty()) {
+    mf.AddDefinition("CMAKE_INSTALL_DIGESTS",
+                     cmList::to_string(this->GetStagedFileDigestAlgorithms()));
+    mf.AddDefinition("CMAKE_INSTALL_DIGEST_MANIFEST",
+                     this->StagedFileDigestsFile);
+  }
 
   cmList custom_variables{ this->MakefileMap->GetDefinition(
     "CPACK_CUSTOM_INSTALL_VARIABLES") };
@@ -1416,6 +1443,68 @@ int cmCPackGenerator::PackageFiles()
   return 0;
 }
 
+bool cmCPackGenerator::WritePackages(std::vector<PackageJob> const& jobs,
+                                     int threads)
+{
+  // Count the threads as cmArchiveWrite does for a compressor.
+  unsigned int budget = 1;
+  if (threads > 0) {
+    budget = static_cast<unsigned int>(threads);
+  } else {
+    unsigned int const cores = std::thread::hardware_concurrency();
+    budget = cores > 0 ? cores : 1;
+    if (threads < 0 && budget > static_cast<unsigned int>(-threads)) {
+      budget = static_cast<unsigned int>(-threads);
+    }
+  }
+
+  // The number of packages written at once does not depend on the
+  // compressor threads, which default to one.
+  unsigned int workers = 1;
+  cmValue parallel = this->GetOption("CPACK_COMPONENTS_PARALLEL");
+  unsigned long count = 0;
+  if (parallel && cmStrToULong(*parallel, &count)) {
+    workers = count > 0 ? static_cast<unsigned int>(count) : 1;
+  } else if (parallel.IsOn()) {
+    unsigned int const cores = std::thread::hardware_concurrency();
+    workers = cores > 0 ? cores : 1;
+  }
+  workers = static_cast<unsigned int>(
+    std::min<std::size_t>(workers, jobs.size()));
+  if (workers <= 1) {
+    bool result = true;
+    for (PackageJob const& job : jobs) {
+      result = job(threads) && result;
+    }
+    return result;
+  }
+
+  cmCPackLogger(cmCPackLog::LOG_VERBOSE,
+                "Writing " << jobs.size() << " packages, " << workers
+                           << " at a time" << std::endl);
+  int const jobThreads =
+    static_cast<int>(std::max<unsigned int>(budget / workers, 1));
+  std::atomic<std::size_t> next(0);
+  std::atomic<bool> result(true);
+  auto work = [&]() {
+    for (std::size_t i = next++; i < jobs.size(); i = next++) {
+      if (!jobs[i](jobThreads)) {
+        result = false;
+      }
+    }
+  };
+  std::vector<std::thread> pool;
+  pool.reserve(workers - 1);
+  for (unsigned int i = 1; i < workers; ++i) {
+    pool.emplace_back(work);
+  }
+  work();
+  for (std::thread& thread : pool) {
+    thread.join();
+  }
+  return result;
+}
+
 char const* cmCPackGenerator::GetInstallPath()
 {
   if (!this->InstallPath.empty()) {
@@ -1704,6 +1793,12 @@ bool cmCPackGenerator::SupportsComponentInstallation() const
   return false;
 }
 
+std::vector<std::string> cmCPackGenerator::GetStagedFileDigestAlgorithms()
+  const
+{
+  return std::vector<std::string>();
+}
+
 bool cmCPackGenerator::WantsComponentInstallation() const
 {
   return (!this->IsOn("CPACK_MONOLITHIC_INSTALL") &&
@@ -4,6 +4,7 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <functional>
 #include <map>
 #include <sstream>
 #include <string>
@@ -15,6 +16,7 @@
 #include "cm_sys_stat.h"
 
 #include "cmCPackComponentGroup.h"
+#include "cmFileDigestManifest.h"
 #include "cmSystemTools.h"
 #include "cmValue.h"
 
@@ -203,6 +205,25 @@ protected:
    *       the list of packages generated by the specific generator.
    */
   virtual int PackageFiles();
+
+  /**
+   * A package to be written once all of its inputs are known.  It is
+   * called with the number of threads its compressor may use.  Packages
+   * may be written concurrently, so it must not access the options.
+   * @return false on failure.
+   */
+  using PackageJob = std::function<bool(int threads)>;
+
+  /**
+   * Write the given packages.  With CPACK_COMPONENTS_PARALLEL enabled,
+   * several packages are written at once and their compressors share
+   * the given number of threads, counted as for CPACK_THREADS, with at
+   * least one thread each.  Otherwise the packages are written one after
+   * another, each compressor using all of the threads.
+   * @return false if any of the packages failed.
+   */
+  bool WritePackages(std::vector<PackageJob> const& jobs, int threads);
+
   virtual char const* GetInstallPath();
   virtual char const* GetPackagingInstallPrefix();
 
@@ -290,6 +311,27 @@ protected:
    * @return true if component installation is supported and wanted.
    */
   virtual bool WantsComponentInstallation() const;
+
+  /**
+   * The hash algorithms, named as for CPACK_PACKAGE_CHECKSUM, of which
+   * the generator needs digests of the packaged files.  The files
+   * installed by CMake projects are hashed while they are copied to
+   * the temporary directory, see GetStagedFileDigest.
+   * @return the algorithm names, none by default
+   */
+  virtual std::vector<std::string> GetStagedFileDigestAlgorithms() const;
+
+  /**
+   * Get the digest of a packaged file that was computed while it was
+   * installed, if the file did not change since.
+   * @return the digest, or an empty string if the file must be hashed
+   */
+  std::string GetStagedFileDigest(std::string const& file,
+                                  cm::string_view algo) const
+  {
+    return this->StagedFileDigests.GetDigest(file, algo);
+  }
+
   virtual cmCPackInstallationType* GetInstallationType(
     std::string const& projectName, std::string const& name);
   virtual cmCPackComponent* GetComponent(std::string const& projectName,
@@ -362,6 +404,13 @@ protected:
    */
   ComponentPackageMethod componentPackageMethod;
 
+  /**
+   * The manifest of the digests computed while installing and the
+   * file it is recorded in, if the generator needs digests.
+   */
+  cmFileDigestManifest StagedFileDigests;
+  std::string StagedFileDigestsFile;
+
   cmCPackLog* Logger;
   bool Trace;
   bool TraceExpand;
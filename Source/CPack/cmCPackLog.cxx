@@ -41,6 +41,8 @@ bool cmCPackLog::SetLogOutputFile(char const* fname)
 void cmCPackLog::Log(int tag, char const* file, int line, char const* msg,
                      size_t length)
 {
+  std::lock_guard<std::mutex> lock(this->Mutex);
+
   // By default no logging
   bool display = false;
 
@@ -6,6 +6,7 @@
 
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
 
@@ -39,7 +40,8 @@ public:
     LOG_ERROR = 0x10
   };
 
-  //! Various signatures for logging.
+  //! Various signatures for logging.  Messages may be logged from several
+  // threads at once.
   void Log(char const* file, int line, char const* msg)
   {
     this->Log(LOG_OUTPUT, file, line, msg);
@@ -116,6 +118,8 @@ private:
 
   std::ostream* LogOutput = nullptr;
   std::unique_ptr<std::ostream> LogOutputStream;
+
+  std::mutex Mutex;
 };
 
 class cmCPackLogWrite
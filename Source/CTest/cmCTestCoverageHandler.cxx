@@ -4,8 +4,10 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstddef>
 #include <cstdio>
 #include <cstdlib>
+#include <deque>
 #include <iomanip>
 #include <iterator>
 #include <memory>
@@ -14,11 +16,16 @@
 #include <type_traits>
 #include <utility>
 
+#include <cm/memory>
+#include <cm/optional>
 #include <cmext/algorithm>
 
+#include <cm3p/uv.h>
+
 #include "cmsys/FStream.hxx"
 #include "cmsys/Glob.hxx"
 #include "cmsys/RegularExpression.hxx"
+#include "cmsys/SystemInformation.hxx"
 
 #include "cmCTest.h"
 #include "cmDuration.h"
@@ -30,9 +37,12 @@
 #include "cmParseGTMCoverage.h"
 #include "cmParseJacocoCoverage.h"
 #include "cmParsePHPCoverage.h"
+#include "cmProcessOutput.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
+#include "cmUVHandlePtr.h"
 #include "cmUVProcessChain.h"
+#include "cmUVStream.h"
 #include "cmWorkingDirectory.h"
 #include "cmXMLWriter.h"
 
@@ -807,6 +817,226 @@ static std::string joinCommandLine(std::vector<std::string> const& args)
   return ret;
 }
 
+// Run gcov on several coverage files at once.  Since gcov writes its
+// .gcov files to its working directory, each concurrent job runs in a
+// directory of its own.  Results are handed out in the order of the
+// files so they are merged exactly as if gcov ran sequentially.
+class cmCTestCoverageHandlerGCovJobs
+{
+public:
+  struct Result
+  {
+    std::vector<std::string> Command;
+    std::string Directory;
+    std::string Output;
+    std::string Errors;
+    bool Success = false;
+    int ExitCode = 0;
+  };
+
+  // If echo is true, the output of each job is printed as it arrives
+  // once the results of all files before its own are handed out.
+  cmCTestCoverageHandlerGCovJobs(std::vector<std::string> const& files,
+                                 std::vector<std::string> baseArgs,
+                                 std::string tempDir, std::size_t jobs,
+                                 bool echo)
+    : Files(files)
+    , BaseArgs(std::move(baseArgs))
+    , TempDir(std::move(tempDir))
+    , Jobs(std::max<std::size_t>(jobs, 1))
+    , Echo(echo)
+  {
+    this->Loop.init();
+  }
+
+  // Remove the directories of the jobs with their .gcov files.
+  ~cmCTestCoverageHandlerGCovJobs();
+
+  cmCTestCoverageHandlerGCovJobs(cmCTestCoverageHandlerGCovJobs const&) =
+    delete;
+  cmCTestCoverageHandlerGCovJobs& operator=(
+    cmCTestCoverageHandlerGCovJobs const&) = delete;
+
+  // Wait for gcov to process the next file.  The .gcov files written
+  // in the directory of the result remain until the following call.
+  Result Next();
+
+private:
+  struct Job
+  {
+    Result Data;
+    std::unique_ptr<cmUVProcessChain> Chain;
+    cm::uv_pipe_ptr OutputPipe;
+    cm::uv_pipe_ptr ErrorPipe;
+    std::unique_ptr<cmUVStreamReadHandle> OutputHandle;
+    std::unique_ptr<cmUVStreamReadHandle> ErrorHandle;
+    std::vector<char> Output;
+    std::vector<char> Errors;
+    bool OutputFinished = false;
+    bool ErrorFinished = false;
+    bool Started = false;
+    bool Echo = false;
+    cmProcessOutput EchoOutput{ cmProcessOutput::Auto };
+  };
+
+  void StartJobs();
+  void StartEcho(Job& job);
+  void EchoData(Job& job, char const* data, std::size_t size);
+
+  std::vector<std::string> const& Files;
+  std::vector<std::string> const BaseArgs;
+  std::string const TempDir;
+  std::size_t const Jobs;
+  bool const Echo;
+  std::size_t NextFile = 0;
+  cm::uv_loop_ptr Loop;
+  // Jobs started and not handed out yet, in the order of the files.
+  std::deque<std::unique_ptr<Job>> Started;
+};
+
+cmCTestCoverageHandlerGCovJobs::~cmCTestCoverageHandlerGCovJobs()
+{
+  if (this->Jobs == 1) {
+    // The only job ran in the temporary directory itself.
+    return;
+  }
+  // Wait for the jobs whose results were not handed out.
+  for (auto const& job : this->Started) {
+    while (job->Started && !job->Chain->Finished()) {
+      uv_run(this->Loop, UV_RUN_ONCE);
+    }
+  }
+  std::size_t const dirs = std::min(this->Jobs, this->NextFile);
+  for (std::size_t i = 0; i < dirs; ++i) {
+    cmSystemTools::RemoveADirectory(cmStrCat(this->TempDir, "/gcov", i));
+  }
+}
+
+void cmCTestCoverageHandlerGCovJobs::StartJobs()
+{
+  // The job of file N reuses the directory of file N - Jobs, whose result
+  // has been handed out before.
+  while (this->NextFile < this->Files.size() &&
+         this->Started.size() < this->Jobs) {
+    std::string const& file = this->Files[this->NextFile];
+    auto job = cm::make_unique<Job>();
+    job->Data.Command = this->BaseArgs;
+    job->Data.Command.push_back(cmSystemTools::GetFilenamePath(file));
+    job->Data.Command.push_back(file);
+    job->Data.Directory = this->Jobs == 1
+      ? this->TempDir
+      : cmStrCat(this->TempDir, "/gcov", this->NextFile % this->Jobs);
+    cmSystemTools::MakeDirectory(job->Data.Directory);
+    ++this->NextFile;
+
+    cmUVProcessChainBuilder builder;
+    builder.AddCommand(job->Data.Command)
+      .SetExternalLoop(*this->Loop)
+      .SetBuiltinStream(cmUVProcessChainBuilder::Stream_OUTPUT)
+      .SetBuiltinStream(cmUVProcessChainBuilder::Stream_ERROR)
+      .SetWorkingDirectory(job->Data.Directory);
+    job->Chain = cm::make_unique<cmUVProcessChain>(builder.Start());
+
+    Job* j = job.get();
+    if (!j->Chain->Valid() || j->Chain->OutputStream() < 0 ||
+        j->Chain->ErrorStream() < 0) {
+      // There is no process to wait for.
+      j->Data.Errors =
+        cmStrCat("Failed to start process: ", j->Data.Command[0], '\n');
+      this->Started.push_back(std::move(job));
+      continue;
+    }
+    j->Started = true;
+    j->OutputPipe.init(*this->Loop, 0);
+    uv_pipe_open(j->OutputPipe, j->Chain->OutputStream());
+    j->OutputHandle = cmUVStreamRead(
+      j->OutputPipe,
+      [this, j](std::vector<char> data) {
+        this->EchoData(*j, data.data(), data.size());
+        cm::append(j->Output, data);
+      },
+      [j]() { j->OutputFinished = true; });
+    j->ErrorPipe.init(*this->Loop, 0);
+    uv_pipe_open(j->ErrorPipe, j->Chain->ErrorStream());
+    j->ErrorHandle = cmUVStreamRead(
+      j->ErrorPipe,
+      [this, j](std::vector<char> data) {
+        this->EchoData(*j, data.data(), data.size());
+        cm::append(j->Errors, data);
+      },
+      [j]() { j->ErrorFinished = true; });
+    this->Started.push_back(std::move(job));
+  }
+}
+
+void cmCTestCoverageHandlerGCovJobs::StartEcho(Job& job)
+{
+  if (!this->Echo) {
+    return;
+  }
+  // Print what the job wrote while the results of earlier files were
+  // still pending, then the rest as it arrives.
+  job.Echo = true;
+  this->EchoData(job, job.Output.data(), job.Output.size());
+  this->EchoData(job, job.Errors.data(), job.Errors.size());
+}
+
+void cmCTestCoverageHandlerGCovJobs::EchoData(Job& job, char const* data,
+                                              std::size_t size)
+{
+  if (job.Echo && size > 0) {
+    std::string strdata;
+    job.EchoOutput.DecodeText(data, size, strdata);
+    cmSystemTools::Stdout(strdata);
+  }
+}
+
+cmCTestCoverageHandlerGCovJobs::Result cmCTestCoverageHandlerGCovJobs::Next()
+{
+  this->StartJobs();
+  Job& job = *this->Started.front();
+  if (!job.Started) {
+    Result result = std::move(job.Data);
+    this->Started.pop_front();
+    return result;
+  }
+
+  this->StartEcho(job);
+  while (!(job.OutputFinished && job.ErrorFinished && job.Chain->Finished())) {
+    uv_run(this->Loop, UV_RUN_ONCE);
+  }
+  if (job.Echo) {
+    std::string strdata;
+    job.EchoOutput.DecodeText(std::string(), strdata);
+    if (!strdata.empty()) {
+      cmSystemTools::Stdout(strdata);
+    }
+  }
+
+  cmProcessOutput processOutput(cmProcessOutput::Auto);
+  if (!job.Output.empty()) {
+    processOutput.DecodeText(job.Output, job.Output);
+    job.Data.Output.assign(job.Output.data(), job.Output.size());
+  }
+  if (!job.Errors.empty()) {
+    processOutput.DecodeText(job.Errors, job.Errors);
+    job.Data.Errors.assign(job.Errors.data(), job.Errors.size());
+  }
+
+  auto const& status = job.Chain->GetStatus(0);
+  auto exception = status.GetException();
+  if (exception.first == cmUVProcessChain::ExceptionCode::None) {
+    job.Data.Success = true;
+    job.Data.ExitCode = static_cast<int>(status.ExitStatus);
+  } else {
+    job.Data.Errors += exception.second;
+  }
+
+  Result result = std::move(job.Data);
+  this->Started.pop_front();
+  return result;
+}
+
 int cmCTestCoverageHandler::HandleBlanketJSCoverage(
   cmCTestCoverageHandlerContainer* cont)
 {
@@ -890,8 +1120,10 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
   cmsys::RegularExpression st2re5(st2gcovOutputRex5.c_str());
   cmsys::RegularExpression st2re6(st2gcovOutputRex6.c_str());
 
+  auto const findStart = std::chrono::steady_clock::now();
   std::vector<std::string> files;
   this->FindGCovFiles(files);
+  cmDuration const findTime = std::chrono::steady_clock::now() - findStart;
 
   if (files.empty()) {
     cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
@@ -932,6 +1164,20 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
   basecovargs.insert(basecovargs.begin(), gcovCommand);
   basecovargs.emplace_back("-o");
 
+  // Run as many gcov processes at once as tests.
+  std::size_t jobs = 1;
+  if (cm::optional<std::size_t> level = this->CTest->GetParallelLevel()) {
+    jobs = *level;
+  } else {
+    cmsys::SystemInformation info;
+    info.RunCPUCheck();
+    jobs = info.GetNumberOfLogicalCPU();
+  }
+  cmCTestCoverageHandlerGCovJobs gcovJobs(files, basecovargs, tempDir, jobs,
+                                          this->CTest->GetExtraVerbose());
+  auto const processStart = std::chrono::steady_clock::now();
+  cmDuration waitTime = cmDuration::zero();
+
   // files is a list of *.da and *.gcda files with coverage data in them.
   // These are binary files that you give as input to gcov so that it will
   // give us text output we can analyze to summarize coverage.
@@ -940,25 +1186,24 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
     cmCTestOptionalLog(this->CTest, HANDLER_OUTPUT, "." << std::flush,
                        this->Quiet);
 
-    // Call gcov to get coverage data for this *.gcda file:
+    // Get coverage data for this *.gcda file from gcov:
     //
+    auto const waitStart = std::chrono::steady_clock::now();
+    cmCTestCoverageHandlerGCovJobs::Result result = gcovJobs.Next();
+    waitTime += std::chrono::steady_clock::now() - waitStart;
+
     std::string fileDir = cmSystemTools::GetFilenamePath(f);
-    std::vector<std::string> covargs = basecovargs;
-    covargs.push_back(fileDir);
-    covargs.push_back(f);
-    std::string const command = joinCommandLine(covargs);
+    std::string const command = joinCommandLine(result.Command);
 
     cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
                        command << std::endl, this->Quiet);
 
-    std::string output;
-    std::string errors;
-    int retVal = 0;
+    std::string const& output = result.Output;
+    std::string const& errors = result.Errors;
+    int retVal = result.ExitCode;
     *cont->OFS << "* Run coverage for: " << fileDir << std::endl;
     *cont->OFS << "  Command: " << command << std::endl;
-    int res = this->CTest->RunCommand(covargs, &output, &errors, &retVal,
-                                      tempDir.c_str(),
-                                      cmDuration::zero() /*this->TimeOut*/);
+    bool res = result.Success;
 
     *cont->OFS << "  Output: " << output << std::endl;
     *cont->OFS << "  Errors: " << errors << std::endl;
@@ -1129,7 +1374,9 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
                            "   in gcovFile: " << gcovFile << std::endl,
                            this->Quiet);
 
-        cmsys::ifstream ifile(gcovFile.c_str());
+        std::string const gcovPath =
+          cmSystemTools::CollapseFullPath(gcovFile, result.Directory);
+        cmsys::ifstream ifile(gcovPath.c_str());
         if (!ifile) {
           cmCTestLog(this->CTest, ERROR_MESSAGE,
                      "Cannot open file: " << gcovFile << std::endl);
@@ -1244,6 +1491,18 @@ int cmCTestCoverageHandler::HandleGCovCoverage(
     }
   }
 
+  cmDuration const processTime =
+    std::chrono::steady_clock::now() - processStart;
+  std::ostringstream timings;
+  timings << std::fixed << std::setprecision(2)
+          << "   GCov timings: find " << findTime.count() << " s, gcov "
+          << waitTime.count() << " s, parse "
+          << (processTime - waitTime).count() << " s (" << jobs
+          << " jobs)";
+  *cont->OFS << timings.str() << std::endl;
+  cmCTestOptionalLog(this->CTest, HANDLER_VERBOSE_OUTPUT,
+                     std::endl << timings.str() << std::endl, this->Quiet);
+
   return file_count;
 }
 
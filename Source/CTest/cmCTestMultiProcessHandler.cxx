@@ -11,6 +11,7 @@
 #include <iomanip>
 #include <iostream>
 #include <list>
+#include <map>
 #include <sstream>
 #include <stack>
 #include <unordered_map>
@@ -94,6 +95,60 @@ cm::optional<CostEntry> splitCostLine(cm::string_view line)
   return CostEntry{ line.substr(0, pos1), prev, cost };
 }
 
+struct CriticalPath
+{
+  // Cost of the test plus the heaviest chain of tests depending on it.
+  double Weight = 0;
+  // Number of tests of the longest chain, starting with the test itself.
+  std::size_t Length = 0;
+  // Number of dependent tests not visited yet.
+  std::size_t Pending = 0;
+};
+
+// Compute the critical path of each test, visiting every test after all
+// the tests depending on it.  The graph of dependencies has no cycles.
+std::map<int, CriticalPath> ComputeCriticalPaths(
+  cmCTestMultiProcessHandler::TestMap const& tests,
+  cmCTestMultiProcessHandler::PropertiesMap const& properties)
+{
+  std::map<int, CriticalPath> paths;
+  for (auto const& t : tests) {
+    paths[t.first];
+    for (int d : t.second.Depends) {
+      if (tests.find(d) != tests.end()) {
+        ++paths[d].Pending;
+      }
+    }
+  }
+
+  std::vector<int> ready;
+  for (auto const& p : paths) {
+    if (p.second.Pending == 0) {
+      ready.push_back(p.first);
+    }
+  }
+  while (!ready.empty()) {
+    int const test = ready.back();
+    ready.pop_back();
+    CriticalPath& path = paths[test];
+    path.Weight += static_cast<double>(properties.at(test)->Cost);
+    ++path.Length;
+    for (int d : tests.at(test).Depends) {
+      auto it = paths.find(d);
+      if (it == paths.end()) {
+        continue;
+      }
+      CriticalPath& dependency = it->second;
+      dependency.Weight = std::max(dependency.Weight, path.Weight);
+      dependency.Length = std::max(dependency.Length, path.Length);
+      if (--dependency.Pending == 0) {
+        ready.push_back(d);
+      }
+    }
+  }
+  return paths;
+}
+
 }
 
 namespace cmsys {
@@ -933,10 +988,17 @@ int cmCTestMultiProcessHandler::SearchByName(cm::string_view name)
 void cmCTestMultiProcessHandler::CreateTestCostList()
 {
   if (this->GetParallelLevel() > 1) {
-    this->CreateParallelTestCostList();
+    if (this->ScheduleCriticalPath) {
+      this->CreateCriticalPathTestCostList();
+    } else {
+      this->CreateParallelTestCostList();
+    }
   } else {
     this->CreateSerialTestCostList();
   }
+  if (this->ScheduleCriticalPath) {
+    this->EstimateTestTime();
+  }
 }
 
 void cmCTestMultiProcessHandler::CreateParallelTestCostList()
@@ -997,6 +1059,105 @@ void cmCTestMultiProcessHandler::CreateParallelTestCostList()
   }
 }
 
+void cmCTestMultiProcessHandler::CreateCriticalPathTestCostList()
+{
+  std::map<int, CriticalPath> const paths =
+    ComputeCriticalPaths(this->PendingTests, this->Properties);
+
+  // Previously failed tests still run first.  Other tests are sorted by
+  // the weight of their critical path so that the longest chains of
+  // dependent tests start as early as possible.  The length of the chain
+  // breaks ties between tests without recorded cost.
+  TestList sortedTests;
+  for (auto const& t : this->PendingTests) {
+    if (cm::contains(this->LastTestsFailed, this->Properties[t.first]->Name)) {
+      this->OrderedTests.push_back(t.first);
+    } else {
+      sortedTests.push_back(t.first);
+    }
+  }
+  std::stable_sort(sortedTests.begin(), sortedTests.end(),
+                   [&paths](int index1, int index2) -> bool {
+                     CriticalPath const& path1 = paths.at(index1);
+                     CriticalPath const& path2 = paths.at(index2);
+                     if (path1.Weight != path2.Weight) {
+                       return path1.Weight > path2.Weight;
+                     }
+                     return path1.Length > path2.Length;
+                   });
+  cm::append(this->OrderedTests, sortedTests);
+}
+
+void cmCTestMultiProcessHandler::EstimateTestTime()
+{
+  // Replay the choices of StartNextTests() using the test costs as
+  // durations.  The load, resources and locks are not simulated.
+  size_t const parallelLevel = this->GetParallelLevel();
+  std::list<int> pending = this->OrderedTests;
+  std::multimap<double, int> running;
+  TestSet finished;
+  size_t available = parallelLevel;
+  bool serialRunning = false;
+  double now = 0;
+  while (!pending.empty()) {
+    auto ti = pending.begin();
+    while (available > 0 && !serialRunning && ti != pending.end()) {
+      auto cti = ti++;
+      int test = *cti;
+      if (this->Properties[test]->RunSerial && !running.empty()) {
+        continue;
+      }
+      TestSet const& depends = this->PendingTests[test].Depends;
+      if (!std::all_of(depends.begin(), depends.end(),
+                       [this, &finished](int d) -> bool {
+                         return cm::contains(finished, d) ||
+                           !cm::contains(this->PendingTests, d);
+                       })) {
+        continue;
+      }
+      size_t processors = this->GetProcessorsUsed(test);
+      if (processors > available) {
+        continue;
+      }
+      available -= processors;
+      serialRunning = this->Properties[test]->RunSerial;
+      running.emplace(now + static_cast<double>(this->Properties[test]->Cost),
+                      test);
+      pending.erase(cti);
+    }
+    if (running.empty()) {
+      break;
+    }
+    now = running.begin()->first;
+    while (!running.empty() && running.begin()->first <= now) {
+      int test = running.begin()->second;
+      running.erase(running.begin());
+      available += this->GetProcessorsUsed(test);
+      serialRunning = false;
+      finished.insert(test);
+    }
+  }
+  if (!running.empty()) {
+    now = running.rbegin()->first;
+  }
+  this->PredictedTestTime = cmDuration(now);
+
+  // The run takes at least as long as its critical path, and as long as
+  // all the work spread evenly over the parallel level.
+  double criticalPath = 0;
+  for (auto const& p :
+       ComputeCriticalPaths(this->PendingTests, this->Properties)) {
+    criticalPath = std::max(criticalPath, p.second.Weight);
+  }
+  double work = 0;
+  for (auto const& t : this->PendingTests) {
+    work += static_cast<double>(this->Properties[t.first]->Cost) *
+      static_cast<double>(this->GetProcessorsUsed(t.first));
+  }
+  this->LowerBoundTestTime = cmDuration(
+    std::max(criticalPath, work / static_cast<double>(parallelLevel)));
+}
+
 void cmCTestMultiProcessHandler::GetAllTestDependencies(int test,
                                                         TestList& dependencies)
 {
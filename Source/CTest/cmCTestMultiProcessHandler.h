@@ -19,6 +19,7 @@
 #include "cmCTestResourceAllocator.h"
 #include "cmCTestResourceSpec.h"
 #include "cmCTestTestHandler.h"
+#include "cmDuration.h"
 #include "cmUVHandlePtr.h"
 #include "cmUVJobServerClient.h"
 
@@ -97,6 +98,17 @@ public:
 
   void SetQuiet(bool b) { this->Quiet = b; }
 
+  // Order tests by the longest chain of tests depending on them.
+  void SetScheduleCriticalPath(bool b) { this->ScheduleCriticalPath = b; }
+
+  // Duration of the run predicted from the test costs, and the least
+  // possible duration given the dependencies and the parallel level.
+  cmDuration GetPredictedTestTime() const { return this->PredictedTestTime; }
+  cmDuration GetLowerBoundTestTime() const
+  {
+    return this->LowerBoundTestTime;
+  }
+
   void CheckResourceAvailability();
 
 protected:
@@ -120,6 +132,12 @@ protected:
 
   void CreateParallelTestCostList();
 
+  // Sort tests by their critical path weight
+  void CreateCriticalPathTestCostList();
+
+  // Predict the duration of the run by simulating the scheduler
+  void EstimateTestTime();
+
   // Removes the checkpoint file
   void MarkFinished();
   void FinishTestProcess(std::unique_ptr<cmCTestRunTest> runner, bool started);
@@ -231,4 +249,7 @@ private:
   int RepeatCount = 1;
   bool Quiet = false;
   bool SerialTestRunning = false;
+  bool ScheduleCriticalPath = false;
+  cmDuration PredictedTestTime = cmDuration::zero();
+  cmDuration LowerBoundTestTime = cmDuration::zero();
 };
@@ -42,6 +42,7 @@ protected:
     std::string ExcludeFixtureCleanup;
     cm::optional<ArgumentParser::Maybe<std::string>> ParallelLevel;
     std::string Repeat;
+    std::string ScheduleCriticalPath;
     std::string ScheduleRandom;
     std::string ScheduleRandomSeed;
     std::string StopTime;
@@ -70,6 +71,7 @@ protected:
       .Bind("EXCLUDE_FIXTURE_CLEANUP"_s, &TestArguments::ExcludeFixtureCleanup)
       .Bind("PARALLEL_LEVEL"_s, &TestArguments::ParallelLevel)
       .Bind("REPEAT"_s, &TestArguments::Repeat)
+      .Bind("SCHEDULE_CRITICAL_PATH"_s, &TestArguments::ScheduleCriticalPath)
       .Bind("SCHEDULE_RANDOM"_s, &TestArguments::ScheduleRandom)
       .Bind("SCHEDULE_RANDOM_SEED"_s, &TestArguments::ScheduleRandomSeed)
       .Bind("STOP_TIME"_s, &TestArguments::StopTime)
@@ -566,6 +566,17 @@ void cmCTestTestHandler::LogTestSummary(std::vector<std::string> const& passed,
   cmCTestOptionalLog(this->CTest, HANDLER_OUTPUT,
                      "\nTotal Test time (real) = " << realBuf << "\n",
                      this->Quiet);
+  if (this->TestOptions.ScheduleCriticalPath) {
+    char predictedBuf[1024];
+    snprintf(predictedBuf, sizeof(predictedBuf),
+             "%6.2f sec (actual %.2f sec, lower bound %.2f sec)",
+             this->PredictedTestingTime.count(),
+             this->ElapsedTestingTime.count(),
+             this->LowerBoundTestingTime.count());
+    cmCTestOptionalLog(this->CTest, HANDLER_OUTPUT,
+                       "Predicted Test time    = " << predictedBuf << "\n",
+                       this->Quiet);
+  }
 }
 
 void cmCTestTestHandler::LogDisabledTests(
@@ -1308,6 +1319,7 @@ bool cmCTestTestHandler::ProcessDirectory(std::vector<std::string>& passed,
                             this->CTest->GetRepeatCount());
   }
   parallel->SetQuiet(this->Quiet);
+  parallel->SetScheduleCriticalPath(this->TestOptions.ScheduleCriticalPath);
   if (this->TestLoad > 0) {
     parallel->SetTestLoad(this->TestLoad);
   } else {
@@ -1370,6 +1382,8 @@ bool cmCTestTestHandler::ProcessDirectory(std::vector<std::string>& passed,
   } else {
     parallel->RunTests();
   }
+  this->PredictedTestingTime = parallel->GetPredictedTestTime();
+  this->LowerBoundTestingTime = parallel->GetLowerBoundTestTime();
   this->EndTest = this->CTest->CurrentTime();
   this->EndTestTime = std::chrono::system_clock::now();
   this->ElapsedTestingTime =
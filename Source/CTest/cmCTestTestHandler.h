@@ -31,6 +31,7 @@ class cmXMLWriter;
 struct cmCTestTestOptions
 {
   bool RerunFailed = false;
+  bool ScheduleCriticalPath = false;
   bool ScheduleRandom = false;
   bool StopOnFailure = false;
   bool UseUnion = false;
@@ -265,6 +266,8 @@ protected:
   cmCTestTestOptions TestOptions;
 
   cmDuration ElapsedTestingTime;
+  cmDuration PredictedTestingTime = cmDuration::zero();
+  cmDuration LowerBoundTestingTime = cmDuration::zero();
 
   using TestResultsVector = std::vector<cmCTestTestResult>;
   TestResultsVector TestResults;
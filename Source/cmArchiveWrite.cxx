@@ -7,11 +7,14 @@
 #include <ctime>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <thread>
 
 #include <cm/algorithm>
+#include <cm/memory>
 
 #include <cm3p/archive.h>
 #include <cm3p/archive_entry.h>
@@ -48,6 +51,36 @@ static void cm_archive_entry_copy_sourcepath(struct archive_entry* e,
   archive_entry_copy_sourcepath_w(e, cmsys::Encoding::ToWide(file).c_str());
 }
 
+namespace {
+// Archives may be written from several threads at once, but the locale
+// is global.  Switch it while any thread adds a file and restore it
+// when the last one is done.
+std::mutex SharedLocaleMutex;
+unsigned int SharedLocaleUsers = 0;
+std::unique_ptr<cmLocaleRAII> SharedLocaleRAII;
+
+class SharedLocale
+{
+public:
+  SharedLocale()
+  {
+    std::lock_guard<std::mutex> lock(SharedLocaleMutex);
+    if (SharedLocaleUsers++ == 0) {
+      SharedLocaleRAII = cm::make_unique<cmLocaleRAII>();
+    }
+  }
+  ~SharedLocale()
+  {
+    std::lock_guard<std::mutex> lock(SharedLocaleMutex);
+    if (--SharedLocaleUsers == 0) {
+      SharedLocaleRAII.reset();
+    }
+  }
+  SharedLocale(SharedLocale const&) = delete;
+  SharedLocale& operator=(SharedLocale const&) = delete;
+};
+}
+
 class cmArchiveWrite::Entry
 {
   struct archive_entry* Object;
@@ -325,8 +358,8 @@ bool cmArchiveWrite::AddFile(char const* file, size_t skip, char const* prefix)
   }
   char const* out = file + skip;
 
-  cmLocaleRAII localeRAII;
-  static_cast<void>(localeRAII);
+  SharedLocale locale;
+  static_cast<void>(locale);
 
   // Meta-data.
   std::string dest = cmStrCat(prefix ? prefix : "", out);
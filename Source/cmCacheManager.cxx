@@ -3,14 +3,19 @@
 #include "cmCacheManager.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <cstdio>
 #include <cstring>
+#include <ios>
+#include <iterator>
 #include <sstream>
 #include <string>
+#include <utility>
 
 #include "cmsys/FStream.hxx"
 #include "cmsys/Glob.hxx"
 
+#include "cmCryptoHash.h"
 #include "cmGeneratedFileStream.h"
 #include "cmList.h"
 #include "cmMessageType.h"
@@ -20,6 +25,101 @@
 #include "cmSystemTools.h"
 #include "cmVersion.h"
 
+namespace {
+char const* const CacheSidecarName = "CMakeCache.bin";
+
+// Identify the format, which includes the byte order of the host.
+char const CacheSidecarMagic[] = "CMakeCache sidecar 2\n";
+std::uint32_t const CacheSidecarByteOrder = 0x01020304;
+
+struct SidecarWriter
+{
+  std::string Data;
+
+  void WriteMagic()
+  {
+    this->Data.append(CacheSidecarMagic, sizeof(CacheSidecarMagic) - 1);
+    this->Write(CacheSidecarByteOrder);
+  }
+
+  template <typename T>
+  void Write(T value)
+  {
+    char bytes[sizeof(T)];
+    memcpy(bytes, &value, sizeof(T));
+    this->Data.append(bytes, sizeof(T));
+  }
+
+  void Write(std::string const& value)
+  {
+    this->Write(static_cast<std::uint32_t>(value.size()));
+    this->Data.append(value);
+  }
+};
+
+struct SidecarReader
+{
+  std::string const& Data;
+  std::string::size_type Pos = 0;
+
+  bool ReadMagic()
+  {
+    std::uint32_t byteOrder = 0;
+    std::string::size_type const n = sizeof(CacheSidecarMagic) - 1;
+    if (this->Data.compare(0, n, CacheSidecarMagic) != 0) {
+      return false;
+    }
+    this->Pos = n;
+    return this->Read(byteOrder) && byteOrder == CacheSidecarByteOrder;
+  }
+
+  template <typename T>
+  bool Read(T& value)
+  {
+    if (this->Data.size() - this->Pos < sizeof(T)) {
+      return false;
+    }
+    memcpy(&value, this->Data.data() + this->Pos, sizeof(T));
+    this->Pos += sizeof(T);
+    return true;
+  }
+
+  bool Read(std::string& value)
+  {
+    std::uint32_t size = 0;
+    if (!this->Read(size) || this->Data.size() - this->Pos < size) {
+      return false;
+    }
+    value.assign(this->Data, this->Pos, size);
+    this->Pos += size;
+    return true;
+  }
+
+  bool AtEnd() const { return this->Pos == this->Data.size(); }
+};
+
+bool IsSavedUnchanged(std::string const& value)
+{
+  // Values are truncated at a newline, stripped of trailing carriage
+  // returns, and unquoted if they are enclosed in single quotes.
+  return value.find_first_of("\r\n") == std::string::npos &&
+    !(value.size() >= 2 && value.front() == '\'' && value.back() == '\'');
+}
+
+bool IsSavedKeyUnchanged(std::string const& key)
+{
+  return !key.empty() && key.find_first_of("\"=:\r\n") == std::string::npos &&
+    key.front() != ' ' && key.front() != '\t' && key.front() != '#' &&
+    key.front() != '/';
+}
+
+bool IsSavedHelpUnchanged(std::string const& help)
+{
+  return help.find('\r') == std::string::npos &&
+    !cmHasLiteralPrefix(help, "\\n");
+}
+}
+
 void cmCacheManager::CleanCMakeFiles(std::string const& path)
 {
   std::string glob = cmStrCat(path, "/CMakeFiles/*.cmake");
@@ -43,10 +143,88 @@ bool cmCacheManager::LoadCache(std::string const& path, bool internal,
     return false;
   }
 
-  cmsys::ifstream fin(cacheFile.c_str());
-  if (!fin) {
-    return false;
+  // The sidecar holds the entries as loaded by the project itself.
+  std::string const sidecarFile =
+    cmStrCat(path, "/CMakeFiles/", CacheSidecarName);
+  CacheFileStamp stamp;
+  bool const useSidecar =
+    internal && excludes.empty() && stamp.Load(cacheFile);
+  if (useSidecar && this->LoadCacheSidecar(sidecarFile, cacheFile, stamp)) {
+    ++this->SidecarLoads;
+  } else {
+    cmsys::ifstream fin(cacheFile.c_str());
+    if (!fin) {
+      return false;
+    }
+    bool const valid =
+      this->ReadCacheFile(fin, cacheFile, path, internal, excludes, includes);
+    if (useSidecar) {
+      ++this->TextLoads;
+      if (valid &&
+          this->GetInitializedCacheValue("CMAKE_CACHE_SIDECAR").IsOn()) {
+        SaveCacheSidecar(sidecarFile, cacheFile, stamp, this->Cache);
+      } else {
+        cmSystemTools::RemoveFile(sidecarFile);
+      }
+    }
   }
+  this->CacheMajorVersion = 0;
+  this->CacheMinorVersion = 0;
+  if (cmValue cmajor =
+        this->GetInitializedCacheValue("CMAKE_CACHE_MAJOR_VERSION")) {
+    unsigned int v = 0;
+    if (sscanf(cmajor->c_str(), "%u", &v) == 1) {
+      this->CacheMajorVersion = v;
+    }
+    if (cmValue cminor =
+          this->GetInitializedCacheValue("CMAKE_CACHE_MINOR_VERSION")) {
+      if (sscanf(cminor->c_str(), "%u", &v) == 1) {
+        this->CacheMinorVersion = v;
+      }
+    }
+  } else {
+    // CMake version not found in the list file.
+    // Set as version 0.0
+    this->AddCacheEntry("CMAKE_CACHE_MINOR_VERSION", "0",
+                        "Minor version of cmake used to create the "
+                        "current loaded cache",
+                        cmStateEnums::INTERNAL);
+    this->AddCacheEntry("CMAKE_CACHE_MAJOR_VERSION", "0",
+                        "Major version of cmake used to create the "
+                        "current loaded cache",
+                        cmStateEnums::INTERNAL);
+  }
+  // check to make sure the cache directory has not
+  // been moved
+  cmValue oldDir = this->GetInitializedCacheValue("CMAKE_CACHEFILE_DIR");
+  if (internal && oldDir) {
+    std::string currentcwd = path;
+    std::string oldcwd = *oldDir;
+    cmSystemTools::ConvertToUnixSlashes(currentcwd);
+    currentcwd += "/CMakeCache.txt";
+    oldcwd += "/CMakeCache.txt";
+    if (!cmSystemTools::SameFile(oldcwd, currentcwd)) {
+      cmValue dir = this->GetInitializedCacheValue("CMAKE_CACHEFILE_DIR");
+      std::ostringstream message;
+      message << "The current CMakeCache.txt directory " << currentcwd
+              << " is different than the directory " << (dir ? *dir : "")
+              << " where CMakeCache.txt was created. This may result "
+                 "in binaries being created in the wrong place. If you "
+                 "are not sure, reedit the CMakeCache.txt";
+      cmSystemTools::Error(message.str());
+    }
+  }
+  this->CacheLoaded = true;
+  return true;
+}
+
+bool cmCacheManager::ReadCacheFile(std::istream& fin,
+                                   std::string const& cacheFile,
+                                   std::string const& path, bool internal,
+                                   std::set<std::string>& excludes,
+                                   std::set<std::string>& includes)
+{
+  bool valid = true;
   char const* realbuffer;
   std::string buffer;
   std::string entryKey;
@@ -114,61 +292,183 @@ bool cmCacheManager::LoadCache(std::string const& path, bool internal,
       error << "Parse error in cache file " << cacheFile << " on line "
             << lineno << ". Offending entry: " << realbuffer;
       cmSystemTools::Error(error.str());
+      valid = false;
     }
   }
-  this->CacheMajorVersion = 0;
-  this->CacheMinorVersion = 0;
-  if (cmValue cmajor =
-        this->GetInitializedCacheValue("CMAKE_CACHE_MAJOR_VERSION")) {
-    unsigned int v = 0;
-    if (sscanf(cmajor->c_str(), "%u", &v) == 1) {
-      this->CacheMajorVersion = v;
+  return valid;
+}
+
+bool cmCacheManager::CacheFileStamp::Load(std::string const& cacheFile)
+{
+  this->Size = cmSystemTools::FileLength(cacheFile);
+  return this->Time.Load(cacheFile);
+}
+
+bool cmCacheManager::LoadCacheSidecar(std::string const& sidecarFile,
+                                      std::string const& cacheFile,
+                                      CacheFileStamp const& stamp)
+{
+  cmFileTime sidecarTime;
+  if (!sidecarTime.Load(sidecarFile)) {
+    return false;
+  }
+
+  cmsys::ifstream fin(sidecarFile.c_str(), std::ios::in | std::ios::binary);
+  if (!fin) {
+    return false;
+  }
+  std::string const data{ std::istreambuf_iterator<char>(fin),
+                          std::istreambuf_iterator<char>() };
+  SidecarReader reader{ data };
+  std::uint64_t size = 0;
+  std::uint64_t time = 0;
+  std::string hash;
+  std::uint32_t count = 0;
+  if (!reader.ReadMagic() || !reader.Read(size) || !reader.Read(time) ||
+      size != stamp.Size ||
+      static_cast<cmFileTime::TimeType>(time) != stamp.Time.GetTime() ||
+      !reader.Read(hash) || !reader.Read(count)) {
+    return false;
+  }
+  // A cache file modified within a second of the sidecar's creation may
+  // have been modified again after it without changing its time.
+  if (!stamp.Time.OlderS(sidecarTime) &&
+      cmCryptoHash(cmCryptoHash::AlgoSHA256).HashFile(cacheFile) != hash) {
+    return false;
+  }
+
+  std::map<std::string, CacheEntry> cache;
+  std::string key;
+  std::string name;
+  std::string value;
+  for (std::uint32_t i = 0; i < count; ++i) {
+    std::uint32_t type = 0;
+    std::uint32_t initialized = 0;
+    std::uint32_t properties = 0;
+    if (!reader.Read(key) || !reader.Read(type) ||
+        type > static_cast<std::uint32_t>(cmStateEnums::UNINITIALIZED) ||
+        !reader.Read(initialized) ||
+        !reader.Read(properties)) {
+      return false;
     }
-    if (cmValue cminor =
-          this->GetInitializedCacheValue("CMAKE_CACHE_MINOR_VERSION")) {
-      if (sscanf(cminor->c_str(), "%u", &v) == 1) {
-        this->CacheMinorVersion = v;
+    CacheEntry& e = cache.emplace_hint(cache.end(), key, CacheEntry())->second;
+    e.Type = static_cast<cmStateEnums::CacheEntryType>(type);
+    e.Initialized = initialized != 0;
+    if (!reader.Read(e.Value)) {
+      return false;
+    }
+    for (std::uint32_t j = 0; j < properties; ++j) {
+      if (!reader.Read(name) || !reader.Read(value)) {
+        return false;
       }
+      e.SetProperty(name, value);
     }
-  } else {
-    // CMake version not found in the list file.
-    // Set as version 0.0
-    this->AddCacheEntry("CMAKE_CACHE_MINOR_VERSION", "0",
-                        "Minor version of cmake used to create the "
-                        "current loaded cache",
-                        cmStateEnums::INTERNAL);
-    this->AddCacheEntry("CMAKE_CACHE_MAJOR_VERSION", "0",
-                        "Major version of cmake used to create the "
-                        "current loaded cache",
-                        cmStateEnums::INTERNAL);
   }
-  // check to make sure the cache directory has not
-  // been moved
-  cmValue oldDir = this->GetInitializedCacheValue("CMAKE_CACHEFILE_DIR");
-  if (internal && oldDir) {
-    std::string currentcwd = path;
-    std::string oldcwd = *oldDir;
-    cmSystemTools::ConvertToUnixSlashes(currentcwd);
-    currentcwd += "/CMakeCache.txt";
-    oldcwd += "/CMakeCache.txt";
-    if (!cmSystemTools::SameFile(oldcwd, currentcwd)) {
-      cmValue dir = this->GetInitializedCacheValue("CMAKE_CACHEFILE_DIR");
-      std::ostringstream message;
-      message << "The current CMakeCache.txt directory " << currentcwd
-              << " is different than the directory " << (dir ? *dir : "")
-              << " where CMakeCache.txt was created. This may result "
-                 "in binaries being created in the wrong place. If you "
-                 "are not sure, reedit the CMakeCache.txt";
-      cmSystemTools::Error(message.str());
-    }
+  if (!reader.AtEnd()) {
+    return false;
   }
-  this->CacheLoaded = true;
+  this->Cache = std::move(cache);
   return true;
 }
 
+void cmCacheManager::SaveCacheSidecar(
+  std::string const& sidecarFile, std::string const& cacheFile,
+  CacheFileStamp const& stamp, std::map<std::string, CacheEntry> const& cache)
+{
+  std::string const hash =
+    cmCryptoHash(cmCryptoHash::AlgoSHA256).HashFile(cacheFile);
+  if (hash.empty()) {
+    cmSystemTools::RemoveFile(sidecarFile);
+    return;
+  }
+
+  SidecarWriter writer;
+  writer.WriteMagic();
+  writer.Write(static_cast<std::uint64_t>(stamp.Size));
+  writer.Write(static_cast<std::uint64_t>(stamp.Time.GetTime()));
+  writer.Write(hash);
+  writer.Write(static_cast<std::uint32_t>(cache.size()));
+  for (auto const& i : cache) {
+    CacheEntry const& e = i.second;
+    std::vector<std::string> const properties = e.GetPropertyList();
+    writer.Write(i.first);
+    writer.Write(static_cast<std::uint32_t>(e.Type));
+    writer.Write(static_cast<std::uint32_t>(e.Initialized ? 1 : 0));
+    writer.Write(static_cast<std::uint32_t>(properties.size()));
+    writer.Write(e.Value);
+    for (std::string const& p : properties) {
+      writer.Write(p);
+      writer.Write(*e.GetProperty(p));
+    }
+  }
+
+  // Write a new file and rename it so a concurrent load never reads a
+  // partial sidecar.
+  cmGeneratedFileStream fout;
+  fout.Open(sidecarFile, true, true);
+  if (fout) {
+    fout.write(writer.Data.data(),
+               static_cast<std::streamsize>(writer.Data.size()));
+  }
+  if (!fout.Close()) {
+    cmSystemTools::RemoveFile(sidecarFile);
+  }
+}
+
 char const* cmCacheManager::PersistentProperties[] = { "ADVANCED", "MODIFIED",
                                                        "STRINGS" };
 
+bool cmCacheManager::GetSavedEntries(
+  std::map<std::string, CacheEntry>& saved) const
+{
+  for (auto const& i : this->Cache) {
+    CacheEntry const& e = i.second;
+    if (!e.Initialized) {
+      continue;
+    }
+    if (!IsSavedKeyUnchanged(i.first) || !IsSavedUnchanged(e.Value)) {
+      return false;
+    }
+    // Property entries are named after their entry and property.
+    for (char const* p : cmCacheManager::PersistentProperties) {
+      if (cmHasSuffix(i.first, cmStrCat('-', p))) {
+        return false;
+      }
+    }
+
+    CacheEntry& s = saved.emplace_hint(saved.end(), i.first, CacheEntry())
+                      ->second;
+    s.Type = e.Type;
+    s.Value = e.Value;
+    s.Initialized = true;
+    cmValue help = e.GetProperty("HELPSTRING");
+    if (help && !IsSavedHelpUnchanged(*help)) {
+      return false;
+    }
+    if (help) {
+      s.SetProperty("HELPSTRING", *help);
+    } else if (e.Type != cmStateEnums::INTERNAL) {
+      s.SetProperty("HELPSTRING", "Missing description");
+    } else {
+      s.SetProperty("HELPSTRING", "");
+    }
+    // The properties of internal entries are written before the entries
+    // themselves, which replace them when the file is read.
+    if (e.Type == cmStateEnums::INTERNAL) {
+      continue;
+    }
+    for (char const* p : cmCacheManager::PersistentProperties) {
+      if (cmValue value = e.GetProperty(p)) {
+        if (!IsSavedUnchanged(*value)) {
+          return false;
+        }
+        s.SetProperty(p, *value);
+      }
+    }
+  }
+  return true;
+}
+
 bool cmCacheManager::ReadPropertyEntry(std::string const& entryKey,
                                        CacheEntry const& e)
 {
@@ -339,8 +639,23 @@ bool cmCacheManager::SaveCache(std::string const& path, cmMessenger* messenger)
   }
   fout << '\n';
   fout.Close();
+
   std::string checkCacheFile = cmStrCat(path, "/CMakeFiles");
   cmSystemTools::MakeDirectory(checkCacheFile);
+
+  // Write the sidecar now rather than on the next load, which would
+  // otherwise parse the text file.
+  std::string const sidecarFile =
+    cmStrCat(checkCacheFile, '/', CacheSidecarName);
+  std::map<std::string, CacheEntry> saved;
+  CacheFileStamp stamp;
+  if (this->GetInitializedCacheValue("CMAKE_CACHE_SIDECAR").IsOn() &&
+      this->GetSavedEntries(saved) && stamp.Load(cacheFile)) {
+    SaveCacheSidecar(sidecarFile, cacheFile, stamp, saved);
+  } else {
+    cmSystemTools::RemoveFile(sidecarFile);
+  }
+
   checkCacheFile += "/cmake.check_cache";
   cmsys::ofstream checkCache(checkCacheFile.c_str());
   if (!checkCache) {
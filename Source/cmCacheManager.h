@@ -11,6 +11,7 @@
 #include <utility>
 #include <vector>
 
+#include "cmFileTime.h"
 #include "cmPropertyMap.h"
 #include "cmStateTypes.h"
 #include "cmValue.h"
@@ -172,6 +173,11 @@ public:
   unsigned int GetCacheMajorVersion() const { return this->CacheMajorVersion; }
   unsigned int GetCacheMinorVersion() const { return this->CacheMinorVersion; }
 
+  //! Get how many loads of the build tree's cache file read its binary
+  //! sidecar and how many parsed the text file while a sidecar was enabled
+  unsigned long GetSidecarLoads() const { return this->SidecarLoads; }
+  unsigned long GetTextLoads() const { return this->TextLoads; }
+
   //! Add an entry into the cache
   void AddCacheEntry(std::string const& key, std::string const& value,
                      std::string const& helpString,
@@ -199,6 +205,44 @@ private:
   //! Clean out the CMakeFiles directory if no CMakeCache.txt
   void CleanCMakeFiles(std::string const& path);
 
+  //! Parse the entries of a CMakeCache.txt file.  Return false on errors.
+  bool ReadCacheFile(std::istream& fin, std::string const& cacheFile,
+                     std::string const& path, bool internal,
+                     std::set<std::string>& excludes,
+                     std::set<std::string>& includes);
+
+  //! Size and modification time of a CMakeCache.txt file.
+  struct CacheFileStamp
+  {
+    unsigned long Size = 0;
+    cmFileTime Time;
+
+    bool Load(std::string const& cacheFile);
+  };
+
+  /**
+   * Load or save the entries parsed from a CMakeCache.txt file in a binary
+   * sidecar file, which is much faster to read.  The sidecar is stamped
+   * with the size, modification time and content hash of the text file
+   * and is used only as long as they match.  The hash is checked only if
+   * the text file may have been modified after the sidecar was written
+   * without changing its time.
+   */
+  bool LoadCacheSidecar(std::string const& sidecarFile,
+                        std::string const& cacheFile,
+                        CacheFileStamp const& stamp);
+  static void SaveCacheSidecar(std::string const& sidecarFile,
+                               std::string const& cacheFile,
+                               CacheFileStamp const& stamp,
+                               std::map<std::string, CacheEntry> const& cache);
+
+  /**
+   * Compute the entries that loading the cache file written by SaveCache
+   * will produce.  Returns false if an entry cannot be written to the text
+   * file and read back unchanged, e.g. a value with a newline.
+   */
+  bool GetSavedEntries(std::map<std::string, CacheEntry>& saved) const;
+
   static void OutputHelpString(std::ostream& fout,
                                std::string const& helpString);
   static void OutputWarningComment(std::ostream& fout,
@@ -220,6 +264,8 @@ private:
 
   std::map<std::string, CacheEntry> Cache;
   bool CacheLoaded = false;
+  unsigned long SidecarLoads = 0;
+  unsigned long TextLoads = 0;
 
   // Cache version info
   unsigned int CacheMajorVersion = 0;
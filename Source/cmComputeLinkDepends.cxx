@@ -8,6 +8,7 @@
 #include <cstdio>
 #include <iterator>
 #include <sstream>
+#include <tuple>
 #include <type_traits>
 #include <unordered_map>
 #include <utility>
@@ -184,6 +185,16 @@ original user link line followed by minimal additional items needed to
 satisfy dependencies.  The final list is then filtered to de-duplicate
 items that we know the linker will reuse automatically (shared libs).
 
+------------------------------------------------------------------------------
+
+While the project files are generated, the ordered closure computed for
+one target is shared with other targets having the same direct link
+dependencies through cmComputeLinkDependsCache.  Only the final
+filtering depends on the target being linked, unless the closure
+contains link interfaces or features that refer to the target itself
+or old-style <item>_LIB_DEPENDS variables.  Such closures are not
+shared.
+
 */
 
 namespace {
@@ -676,6 +687,19 @@ cmComputeLinkDepends::~cmComputeLinkDepends() = default;
 std::vector<cmComputeLinkDepends::LinkEntry> const&
 cmComputeLinkDepends::Compute()
 {
+  // Reuse the closure of another target with the same direct link
+  // dependencies, if available.
+  cmComputeLinkDependsCache* cache =
+    this->GlobalGenerator->GetLinkDependsCache();
+  ClosureKey key;
+  if (cache && !this->GetClosureKey(key)) {
+    cache = nullptr;
+  }
+  if (cache && this->LookupClosure(*cache, key)) {
+    this->ComputeFinalLinkEntries();
+    return this->FinalLinkEntries;
+  }
+
   // Follow the link dependencies of the target to be linked.
   this->AddDirectLinkEntries();
 
@@ -739,6 +763,16 @@ cmComputeLinkDepends::Compute()
     this->DisplayOrderedEntries();
   }
 
+  if (cache && this->ClosureIsShareable) {
+    this->StoreClosure(*cache, std::move(key));
+  }
+
+  this->ComputeFinalLinkEntries();
+  return this->FinalLinkEntries;
+}
+
+void cmComputeLinkDepends::ComputeFinalLinkEntries()
+{
   // Compute the final set of link entries.
   EntriesProcessing entriesProcessing{ this->Target, this->LinkLanguage,
                                        this->EntryList,
@@ -753,8 +787,110 @@ cmComputeLinkDepends::Compute()
   if (this->DebugMode) {
     this->DisplayFinalEntries();
   }
+}
 
-  return this->FinalLinkEntries;
+bool cmComputeLinkDepends::GetClosureKey(ClosureKey& key) const
+{
+  // The debug output and the link library overrides are specific to
+  // the target being linked.
+  if (this->DebugMode || !this->LinkLibraryOverride.empty()) {
+    return false;
+  }
+
+  cmLinkImplementation const* impl = this->Target->GetLinkImplementation(
+    this->Config, cmGeneratorTarget::UseTo::Link);
+  if (!impl->Objects.empty()) {
+    return false;
+  }
+
+  // Follow the order of AddDirectLinkEntries.
+  auto addList = [&key](std::vector<cmLinkImplItem> const& libs) -> bool {
+    for (cmLinkImplItem const& lib : libs) {
+      if (lib.Feature != LinkEntry::DEFAULT || lib.ObjectSource) {
+        return false;
+      }
+    }
+    key.Libraries.emplace_back(libs.begin(), libs.end());
+    return true;
+  };
+  if (!addList(impl->Libraries)) {
+    return false;
+  }
+  for (auto const& language : impl->Languages) {
+    auto runtimeEntries = impl->LanguageRuntimeLibraries.find(language);
+    if (runtimeEntries != impl->LanguageRuntimeLibraries.end() &&
+        !addList(runtimeEntries->second)) {
+      return false;
+    }
+  }
+
+  key.Config = this->Config;
+  key.LinkLanguage = this->LinkLanguage;
+  key.Strategy = this->Strategy;
+  return true;
+}
+
+bool cmComputeLinkDepends::LookupClosure(cmComputeLinkDependsCache& cache,
+                                         ClosureKey const& key)
+{
+  cmComputeLinkDependsCache::Closure const* closure = cache.Find(key);
+
+  // The closure must not contain the target being linked, which it
+  // would have skipped, nor items whose dependencies it defines.
+  bool usable = closure &&
+    std::none_of(closure->Entries.begin(), closure->Entries.end(),
+                 [this](LinkEntry const& entry) -> bool {
+                   return entry.Item.Value == this->Target->GetName();
+                 }) &&
+    std::none_of(closure->UndefinedLibDepends.begin(),
+                 closure->UndefinedLibDepends.end(),
+                 [this](std::string const& var) -> bool {
+                   return static_cast<bool>(
+                     this->Makefile->GetDefinition(var));
+                 });
+  if (!usable) {
+    ++cache.Misses;
+    return false;
+  }
+  ++cache.Hits;
+
+  this->EntryList = closure->Entries;
+  this->FinalLinkOrder = closure->FinalLinkOrder;
+  this->ObjectEntries = closure->ObjectEntries;
+
+  // Entries of direct dependencies carry the backtrace of their first
+  // occurrence in the link implementation of this target.
+  std::vector<bool> seen(this->EntryList.size(), false);
+  auto direct = closure->DirectEntries.begin();
+  for (auto const& libs : key.Libraries) {
+    for (cmLinkItem const& lib : libs) {
+      size_t index = *direct++;
+      if (index < seen.size() && !seen[index]) {
+        seen[index] = true;
+        this->EntryList[index].Item.Backtrace = lib.Backtrace;
+      }
+    }
+  }
+  return true;
+}
+
+void cmComputeLinkDepends::StoreClosure(cmComputeLinkDependsCache& cache,
+                                        ClosureKey key)
+{
+  cmComputeLinkDependsCache::Closure closure;
+  for (auto const& libs : key.Libraries) {
+    for (cmLinkItem const& lib : libs) {
+      auto lei = this->LinkEntryIndex.find(lib);
+      closure.DirectEntries.push_back(lei == this->LinkEntryIndex.end()
+                                        ? this->EntryList.size()
+                                        : lei->second);
+    }
+  }
+  closure.Entries = this->EntryList;
+  closure.FinalLinkOrder = this->FinalLinkOrder;
+  closure.ObjectEntries = this->ObjectEntries;
+  closure.UndefinedLibDepends = std::move(this->UndefinedLibDepends);
+  cache.Store(std::move(key), std::move(closure));
 }
 
 std::string const& cmComputeLinkDepends::GetCurrentFeature(
@@ -819,9 +955,13 @@ std::pair<size_t, bool> cmComputeLinkDepends::AddLinkEntry(
         // The item dependencies are known.  Follow them.
         BFSEntry qe = { index, groupIndex, val->c_str() };
         this->BFSQueue.push(qe);
-      } else if (entry.Kind != LinkEntry::Flag) {
-        // The item dependencies are not known.  We need to infer them.
-        this->InferredDependSets[index].Initialized = true;
+        this->ClosureIsShareable = false;
+      } else {
+        this->UndefinedLibDepends.emplace_back(std::move(var));
+        if (entry.Kind != LinkEntry::Flag) {
+          // The item dependencies are not known.  We need to infer them.
+          this->InferredDependSets[index].Initialized = true;
+        }
       }
     }
   }
@@ -863,6 +1003,9 @@ void cmComputeLinkDepends::FollowLinkEntry(BFSEntry qe)
     // Follow the target dependencies.
     if (cmLinkInterface const* iface =
           entry.Target->GetLinkInterface(this->Config, this->Target)) {
+      if (iface->HadHeadSensitiveCondition) {
+        this->ClosureIsShareable = false;
+      }
       bool const isIface =
         entry.Target->GetType() == cmStateEnums::INTERFACE_LIBRARY;
       // This target provides its own link interface information.
@@ -943,6 +1086,9 @@ void cmComputeLinkDepends::HandleSharedDependency(SharedDepEntry const& dep)
   if (entry.Target) {
     if (cmLinkInterface const* iface =
           entry.Target->GetLinkInterface(this->Config, this->Target)) {
+      if (iface->HadHeadSensitiveCondition) {
+        this->ClosureIsShareable = false;
+      }
       // Follow public and private dependencies transitively.
       this->FollowSharedDeps(index, iface, true);
     }
@@ -1034,10 +1180,19 @@ void cmComputeLinkDepends::AddLinkEntries(cm::optional<size_t> depender_index,
     // Skip entries that will resolve to the target getting linked or
     // are empty.
     cmLinkItem const& item = l;
-    if (item.AsStr() == this->Target->GetName() || item.AsStr().empty()) {
+    if (item.AsStr() == this->Target->GetName()) {
+      this->ClosureIsShareable = false;
+      continue;
+    }
+    if (item.AsStr().empty()) {
       continue;
     }
 
+    // Features are checked against the target being linked.
+    if (item.Feature != LinkEntry::DEFAULT) {
+      this->ClosureIsShareable = false;
+    }
+
     // emit a warning if an undefined feature is used as part of
     // an imported target
     if (item.Feature != LinkEntry::DEFAULT && depender_index) {
@@ -1062,6 +1217,7 @@ void cmComputeLinkDepends::AddLinkEntries(cm::optional<size_t> depender_index,
 
     if (cmHasPrefix(item.AsStr(), LG_BEGIN) &&
         cmHasSuffix(item.AsStr(), '>')) {
+      this->ClosureIsShareable = false;
       group = this->AddLinkEntry(item, cm::nullopt);
       if (group->second) {
         LinkEntry& entry = this->EntryList[group->first];
@@ -1723,3 +1879,22 @@ void cmComputeLinkDepends::DisplayFinalEntries()
   }
   fprintf(stderr, "\n");
 }
+
+bool operator<(cmComputeLinkDepends::ClosureKey const& l,
+               cmComputeLinkDepends::ClosureKey const& r)
+{
+  return std::tie(l.Config, l.LinkLanguage, l.Strategy, l.Libraries) <
+    std::tie(r.Config, r.LinkLanguage, r.Strategy, r.Libraries);
+}
+
+cmComputeLinkDependsCache::Closure const* cmComputeLinkDependsCache::Find(
+  Key const& key) const
+{
+  auto it = this->Closures.find(key);
+  return it == this->Closures.end() ? nullptr : &it->second;
+}
+
+void cmComputeLinkDependsCache::Store(Key key, Closure closure)
+{
+  this->Closures[std::move(key)] = std::move(closure);
+}
@@ -21,6 +21,7 @@
 #include "cmTargetLinkLibraryType.h"
 
 class cmComputeComponentGraph;
+class cmComputeLinkDependsCache;
 class cmGeneratorTarget;
 class cmGlobalGenerator;
 class cmMakefile;
@@ -85,6 +86,19 @@ public:
   using EntryVector = std::vector<LinkEntry>;
   EntryVector const& Compute();
 
+  // The inputs determining the closure of the link dependencies of a
+  // target whose dependencies do not refer to the target itself.
+  struct ClosureKey
+  {
+    std::string Config;
+    std::string LinkLanguage;
+    LinkLibrariesStrategy Strategy;
+    // The direct link dependencies, one list per call to AddLinkEntries.
+    std::vector<std::vector<cmLinkItem>> Libraries;
+
+    friend bool operator<(ClosureKey const& l, ClosureKey const& r);
+  };
+
 private:
   // Context information.
   cmGeneratorTarget const* Target = nullptr;
@@ -100,6 +114,14 @@ private:
   EntryVector FinalLinkEntries;
   std::map<std::string, std::string> LinkLibraryOverride;
 
+  // Reuse of the closure computed for another target.
+  bool GetClosureKey(ClosureKey& key) const;
+  bool LookupClosure(cmComputeLinkDependsCache& cache, ClosureKey const& key);
+  void StoreClosure(cmComputeLinkDependsCache& cache, ClosureKey key);
+  void ComputeFinalLinkEntries();
+  bool ClosureIsShareable = true;
+  std::vector<std::string> UndefinedLibDepends;
+
   std::string const& GetCurrentFeature(
     std::string const& item, std::string const& defaultFeature) const;
 
@@ -212,3 +234,40 @@ private:
 
   size_t ComponentOrderId;
 };
+
+/** \class cmComputeLinkDependsCache
+ * \brief Share link dependency closures among targets.
+ *
+ * Many targets link to the same libraries, and the ordered closure of
+ * their link interfaces does not depend on the target being linked
+ * unless a link interface or feature refers to it.  The cache keeps the
+ * closures that are known not to, keyed by the direct link dependencies
+ * of the target that computed them, so that other targets with the same
+ * direct dependencies skip the graph traversal and ordering.
+ */
+class cmComputeLinkDependsCache
+{
+public:
+  using Key = cmComputeLinkDepends::ClosureKey;
+
+  struct Closure
+  {
+    cmComputeLinkDepends::EntryVector Entries;
+    std::vector<size_t> FinalLinkOrder;
+    std::vector<size_t> ObjectEntries;
+    // The entry of each item of the direct link lists, if any.
+    std::vector<size_t> DirectEntries;
+    // Variables named <item>_LIB_DEPENDS that were not defined.
+    std::vector<std::string> UndefinedLibDepends;
+  };
+
+  Closure const* Find(Key const& key) const;
+  void Store(Key key, Closure closure);
+  void Clear() { this->Closures.clear(); }
+
+  unsigned long long Hits = 0;
+  unsigned long long Misses = 0;
+
+private:
+  std::map<Key, Closure> Closures;
+};
@@ -7,8 +7,10 @@
 #include <cstring>
 #include <set>
 #include <sstream>
+#include <string>
 #include <utility>
 
+#include <cm/optional>
 #include <cm/string_view>
 #include <cmext/string_view>
 
@@ -20,6 +22,7 @@
 #include "cmConfigureLog.h"
 #include "cmExperimental.h"
 #include "cmExportTryCompileFileGenerator.h"
+#include "cmFileTime.h"
 #include "cmGlobalGenerator.h"
 #include "cmList.h"
 #include "cmMakefile.h"
@@ -31,6 +34,8 @@
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 #include "cmTarget.h"
+#include "cmTryCompileBatch.h"
+#include "cmTryCompileCache.h"
 #include "cmValue.h"
 #include "cmVersion.h"
 #include "cmake.h"
@@ -193,7 +198,9 @@ auto const TryCompileProjectArgParser =
   makeTryCompileParser(TryCompileBaseProjectArgParser);
 
 auto const TryCompileSourcesArgParser =
-  makeTryCompileParser(TryCompileBaseNewSourcesArgParser);
+  makeTryCompileParser(TryCompileBaseNewSourcesArgParser)
+    .Bind("ASYNC"_s, &Arguments::Async)
+  /* keep semicolon on own line */;
 
 auto const TryCompileOldArgParser =
   makeTryCompileParser(TryCompileBaseSourcesArgParser)
@@ -312,9 +319,12 @@ Arguments cmCoreTryCompile::ParseArgs(
 }
 
 cm::optional<cmTryCompileResult> cmCoreTryCompile::TryCompileCode(
-  Arguments& arguments, cmStateEnums::TargetType targetType)
+  Arguments& arguments, cmStateEnums::TargetType targetType,
+  cmTryCompileBatch* batch,
+  std::function<void(cm::optional<cmTryCompileResult>)> finish)
 {
   this->OutputFile.clear();
+  this->Deferred = false;
   // which signature were we called with ?
   this->SrcFileSignature = true;
 
@@ -498,6 +508,20 @@ cm::optional<cmTryCompileResult> cmCoreTryCompile::TryCompileCode(
 
   std::map<std::string, std::string> cmakeVariables;
 
+  // Results of source file signatures may be shared through a cache.
+  // Imported targets to link are not keyed, so skip checks using them.
+  cm::optional<cmTryCompileCache>& cache = this->Cache;
+  cache.reset();
+  cmValue cacheDir =
+    this->Makefile->GetDefinition("CMAKE_TRY_COMPILE_CACHE_DIR");
+  if (this->SrcFileSignature && targets.empty() && cmNonempty(cacheDir) &&
+      !this->Makefile->GetCMakeInstance()->GetDebugTryCompile()) {
+    cache.emplace(cmSystemTools::CollapseFullPath(
+      *cacheDir, this->Makefile->GetHomeOutputDirectory()));
+    cache->AddReplacement(this->BinaryDirectory, "<BINARY_DIR>");
+    cache->AddReplacement(targetName, "<TARGET_NAME>");
+  }
+
   std::string outFileName = cmStrCat(this->BinaryDirectory, "/CMakeLists.txt");
   // which signature are we using? If we are using var srcfile bindir
   if (this->SrcFileSignature) {
@@ -604,6 +628,82 @@ cm::optional<cmTryCompileResult> cmCoreTryCompile::TryCompileCode(
     std::string const tcConfig =
       this->Makefile->GetSafeDefinition("CMAKE_TRY_COMPILE_CONFIGURATION");
 
+    if (cache) {
+      // Identify the sources, the toolchain and the build.
+      for (auto const& source : sources) {
+        cache->AddKey("source"_s, source.first);
+        cache->AddFileKey("content"_s, source.first);
+      }
+      for (std::string const& lang : testLangs) {
+        static std::array<cm::string_view, 4> const compilerSuffixes{
+          { "_COMPILER"_s, "_COMPILER_ARG1"_s, "_COMPILER_ID"_s,
+            "_COMPILER_VERSION"_s }
+        };
+        for (cm::string_view suffix : compilerSuffixes) {
+          std::string const var = cmStrCat("CMAKE_", lang, suffix);
+          cache->AddKey(var, this->Makefile->GetSafeDefinition(var));
+        }
+        cmFileTime compilerTime;
+        if (compilerTime.Load(this->Makefile->GetSafeDefinition(
+              cmStrCat("CMAKE_", lang, "_COMPILER")))) {
+          cache->AddKey("compiler time"_s,
+                        std::to_string(compilerTime.GetTime()));
+        }
+      }
+      for (cm::string_view var :
+           { "CMAKE_AR"_s, "CMAKE_LINKER"_s, "CMAKE_RANLIB"_s,
+             "CMAKE_SYSTEM_NAME"_s, "CMAKE_SYSTEM_PROCESSOR"_s,
+             "CMAKE_GENERATOR_PLATFORM"_s, "CMAKE_GENERATOR_TOOLSET"_s }) {
+        std::string const name(var);
+        cache->AddKey(var, this->Makefile->GetSafeDefinition(name));
+      }
+      if (cmValue toolchainFile =
+            this->Makefile->GetDefinition("CMAKE_TOOLCHAIN_FILE")) {
+        cache->AddFileKey("CMAKE_TOOLCHAIN_FILE"_s, *toolchainFile);
+      }
+
+      // The generated project names the modules and rules overrides it
+      // loads, so add their content, too.
+      std::vector<std::string> rulesOverrides{
+        "CMAKE_USER_MAKE_RULES_OVERRIDE"
+      };
+      for (std::string const& lang : testLangs) {
+        rulesOverrides.emplace_back(
+          cmStrCat("CMAKE_USER_MAKE_RULES_OVERRIDE_", lang));
+      }
+      for (std::string const& var : rulesOverrides) {
+        if (cmValue rulesOverride = this->Makefile->GetDefinition(var)) {
+          cache->AddFileKey(var, *rulesOverride);
+        }
+      }
+      // Any module may be included while the languages are enabled, so
+      // add all of them.  They are listed and read once per configure.
+      cache->AddKey("modules"_s,
+                    gg->GetModulePathDigest(this->Makefile->GetSafeDefinition(
+                      "CMAKE_MODULE_PATH")));
+
+      // The compilers and tools look up headers, libraries and SDKs in
+      // the environment.
+      static std::array<cm::string_view, 18> const environment{
+        { "CPATH"_s, "C_INCLUDE_PATH"_s, "CPLUS_INCLUDE_PATH"_s,
+          "OBJC_INCLUDE_PATH"_s, "LIBRARY_PATH"_s, "COMPILER_PATH"_s,
+          "GCC_EXEC_PREFIX"_s, "INCLUDE"_s, "EXTERNAL_INCLUDE"_s, "LIB"_s,
+          "LIBPATH"_s, "PKG_CONFIG_PATH"_s, "PKG_CONFIG_LIBDIR"_s,
+          "PKG_CONFIG_SYSROOT_DIR"_s, "SDKROOT"_s, "DEVELOPER_DIR"_s,
+          "MACOSX_DEPLOYMENT_TARGET"_s, "CL"_s }
+      };
+      for (cm::string_view var : environment) {
+        std::string value;
+        if (cmSystemTools::GetEnv(std::string(var), value)) {
+          cache->AddKey(cmStrCat("ENV{", var, '}'), value);
+        }
+      }
+      cache->AddKey("version"_s, cmVersion::GetCMakeVersion());
+      cache->AddKey("generator"_s, gg->GetName());
+      cache->AddKey("type"_s, cmState::GetTargetTypeName(targetType));
+      cache->AddKey("config"_s, tcConfig);
+    }
+
     // we need to create a directory and CMakeLists file etc...
     // first create the directories
     sourceDirectory = this->BinaryDirectory;
@@ -1198,18 +1298,71 @@ cm::optional<cmTryCompileResult> cmCoreTryCompile::TryCompileCode(
     this->Makefile->IssueMessage(MessageType::LOG, msg);
   }
 
-  bool erroroc = cmSystemTools::GetErrorOccurredFlag();
-  cmSystemTools::ResetErrorOccurredFlag();
+  this->Cached.reset();
+  if (cache) {
+    cache->AddFileKey("project"_s, outFileName);
+    for (std::string const& flag : arguments.CMakeFlags) {
+      cache->AddKey("flag"_s, flag);
+    }
+    this->Cached = cache->Load(this->BinaryDirectory, targetName);
+  }
+
   std::string output;
-  // actually do the try compile now that everything is setup
-  int res = this->Makefile->TryCompile(
-    sourceDirectory, this->BinaryDirectory, projectName, targetName,
-    this->SrcFileSignature, cmake::NO_BUILD_PARALLEL_LEVEL,
-    &arguments.CMakeFlags, output);
-  if (erroroc) {
-    cmSystemTools::SetErrorOccurred();
+  int res;
+  std::vector<cmGlobalGenerator::GeneratedMakeCommand> buildCommands;
+  if (this->Cached) {
+    output = std::move(this->Cached->Output);
+    res = this->Cached->ExitCode;
+  } else {
+    bool erroroc = cmSystemTools::GetErrorOccurredFlag();
+    cmSystemTools::ResetErrorOccurredFlag();
+    if (batch) {
+      // generate the project now and leave building it to the batch
+      res = this->Makefile->GenerateTryCompile(
+        sourceDirectory, this->BinaryDirectory, this->SrcFileSignature,
+        &arguments.CMakeFlags);
+      if (res == 0 &&
+          !this->Makefile->GetGlobalGenerator()
+             ->GenerateTryCompileBuildCommand(
+               cmake::NO_BUILD_PARALLEL_LEVEL, this->BinaryDirectory,
+               projectName, targetName, this->SrcFileSignature,
+               this->Makefile, buildCommands, output)) {
+        res = 1;
+      }
+    } else {
+      // actually do the try compile now that everything is setup
+      res = this->Makefile->TryCompile(
+        sourceDirectory, this->BinaryDirectory, projectName, targetName,
+        this->SrcFileSignature, cmake::NO_BUILD_PARALLEL_LEVEL,
+        &arguments.CMakeFlags, output);
+    }
+    if (erroroc) {
+      cmSystemTools::SetErrorOccurred();
+    }
   }
 
+  this->SourceDirectory = std::move(sourceDirectory);
+  this->TargetName = std::move(targetName);
+  this->CMakeVariables = std::move(cmakeVariables);
+
+  if (batch) {
+    this->Deferred = true;
+    batch->Add(this->BinaryDirectory, std::move(buildCommands), res,
+               std::move(output),
+               [this, &arguments, finish](int exitCode, std::string out) {
+                 finish(this->FinishTryCompile(arguments, exitCode,
+                                               std::move(out)));
+               });
+    return cm::nullopt;
+  }
+  return this->FinishTryCompile(arguments, res, std::move(output));
+}
+
+cm::optional<cmTryCompileResult> cmCoreTryCompile::FinishTryCompile(
+  Arguments& arguments, int res, std::string output)
+{
+  std::string const& targetName = this->TargetName;
+
   // set the result var to the return value to indicate success or failure
   if (arguments.NoCache) {
     this->Makefile->AddDefinition(*arguments.CompileResultVariable,
@@ -1226,7 +1379,24 @@ cm::optional<cmTryCompileResult> cmCoreTryCompile::TryCompileCode(
 
   if (this->SrcFileSignature) {
     std::string copyFileErrorMessage;
-    this->FindOutputFile(targetName);
+    if (this->Cached) {
+      this->FindErrorMessage.clear();
+      this->OutputFile = std::move(this->Cached->OutputFile);
+    } else {
+      this->FindOutputFile(targetName);
+      // Store successes with the file they produced.  Failures are not
+      // stored, because they may be caused by headers or libraries outside
+      // of the key that are installed later.  WebAssembly outputs come
+      // with a JavaScript loader not stored.
+      if (this->Cache && res == 0 && !this->OutputFile.empty() &&
+          !cmHasLiteralSuffix(this->OutputFile, ".wasm")) {
+        cmTryCompileCache::Entry entry;
+        entry.ExitCode = res;
+        entry.Output = output;
+        entry.OutputFile = this->OutputFile;
+        this->Cache->Store(entry);
+      }
+    }
 
     if ((res == 0) && arguments.CopyFileTo) {
       std::string const& copyFile = *arguments.CopyFileTo;
@@ -1272,8 +1442,8 @@ cm::optional<cmTryCompileResult> cmCoreTryCompile::TryCompileCode(
   if (arguments.LogDescription) {
     result.LogDescription = *arguments.LogDescription;
   }
-  result.CMakeVariables = std::move(cmakeVariables);
-  result.SourceDirectory = sourceDirectory;
+  result.CMakeVariables = std::move(this->CMakeVariables);
+  result.SourceDirectory = this->SourceDirectory;
   result.BinaryDirectory = this->BinaryDirectory;
   result.Variable = *arguments.CompileResultVariable;
   result.VariableCached = !arguments.NoCache;
@@ -4,6 +4,7 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <functional>
 #include <map>
 #include <string>
 #include <utility>
@@ -16,9 +17,11 @@
 #include "cmArgumentParserTypes.h"
 #include "cmList.h"
 #include "cmStateTypes.h"
+#include "cmTryCompileCache.h"
 
 class cmConfigureLog;
 class cmMakefile;
+class cmTryCompileBatch;
 template <typename Iter>
 class cmRange;
 
@@ -100,6 +103,7 @@ public:
     cm::optional<ArgumentParser::NonEmpty<std::string>> LogDescription;
     bool NoCache = false;
     bool NoLog = false;
+    bool Async = false;
 
     ArgumentParser::Continue SetSourceType(cm::string_view sourceType);
     SourceType SourceTypeContext = SourceType::Normal;
@@ -124,9 +128,16 @@ public:
    *
    * This function requires at least two \p arguments and will crash if given
    * fewer.
+   *
+   * If a \p batch is given, the test project is built by it and the
+   * function returns with \c Deferred set.  The result is then passed to
+   * \p finish when the batch is waited for.  The caller must keep this
+   * object and the \p arguments until then.
    */
   cm::optional<cmTryCompileResult> TryCompileCode(
-    Arguments& arguments, cmStateEnums::TargetType targetType);
+    Arguments& arguments, cmStateEnums::TargetType targetType,
+    cmTryCompileBatch* batch = nullptr,
+    std::function<void(cm::optional<cmTryCompileResult>)> finish = {});
 
   /**
    * Returns \c true if \p path resides within a CMake temporary directory,
@@ -155,13 +166,25 @@ public:
   std::string OutputFile;
   std::string FindErrorMessage;
   bool SrcFileSignature = false;
+  bool Deferred = false;
   cmMakefile* Makefile;
 
 private:
+  cm::optional<cmTryCompileResult> FinishTryCompile(Arguments& arguments,
+                                                    int res,
+                                                    std::string output);
+
   std::string WriteSource(std::string const& name, std::string const& content,
                           char const* command) const;
 
   Arguments ParseArgs(cmRange<std::vector<std::string>::const_iterator> args,
                       cmArgumentParser<Arguments> const& parser,
                       std::vector<std::string>& unparsedArguments);
+
+  // State of TryCompileCode kept for FinishTryCompile.
+  std::string SourceDirectory;
+  std::string TargetName;
+  std::map<std::string, std::string> CMakeVariables;
+  cm::optional<cmTryCompileCache> Cache;
+  cm::optional<cmTryCompileCache::Entry> Cached;
 };
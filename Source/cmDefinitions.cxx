@@ -8,42 +8,77 @@
 
 #include <cm/string_view>
 
+#include "cmStringPool.h"
+
 cmDefinitions::Def cmDefinitions::NoDef;
 
 cmDefinitions::Def const& cmDefinitions::GetInternal(std::string const& key,
                                                      StackIter begin,
-                                                     StackIter end, bool raise)
+                                                     StackIter end,
+                                                     std::size_t epoch)
 {
   assert(begin != end);
+  cm::String const borrowed = cm::String::borrow(key);
   {
-    auto it = begin->Map.find(cm::String::borrow(key));
+    auto it = begin->Map.find(borrowed);
     if (it != begin->Map.end()) {
       return it->second;
     }
   }
+  if (begin->CacheEpoch != epoch) {
+    begin->Cache.clear();
+    begin->CacheEpoch = epoch;
+  } else {
+    auto it = begin->Cache.find(borrowed);
+    if (it != begin->Cache.end()) {
+      return it->second;
+    }
+  }
+
+  // Search the enclosing scopes.  Their caches hold what they found in
+  // their own enclosing scopes.
+  std::pair<cm::String const, Def> const* found = nullptr;
+  std::size_t depth = 0;
   StackIter it = begin;
-  ++it;
-  if (it == end) {
-    return cmDefinitions::NoDef;
+  for (++it; it != end && !found; ++it, ++depth) {
+    auto mi = it->Map.find(borrowed);
+    if (mi != it->Map.end()) {
+      found = &*mi;
+    } else if (it->CacheEpoch == epoch) {
+      auto ci = it->Cache.find(borrowed);
+      if (ci != it->Cache.end()) {
+        found = &*ci;
+      }
+    }
+  }
+
+  // Definitions of the enclosing scope itself are found quickly anyway.
+  if (depth <= 1) {
+    return found ? found->second : cmDefinitions::NoDef;
   }
-  Def const& def = cmDefinitions::GetInternal(key, it, end, raise);
-  if (!raise) {
-    return def;
+  if (!found) {
+    return begin->Cache.emplace(std::string(key), cmDefinitions::NoDef)
+      .first->second;
   }
-  return begin->Map.emplace(key, def).first->second;
+  return begin->Cache.emplace(*found).first->second;
 }
 
 cmValue cmDefinitions::Get(std::string const& key, StackIter begin,
-                           StackIter end)
+                           StackIter end, std::size_t epoch)
 {
-  Def const& def = cmDefinitions::GetInternal(key, begin, end, false);
+  Def const& def = cmDefinitions::GetInternal(key, begin, end, epoch);
   return def.Value ? cmValue(def.Value.str_if_stable()) : nullptr;
 }
 
 void cmDefinitions::Raise(std::string const& key, StackIter begin,
-                          StackIter end)
+                          StackIter end, std::size_t epoch,
+                          cmStringPool& pool)
 {
-  cmDefinitions::GetInternal(key, begin, end, true);
+  if (begin->Map.find(cm::String::borrow(key)) != begin->Map.end()) {
+    return;
+  }
+  Def def = cmDefinitions::GetInternal(key, begin, end, epoch);
+  begin->Map.emplace(pool.Intern(key), std::move(def));
 }
 
 bool cmDefinitions::HasKey(std::string const& key, StackIter begin,
@@ -97,12 +132,35 @@ std::vector<std::string> cmDefinitions::ClosureKeys(StackIter begin,
   return defined;
 }
 
-void cmDefinitions::Set(std::string const& key, cm::string_view value)
+void cmDefinitions::Set(std::string const& key, cm::string_view value,
+                        cmStringPool& pool)
+{
+  Def def(pool.Intern(value));
+  auto it = this->Map.find(cm::String::borrow(key));
+  if (it != this->Map.end()) {
+    pool.Release(std::move(it->second.Value));
+    it->second = std::move(def);
+  } else {
+    this->Map.emplace(pool.Intern(key), std::move(def));
+  }
+}
+
+void cmDefinitions::Unset(std::string const& key, cmStringPool& pool)
 {
-  this->Map[key] = Def(value);
+  auto it = this->Map.find(cm::String::borrow(key));
+  if (it != this->Map.end()) {
+    pool.Release(std::move(it->second.Value));
+    it->second = Def();
+  } else {
+    this->Map.emplace(pool.Intern(key), Def());
+  }
 }
 
-void cmDefinitions::Unset(std::string const& key)
+std::size_t cmDefinitions::GetMemoryUsage() const
 {
-  this->Map[key] = Def();
+  // Each entry is a node of the hash table holding the key and value.
+  using value_type = decltype(this->Map)::value_type;
+  std::size_t const entries = this->Map.size() + this->Cache.size();
+  return entries * (sizeof(value_type) + 2 * sizeof(void*)) +
+    (this->Map.bucket_count() + this->Cache.bucket_count()) * sizeof(void*);
 }
@@ -4,8 +4,10 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <cstddef>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <cm/string_view>
@@ -14,12 +16,18 @@
 #include "cmString.hxx"
 #include "cmValue.h"
 
+class cmStringPool;
+
 /** \class cmDefinitions
  * \brief Store a scope of variable definitions for CMake language.
  *
  * This stores the state of variable definitions (set or unset) for
  * one scope.  Sets are always local.  Gets search parent scopes
- * transitively and save results locally.
+ * transitively and cache what they find more than one scope up, so
+ * reads in deeply nested scopes do not search all parents each time.
+ * The caches are valid while the given epoch is unchanged.  The owner
+ * of the scopes must change it when it modifies a scope other than the
+ * innermost one in a way not made invisible by Raise.
  */
 class cmDefinitions
 {
@@ -28,9 +36,13 @@ class cmDefinitions
 public:
   // -- Static member functions
 
-  static cmValue Get(std::string const& key, StackIter begin, StackIter end);
+  static cmValue Get(std::string const& key, StackIter begin, StackIter end,
+                     std::size_t epoch);
 
-  static void Raise(std::string const& key, StackIter begin, StackIter end);
+  /** Define a key in the innermost scope with its current value, so that
+      the scope is not affected by a later change of the enclosing one.  */
+  static void Raise(std::string const& key, StackIter begin, StackIter end,
+                    std::size_t epoch, cmStringPool& pool);
 
   static bool HasKey(std::string const& key, StackIter begin, StackIter end);
 
@@ -40,11 +52,16 @@ public:
 
   // -- Member functions
 
-  /** Set a value associated with a key.  */
-  void Set(std::string const& key, cm::string_view value);
+  /** Set a value associated with a key.  The key and value share the
+      storage of equal strings in the pool.  */
+  void Set(std::string const& key, cm::string_view value, cmStringPool& pool);
 
   /** Unset a definition.  */
-  void Unset(std::string const& key);
+  void Unset(std::string const& key, cmStringPool& pool);
+
+  /** Estimate the bytes held by this scope, not counting the strings
+      shared with the pool.  */
+  std::size_t GetMemoryUsage() const;
 
 private:
   /** String with existence boolean.  */
@@ -56,12 +73,18 @@ private:
       : Value(value)
     {
     }
+    Def(cm::String value)
+      : Value(std::move(value))
+    {
+    }
     cm::String Value;
   };
   static Def NoDef;
 
   std::unordered_map<cm::String, Def> Map;
+  std::unordered_map<cm::String, Def> Cache;
+  std::size_t CacheEpoch = 0;
 
   static Def const& GetInternal(std::string const& key, StackIter begin,
-                                StackIter end, bool raise);
+                                StackIter end, std::size_t epoch);
 };
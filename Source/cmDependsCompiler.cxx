@@ -4,8 +4,12 @@
 #include "cmDependsCompiler.h"
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <utility>
 
@@ -24,164 +28,292 @@
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 
+namespace {
+// The internal dependencies database is a binary file holding a table of
+// interned paths followed by the adjacency list of each depender:
+//
+//   magic
+//   <number of paths> { <length> <characters> }
+//   <number of dependers> { <path index> <number of dependees>
+//                           { <path index> } }
+//
+// Integers are stored as 32-bit little-endian values.
+char const DatabaseMagic[] = { 'C', 'M', 'D', 'E', 'P', 'D', 'B', '1' };
+
+void WriteU32(std::ostream& os, std::uint32_t value)
+{
+  char bytes[4];
+  for (char& byte : bytes) {
+    byte = static_cast<char>(value & 0xff);
+    value >>= 8;
+  }
+  os.write(bytes, sizeof(bytes));
+}
+
+class DatabaseReader
+{
+public:
+  DatabaseReader(char const* begin, char const* end)
+    : Current(begin)
+    , End(end)
+  {
+  }
+
+  bool ReadMagic()
+  {
+    if (static_cast<std::size_t>(this->End - this->Current) <
+        sizeof(DatabaseMagic)) {
+      return false;
+    }
+    if (!std::equal(std::begin(DatabaseMagic), std::end(DatabaseMagic),
+                    this->Current)) {
+      return false;
+    }
+    this->Current += sizeof(DatabaseMagic);
+    return true;
+  }
+
+  bool ReadU32(std::uint32_t& value)
+  {
+    if (this->End - this->Current < 4) {
+      return false;
+    }
+    value = 0;
+    for (int i = 3; i >= 0; --i) {
+      value = (value << 8) | static_cast<unsigned char>(this->Current[i]);
+    }
+    this->Current += 4;
+    return true;
+  }
+
+  bool ReadString(std::string& value)
+  {
+    std::uint32_t length;
+    if (!this->ReadU32(length) ||
+        static_cast<std::uint32_t>(this->End - this->Current) < length) {
+      return false;
+    }
+    value.assign(this->Current, length);
+    this->Current += length;
+    return true;
+  }
+
+private:
+  char const* Current;
+  char const* End;
+};
+
+bool HasDatabaseMagic(std::string const& file)
+{
+  cmsys::ifstream fin(file.c_str(), std::ios::in | std::ios::binary);
+  char magic[sizeof(DatabaseMagic)];
+  return fin && fin.read(magic, sizeof(magic)) &&
+    std::equal(std::begin(DatabaseMagic), std::end(DatabaseMagic), magic);
+}
+
+bool ReadDatabase(std::string const& file,
+                  cmDepends::DependencyMap& dependencies)
+{
+  // Load the whole database at once and decode it from memory.
+  cmsys::ifstream fin(file.c_str(), std::ios::in | std::ios::binary);
+  if (!fin) {
+    return false;
+  }
+  std::string const content{ std::istreambuf_iterator<char>(fin),
+                             std::istreambuf_iterator<char>() };
+  DatabaseReader reader(content.data(), content.data() + content.size());
+  if (!reader.ReadMagic()) {
+    return false;
+  }
+
+  std::uint32_t count;
+  if (!reader.ReadU32(count)) {
+    return false;
+  }
+  std::vector<std::string> paths;
+  paths.reserve(count);
+  for (std::uint32_t i = 0; i < count; ++i) {
+    std::string path;
+    if (!reader.ReadString(path)) {
+      return false;
+    }
+    paths.emplace_back(std::move(path));
+  }
+
+  if (!reader.ReadU32(count)) {
+    return false;
+  }
+  for (std::uint32_t i = 0; i < count; ++i) {
+    std::uint32_t index;
+    std::uint32_t size;
+    if (!reader.ReadU32(index) || index >= paths.size() ||
+        !reader.ReadU32(size)) {
+      return false;
+    }
+    std::vector<std::string>& depends = dependencies[paths[index]];
+    depends.clear();
+    depends.reserve(size);
+    for (std::uint32_t j = 0; j < size; ++j) {
+      if (!reader.ReadU32(index) || index >= paths.size()) {
+        return false;
+      }
+      depends.push_back(paths[index]);
+    }
+  }
+  return true;
+}
+}
+
 bool cmDependsCompiler::CheckDependencies(
   std::string const& internalDepFile, std::vector<std::string> const& depFiles,
   cmDepends::DependencyMap& dependencies,
   std::function<bool(std::string const&)> const& isValidPath)
 {
-  bool status = true;
   bool forceReadDeps = true;
 
   cmFileTime internalDepFileTime;
-  // read cached dependencies stored in internal file
-  if (cmSystemTools::FileExists(internalDepFile)) {
-    internalDepFileTime.Load(internalDepFile);
+  if (internalDepFileTime.Load(internalDepFile) &&
+      HasDatabaseMagic(internalDepFile)) {
     forceReadDeps = false;
-
-    // read current dependencies
-    cmsys::ifstream fin(internalDepFile.c_str());
-    if (fin) {
-      std::string line;
-      std::string depender;
-      std::vector<std::string>* currentDependencies = nullptr;
-      while (std::getline(fin, line)) {
-        if (line.empty() || line.front() == '#') {
-          continue;
-        }
-        // Drop carriage return character at the end
-        if (line.back() == '\r') {
-          line.pop_back();
-          if (line.empty()) {
-            continue;
-          }
-        }
-        // Check if this a depender line
-        if (line.front() != ' ') {
-          depender = std::move(line);
-          currentDependencies = &dependencies[depender];
-          continue;
-        }
-        // This is a dependee line
-        if (currentDependencies) {
-          currentDependencies->emplace_back(line.substr(1));
-        }
-      }
-      fin.close();
-    }
   }
 
-  // Now, update dependencies map with all new compiler generated
-  // dependencies files
+  // Select the compiler generated dependencies files newer than the
+  // database.  On a no-op build there is none and the database is not read.
+  std::vector<std::size_t> updatedDepFiles;
   cmFileTime depFileTime;
-  for (auto dep = depFiles.begin(); dep != depFiles.end(); dep++) {
-    auto const& source = *dep++;
-    auto const& target = *dep++;
-    auto const& format = *dep++;
-    auto const& depFile = *dep;
-
-    if (!cmSystemTools::FileExists(depFile)) {
+  for (std::size_t index = 0; index + 3 < depFiles.size(); index += 4) {
+    auto const& depFile = depFiles[index + 3];
+    if (forceReadDeps) {
+      if (cmSystemTools::FileExists(depFile)) {
+        updatedDepFiles.push_back(index);
+      }
       continue;
     }
-
-    if (!forceReadDeps) {
-      depFileTime.Load(depFile);
-    }
-    if (forceReadDeps || depFileTime.Compare(internalDepFileTime) >= 0) {
-      status = false;
+    if (depFileTime.Load(depFile) &&
+        depFileTime.Compare(internalDepFileTime) >= 0) {
       if (this->Verbose) {
         cmSystemTools::Stdout(cmStrCat("Dependencies file \"", depFile,
                                        "\" is newer than depends file \"",
                                        internalDepFile, "\".\n"));
       }
+      updatedDepFiles.push_back(index);
+    }
+  }
+
+  if (updatedDepFiles.empty()) {
+    return true;
+  }
+
+  // Read the cached dependencies and update only the dependers whose
+  // dependencies file changed.  A database which cannot be decoded is
+  // rebuilt from all dependencies files.
+  if (!forceReadDeps && !ReadDatabase(internalDepFile, dependencies)) {
+    dependencies.clear();
+    updatedDepFiles.clear();
+    for (std::size_t index = 0; index + 3 < depFiles.size(); index += 4) {
+      if (cmSystemTools::FileExists(depFiles[index + 3])) {
+        updatedDepFiles.push_back(index);
+      }
+    }
+  }
+
+  // Now, update dependencies map with all new compiler generated
+  // dependencies files.  They typically share most of their paths.
+  cmGccDepfilePathTable pathTable;
+  for (std::size_t index : updatedDepFiles) {
+    auto const& source = depFiles[index];
+    auto const& target = depFiles[index + 1];
+    auto const& format = depFiles[index + 2];
+    auto const& depFile = depFiles[index + 3];
+
+    std::vector<std::string> depends;
+    if (format == "custom"_s) {
+      auto deps = cmReadGccDepfile(
+        depFile.c_str(), this->LocalGenerator->GetCurrentBinaryDirectory(),
+        GccDepfilePrependPaths::All, &pathTable);
+      if (!deps) {
+        continue;
+      }
 
-      std::vector<std::string> depends;
-      if (format == "custom"_s) {
+      for (auto& entry : *deps) {
+        depends = std::move(entry.paths);
+        if (isValidPath) {
+          cm::erase_if(depends, isValidPath);
+        }
+        // copy depends for each target, except first one, which can be
+        // moved
+        for (auto rule = entry.rules.size() - 1; rule > 0; --rule) {
+          dependencies[entry.rules[rule]] = depends;
+        }
+        dependencies[entry.rules.front()] = std::move(depends);
+      }
+    } else {
+      if (format == "msvc"_s) {
+        cmsys::ifstream fin(depFile.c_str());
+        if (!fin) {
+          continue;
+        }
+
+        std::string line;
+        if (!isValidPath && !source.empty()) {
+          // insert source as first dependency
+          depends.push_back(source);
+        }
+        while (cmSystemTools::GetLineFromStream(fin, line)) {
+          depends.emplace_back(std::move(line));
+        }
+      } else if (format == "gcc"_s) {
         auto deps = cmReadGccDepfile(
-          depFile.c_str(), this->LocalGenerator->GetCurrentBinaryDirectory());
+          depFile.c_str(), this->LocalGenerator->GetCurrentBinaryDirectory(),
+          GccDepfilePrependPaths::Deps, &pathTable);
         if (!deps) {
           continue;
         }
 
-        for (auto& entry : *deps) {
-          depends = std::move(entry.paths);
-          if (isValidPath) {
-            cm::erase_if(depends, isValidPath);
-          }
-          // copy depends for each target, except first one, which can be
-          // moved
-          for (auto index = entry.rules.size() - 1; index > 0; --index) {
-            dependencies[entry.rules[index]] = depends;
-          }
-          dependencies[entry.rules.front()] = std::move(depends);
+        // dependencies generated by the compiler contains only one target
+        depends = std::move(deps->front().paths);
+        if (depends.empty()) {
+          // unexpectedly empty, ignore it and continue
+          continue;
         }
-      } else {
-        if (format == "msvc"_s) {
-          cmsys::ifstream fin(depFile.c_str());
-          if (!fin) {
-            continue;
-          }
-
-          std::string line;
-          if (!isValidPath && !source.empty()) {
-            // insert source as first dependency
-            depends.push_back(source);
-          }
-          while (cmSystemTools::GetLineFromStream(fin, line)) {
-            depends.emplace_back(std::move(line));
-          }
-        } else if (format == "gcc"_s) {
-          auto deps = cmReadGccDepfile(
-            depFile.c_str(), this->LocalGenerator->GetCurrentBinaryDirectory(),
-            GccDepfilePrependPaths::Deps);
-          if (!deps) {
-            continue;
-          }
 
-          // dependencies generated by the compiler contains only one target
-          depends = std::move(deps->front().paths);
-          if (depends.empty()) {
-            // unexpectedly empty, ignore it and continue
-            continue;
-          }
-
-          // depending of the effective format of the dependencies file
-          // generated by the compiler, the target can be wrongly identified
-          // as a dependency so remove it from the list
-          if (depends.front() == target) {
-            depends.erase(depends.begin());
-          }
+        // depending of the effective format of the dependencies file
+        // generated by the compiler, the target can be wrongly identified
+        // as a dependency so remove it from the list
+        if (depends.front() == target) {
+          depends.erase(depends.begin());
+        }
 
-          // ensure source file is the first dependency
-          if (!source.empty()) {
-            if (depends.front() != source) {
-              cm::erase(depends, source);
-              if (!isValidPath) {
-                depends.insert(depends.begin(), source);
-              }
-            } else if (isValidPath) {
-              // remove first dependency because it must not be filtered out
-              depends.erase(depends.begin());
+        // ensure source file is the first dependency
+        if (!source.empty()) {
+          if (depends.front() != source) {
+            cm::erase(depends, source);
+            if (!isValidPath) {
+              depends.insert(depends.begin(), source);
             }
+          } else if (isValidPath) {
+            // remove first dependency because it must not be filtered out
+            depends.erase(depends.begin());
           }
-        } else {
-          // unknown format, ignore it
-          continue;
         }
+      } else {
+        // unknown format, ignore it
+        continue;
+      }
 
-        if (isValidPath) {
-          cm::erase_if(depends, isValidPath);
-          if (!source.empty()) {
-            // insert source as first dependency
-            depends.insert(depends.begin(), source);
-          }
+      if (isValidPath) {
+        cm::erase_if(depends, isValidPath);
+        if (!source.empty()) {
+          // insert source as first dependency
+          depends.insert(depends.begin(), source);
         }
-
-        dependencies[target] = std::move(depends);
       }
+
+      dependencies[target] = std::move(depends);
     }
   }
 
-  return status;
+  return false;
 }
 
 void cmDependsCompiler::WriteDependencies(
@@ -235,13 +367,35 @@ void cmDependsCompiler::WriteDependencies(
     makeDepends << std::endl << target << ':' << std::endl;
   }
 
-  // internal dependencies file
+  // internal dependencies database, paths are interned
+  std::unordered_map<cm::string_view, std::uint32_t> pathIndexes;
+  std::vector<cm::string_view> paths;
+  auto intern = [&pathIndexes, &paths](std::string const& path) {
+    auto const inserted = pathIndexes.emplace(
+      path, static_cast<std::uint32_t>(paths.size()));
+    if (inserted.second) {
+      paths.emplace_back(path);
+    }
+    return inserted.first->second;
+  };
+  std::vector<std::uint32_t> nodes;
   for (auto const& node : dependencies) {
-    internalDepends << node.first << std::endl;
+    nodes.push_back(intern(node.first));
+    nodes.push_back(static_cast<std::uint32_t>(node.second.size()));
     for (auto const& dep : node.second) {
-      internalDepends << ' ' << dep << std::endl;
+      nodes.push_back(intern(dep));
     }
-    internalDepends << std::endl;
+  }
+
+  internalDepends.write(DatabaseMagic, sizeof(DatabaseMagic));
+  WriteU32(internalDepends, static_cast<std::uint32_t>(paths.size()));
+  for (cm::string_view const& path : paths) {
+    WriteU32(internalDepends, static_cast<std::uint32_t>(path.size()));
+    internalDepends.write(path.data(), path.size());
+  }
+  WriteU32(internalDepends, static_cast<std::uint32_t>(dependencies.size()));
+  for (std::uint32_t value : nodes) {
+    WriteU32(internalDepends, value);
   }
 }
 
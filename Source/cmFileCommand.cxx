@@ -38,6 +38,7 @@
 #include "cmFSPermissions.h"
 #include "cmFileCommand_ReadMacho.h"
 #include "cmFileCopier.h"
+#include "cmFileDigestManifest.h"
 #include "cmFileInstaller.h"
 #include "cmFileLockPool.h"
 #include "cmFileTimes.h"
@@ -762,6 +763,12 @@ bool HandleGlobImpl(std::vector<std::string> const& args, bool recurse,
         }
       }
 
+      if (configureDepends) {
+        // Record the directories before they are listed by the glob.
+        cm->AddGlobDirectories(
+          expr, recurse, recurse ? g.GetRecurseThroughSymlinks() : false);
+      }
+
       cmsys::Glob::GlobMessages globMessages;
       g.FindFiles(expr, &globMessages);
 
@@ -1075,6 +1082,7 @@ bool HandleRPathChangeCommand(std::vector<std::string> const& args,
         cmStrCat("Set non-toolchain portion of runtime path of \"", file,
                  "\" to \"", *newRPath, '"');
       status.GetMakefile().DisplayStatus(message, -1);
+      cmFileDigestManifest::Forget(status.GetMakefile(), file);
     }
     ft.Store(file);
   }
@@ -1130,6 +1138,7 @@ bool HandleRPathSetCommand(std::vector<std::string> const& args,
         cmStrCat("Set non-toolchain portion of runtime path of \"", file,
                  "\" to \"", *newRPath, '"');
       status.GetMakefile().DisplayStatus(message, -1);
+      cmFileDigestManifest::Forget(status.GetMakefile(), file);
     }
     ft.Store(file);
   }
@@ -1178,6 +1187,7 @@ bool HandleRPathRemoveCommand(std::vector<std::string> const& args,
       std::string message =
         cmStrCat("Removed runtime path from \"", file, '"');
       status.GetMakefile().DisplayStatus(message, -1);
+      cmFileDigestManifest::Forget(status.GetMakefile(), file);
     }
     ft.Store(file);
   }
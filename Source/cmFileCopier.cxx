@@ -607,7 +607,7 @@ bool cmFileCopier::InstallFile(std::string const& fromFile,
 
   // Copy the file.
   if (copy) {
-    auto copy_status = cmSystemTools::CopyAFile(fromFile, toFile);
+    auto copy_status = this->CopyFileContent(fromFile, toFile);
     if (!copy_status) {
       std::ostringstream e;
       e << this->Name << " cannot copy file \"" << fromFile << "\" to \""
@@ -647,6 +647,12 @@ bool cmFileCopier::InstallFile(std::string const& fromFile,
   return this->SetPermissions(toFile, permissions);
 }
 
+cmsys::SystemTools::CopyStatus cmFileCopier::CopyFileContent(
+  std::string const& fromFile, std::string const& toFile)
+{
+  return cmSystemTools::CopyAFile(fromFile, toFile);
+}
+
 bool cmFileCopier::InstallDirectory(std::string const& source,
                                     std::string const& destination,
                                     MatchProperties match_properties)
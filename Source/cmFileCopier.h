@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "cmsys/RegularExpression.hxx"
+#include "cmsys/SystemTools.hxx"
 
 #include "cm_sys_stat.h"
 
@@ -70,6 +71,8 @@ protected:
   virtual bool InstallFile(std::string const& fromFile,
                            std::string const& toFile,
                            MatchProperties match_properties);
+  virtual cmsys::SystemTools::CopyStatus CopyFileContent(
+    std::string const& fromFile, std::string const& toFile);
   bool InstallDirectory(std::string const& source,
                         std::string const& destination,
                         MatchProperties match_properties);
@@ -0,0 +1,150 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#include "cmFileDigestManifest.h"
+
+#include <ostream>
+#include <sstream>
+
+#include "cmsys/FStream.hxx"
+
+#include "cm_sys_stat.h"
+
+#include "cmMakefile.h"
+#include "cmSystemTools.h"
+#include "cmValue.h"
+
+// Each record of a manifest is the path of a file on one line followed
+// by its status and digests on the next:
+//
+//   <path>
+//   <size> <inode> <mtime> <ctime> <algo>:<digest>...
+//
+// A record with an empty second line drops the digests of the file.
+
+bool cmFileDigestManifest::IsSupported()
+{
+#if (!defined(_WIN32) || defined(__CYGWIN__)) &&                              \
+  (CMake_STAT_HAS_ST_MTIM || CMake_STAT_HAS_ST_MTIMESPEC)
+  return true;
+#else
+  // Times with second resolution cannot tell an unchanged file from one
+  // modified right after its installation, and the change time of a
+  // file is not available on Windows.
+  return false;
+#endif
+}
+
+bool cmFileDigestManifest::Append(std::ostream& os, std::string const& file,
+                                  Digests const& digests)
+{
+  Stamp stamp;
+  if (file.find('\n') != std::string::npos || !stamp.Load(file)) {
+    return false;
+  }
+  os << cmSystemTools::CollapseFullPath(file) << '\n'
+     << stamp.Size << ' ' << stamp.Inode << ' ' << stamp.MTime << ' '
+     << stamp.CTime;
+  for (auto const& digest : digests) {
+    os << ' ' << digest.first << ':' << digest.second;
+  }
+  os << '\n';
+  return true;
+}
+
+void cmFileDigestManifest::Forget(cmMakefile const& mf,
+                                  std::string const& file)
+{
+  cmValue manifest = mf.GetDefinition("CMAKE_INSTALL_DIGEST_MANIFEST");
+  if (!cmNonempty(manifest) || file.find('\n') != std::string::npos) {
+    return;
+  }
+  cmsys::ofstream fout(manifest->c_str(), std::ios::out | std::ios::app);
+  fout << cmSystemTools::CollapseFullPath(file) << "\n\n";
+}
+
+void cmFileDigestManifest::Load(std::string const& manifest)
+{
+  this->Entries.clear();
+  cmsys::ifstream fin(manifest.c_str());
+  std::string file;
+  std::string line;
+  while (cmSystemTools::GetLineFromStream(fin, file) &&
+         cmSystemTools::GetLineFromStream(fin, line)) {
+    if (line.empty()) {
+      this->Entries.erase(file);
+      continue;
+    }
+    Entry entry;
+    std::istringstream in(line);
+    in >> entry.Status.Size >> entry.Status.Inode >> entry.Status.MTime >>
+      entry.Status.CTime;
+    std::string digest;
+    while (in >> digest) {
+      std::string::size_type colon = digest.find(':');
+      if (colon == std::string::npos) {
+        break;
+      }
+      entry.Values.emplace_back(digest.substr(0, colon),
+                                digest.substr(colon + 1));
+    }
+    if (in.fail() && !in.eof()) {
+      // Ignore a malformed record but keep dropping an older one.
+      this->Entries.erase(file);
+      continue;
+    }
+    this->Entries[file] = std::move(entry);
+  }
+}
+
+std::string cmFileDigestManifest::GetDigest(std::string const& file,
+                                            cm::string_view algo) const
+{
+  auto it = this->Entries.find(cmSystemTools::CollapseFullPath(file));
+  if (it == this->Entries.end()) {
+    return std::string();
+  }
+  for (auto const& digest : it->second.Values) {
+    if (digest.first == algo) {
+      Stamp stamp;
+      if (stamp.Load(file) && stamp == it->second.Status) {
+        return digest.second;
+      }
+      break;
+    }
+  }
+  return std::string();
+}
+
+bool cmFileDigestManifest::Stamp::Load(std::string const& file)
+{
+#if !defined(_WIN32) || defined(__CYGWIN__)
+  struct stat fst;
+  if (::stat(file.c_str(), &fst) != 0 || !S_ISREG(fst.st_mode)) {
+    return false;
+  }
+  this->Size = static_cast<unsigned long long>(fst.st_size);
+  this->Inode = static_cast<unsigned long long>(fst.st_ino);
+  long long const nsPerS = 1000000000;
+#  if CMake_STAT_HAS_ST_MTIM
+  this->MTime = fst.st_mtim.tv_sec * nsPerS + fst.st_mtim.tv_nsec;
+  this->CTime = fst.st_ctim.tv_sec * nsPerS + fst.st_ctim.tv_nsec;
+  return true;
+#  elif CMake_STAT_HAS_ST_MTIMESPEC
+  this->MTime = fst.st_mtimespec.tv_sec * nsPerS + fst.st_mtimespec.tv_nsec;
+  this->CTime = fst.st_ctimespec.tv_sec * nsPerS + fst.st_ctimespec.tv_nsec;
+  return true;
+#  else
+  static_cast<void>(nsPerS);
+  return false;
+#  endif
+#else
+  static_cast<void>(file);
+  return false;
+#endif
+}
+
+bool cmFileDigestManifest::Stamp::operator==(Stamp const& other) const
+{
+  return this->Size == other.Size && this->Inode == other.Inode &&
+    this->MTime == other.MTime && this->CTime == other.CTime;
+}
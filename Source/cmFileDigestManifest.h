@@ -0,0 +1,81 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#pragma once
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstddef>
+#include <iosfwd>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <cm/string_view>
+
+class cmMakefile;
+
+/** \class cmFileDigestManifest
+ * \brief Digests of installed files computed while they were copied.
+ *
+ * Packaging tools need digests of the files they package, and reading a
+ * large file again only to hash it costs as much as copying it did.
+ * When the CMAKE_INSTALL_DIGESTS variable names hash algorithms and the
+ * CMAKE_INSTALL_DIGEST_MANIFEST variable names a manifest file,
+ * file(INSTALL) hashes each file it copies and appends the digests to
+ * the manifest together with the status of the installed file.
+ *
+ * A digest is used only while the file keeps the size, inode and times
+ * it had right after installation, so a file rewritten later, e.g. by a
+ * strip tool, is hashed again by the caller.  Commands that rewrite a
+ * file in place and then restore its times, like file(RPATH_CHANGE),
+ * must call Forget for it.
+ */
+class cmFileDigestManifest
+{
+public:
+  using Digests = std::vector<std::pair<std::string, std::string>>;
+
+  /** Whether this platform provides a status of files precise enough to
+      decide later whether an installed file is unchanged.  */
+  static bool IsSupported();
+
+  /** Append the digests of an installed file to a manifest stream.
+      Returns false if the digests of the file cannot be recorded.  */
+  static bool Append(std::ostream& os, std::string const& file,
+                     Digests const& digests);
+
+  /** Drop the digests of a file that was modified in place from the
+      manifest the given makefile is recording, if any.  */
+  static void Forget(cmMakefile const& mf, std::string const& file);
+
+  /** Load a manifest.  Later records of a file replace earlier ones.  */
+  void Load(std::string const& manifest);
+
+  /** Get a digest of a file computed with the given algorithm.  Returns
+      an empty string if the manifest holds no such digest or the file
+      changed since it was recorded.  */
+  std::string GetDigest(std::string const& file, cm::string_view algo) const;
+
+  std::size_t GetCount() const { return this->Entries.size(); }
+
+private:
+  struct Stamp
+  {
+    unsigned long long Size = 0;
+    unsigned long long Inode = 0;
+    long long MTime = 0;
+    long long CTime = 0;
+
+    bool Load(std::string const& file);
+    bool operator==(Stamp const& other) const;
+  };
+
+  struct Entry
+  {
+    Stamp Status;
+    Digests Values;
+  };
+
+  std::unordered_map<std::string, Entry> Entries;
+};
@@ -12,8 +12,10 @@
 
 #include "cm_sys_stat.h"
 
+#include "cmCryptoHash.h"
 #include "cmExecutionStatus.h"
 #include "cmFSPermissions.h"
+#include "cmList.h"
 #include "cmMakefile.h"
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
@@ -34,6 +36,21 @@ cmFileInstaller::cmFileInstaller(cmExecutionStatus& status)
   // Get the current manifest.
   this->Manifest =
     this->Makefile->GetSafeDefinition("CMAKE_INSTALL_MANIFEST_FILES");
+  // Get the digests to compute while copying files, if any.
+  cmValue digestManifest =
+    this->Makefile->GetDefinition("CMAKE_INSTALL_DIGEST_MANIFEST");
+  if (cmNonempty(digestManifest) && cmFileDigestManifest::IsSupported()) {
+    cmList const algos{ this->Makefile->GetDefinition(
+      "CMAKE_INSTALL_DIGESTS") };
+    for (std::string const& algo : algos) {
+      if (std::unique_ptr<cmCryptoHash> hasher = cmCryptoHash::New(algo)) {
+        this->Hashers.emplace_back(algo, std::move(hasher));
+      }
+    }
+    if (!this->Hashers.empty()) {
+      this->DigestManifest = *digestManifest;
+    }
+  }
 }
 cmFileInstaller::~cmFileInstaller()
 {
@@ -87,7 +104,7 @@ bool cmFileInstaller::InstallFile(std::string const& fromFile,
                                   MatchProperties match_properties)
 {
   if (this->InstallMode == cmInstallMode::COPY) {
-    return this->cmFileCopier::InstallFile(fromFile, toFile, match_properties);
+    return this->InstallCopy(fromFile, toFile, match_properties);
   }
 
   std::string newFromFile;
@@ -111,8 +128,7 @@ bool cmFileInstaller::InstallFile(std::string const& fromFile,
       } else if (this->InstallMode == cmInstallMode::REL_SYMLINK_OR_COPY) {
         // User expects a relative symbolic link or a copy.
         // Since an absolute symlink won't do, copy instead.
-        return this->cmFileCopier::InstallFile(fromFile, toFile,
-                                               match_properties);
+        return this->InstallCopy(fromFile, toFile, match_properties);
       } else {
         // We cannot meet user's expectation (REL_SYMLINK)
         auto e = cmStrCat(this->Name,
@@ -154,8 +170,7 @@ bool cmFileInstaller::InstallFile(std::string const& fromFile,
           this->InstallMode == cmInstallMode::REL_SYMLINK_OR_COPY ||
           this->InstallMode == cmInstallMode::SYMLINK_OR_COPY) {
         // Failed to create a symbolic link, fall back to copying.
-        return this->cmFileCopier::InstallFile(newFromFile, toFile,
-                                               match_properties);
+        return this->InstallCopy(newFromFile, toFile, match_properties);
       }
 
       auto e = cmStrCat(this->Name, " cannot create symlink to \"",
@@ -169,6 +184,90 @@ bool cmFileInstaller::InstallFile(std::string const& fromFile,
   return true;
 }
 
+bool cmFileInstaller::InstallCopy(std::string const& fromFile,
+                                  std::string const& toFile,
+                                  MatchProperties match_properties)
+{
+  this->CopiedDigests.clear();
+  if (!this->cmFileCopier::InstallFile(fromFile, toFile, match_properties)) {
+    return false;
+  }
+  if (!this->CopiedDigests.empty()) {
+    // Record the digests after the times and permissions of the file
+    // have been set, so the recorded status is final.
+    if (!this->DigestStream.is_open()) {
+      this->DigestStream.open(this->DigestManifest.c_str(),
+                              std::ios::out | std::ios::app);
+    }
+    cmFileDigestManifest::Append(this->DigestStream, toFile,
+                                 this->CopiedDigests);
+    this->CopiedDigests.clear();
+  }
+  return true;
+}
+
+cmsys::SystemTools::CopyStatus cmFileInstaller::CopyFileContent(
+  std::string const& fromFile, std::string const& toFile)
+{
+  using CopyStatus = cmsys::SystemTools::CopyStatus;
+  if (this->Hashers.empty() || cmSystemTools::FileIsDirectory(fromFile) ||
+      cmSystemTools::FileIsDirectory(toFile) ||
+      cmSystemTools::SameFile(fromFile, toFile)) {
+    return this->cmFileCopier::CopyFileContent(fromFile, toFile);
+  }
+
+  // Hash the content while copying it so that packaging tools need not
+  // read the installed file again.  This gives up cloning the file on
+  // file systems that support it, but a clone would be read anyway.
+  cmsys::ifstream fin(fromFile.c_str(), std::ios::in | std::ios::binary);
+  if (!fin) {
+    return CopyStatus{ cmsys::Status::POSIX_errno(), CopyStatus::SourcePath };
+  }
+  std::string const toDir = cmSystemTools::GetFilenamePath(toFile);
+  if (!toDir.empty()) {
+    cmsys::Status status = cmSystemTools::MakeDirectory(toDir);
+    if (!status) {
+      return CopyStatus{ status, CopyStatus::DestPath };
+    }
+  }
+  // Remove the destination so that a read-only file can be replaced.
+  cmSystemTools::RemoveFile(toFile);
+  cmsys::ofstream fout(toFile.c_str(),
+                       std::ios::out | std::ios::trunc | std::ios::binary);
+  if (!fout) {
+    return CopyStatus{ cmsys::Status::POSIX_errno(), CopyStatus::DestPath };
+  }
+
+  for (auto const& hasher : this->Hashers) {
+    hasher.second->Initialize();
+  }
+  std::vector<char> buffer(64 * 1024);
+  while (fin) {
+    fin.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    std::streamsize const count = fin.gcount();
+    if (count == 0) {
+      break;
+    }
+    for (auto const& hasher : this->Hashers) {
+      hasher.second->Append(buffer.data(), static_cast<size_t>(count));
+    }
+    fout.write(buffer.data(), count);
+  }
+  if (!fin.eof()) {
+    return CopyStatus{ cmsys::Status::POSIX_errno(), CopyStatus::SourcePath };
+  }
+  fout.close();
+  if (!fout) {
+    return CopyStatus{ cmsys::Status::POSIX_errno(), CopyStatus::DestPath };
+  }
+
+  for (auto const& hasher : this->Hashers) {
+    this->CopiedDigests.emplace_back(hasher.first,
+                                     hasher.second->FinalizeHex());
+  }
+  return CopyStatus{ cmsys::Status::Success(), CopyStatus::NoPath };
+}
+
 void cmFileInstaller::DefaultFilePermissions()
 {
   this->cmFileCopier::DefaultFilePermissions();
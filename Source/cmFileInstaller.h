@@ -4,13 +4,20 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "cmsys/FStream.hxx"
+#include "cmsys/SystemTools.hxx"
+
 #include "cmFileCopier.h"
+#include "cmFileDigestManifest.h"
 #include "cmInstallMode.h"
 #include "cmInstallType.h"
 
+class cmCryptoHash;
 class cmExecutionStatus;
 
 struct cmFileInstaller : public cmFileCopier
@@ -31,6 +38,14 @@ protected:
   std::string Manifest;
   void ManifestAppend(std::string const& file);
 
+  // Digests computed while copying files, see cmFileDigestManifest.
+  std::vector<std::pair<std::string, std::unique_ptr<cmCryptoHash>>> Hashers;
+  std::string DigestManifest;
+  cmsys::ofstream DigestStream;
+  cmFileDigestManifest::Digests CopiedDigests;
+  bool InstallCopy(std::string const& fromFile, std::string const& toFile,
+                   MatchProperties match_properties);
+
   std::string const& ToName(std::string const& fromName) override;
 
   void ReportCopy(std::string const& toFile, Type type, bool copy) override;
@@ -39,6 +54,8 @@ protected:
                std::string const& toFile) override;
   bool InstallFile(std::string const& fromFile, std::string const& toFile,
                    MatchProperties match_properties) override;
+  cmsys::SystemTools::CopyStatus CopyFileContent(
+    std::string const& fromFile, std::string const& toFile) override;
   bool Parse(std::vector<std::string> const& args) override;
   enum
   {
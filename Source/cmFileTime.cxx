@@ -2,6 +2,8 @@
    file LICENSE.rst or https://cmake.org/licensing for details.  */
 #include "cmFileTime.h"
 
+#include <chrono>
+#include <ratio>
 #include <string>
 
 // Use a platform-specific API to get file times efficiently.
@@ -48,3 +50,19 @@ bool cmFileTime::Load(std::string const& fileName)
 #endif
   return true;
 }
+
+bool cmFileTime::IsRacy() const
+{
+  auto const now = std::chrono::system_clock::now().time_since_epoch();
+#if !defined(_WIN32) || defined(__CYGWIN__)
+  TimeType const nowTime =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+#else
+  // The file time counts 100ns intervals since 1601-01-01.
+  using FileTimeUnit = std::chrono::duration<TimeType, std::ratio<1, UtPerS>>;
+  TimeType const nowTime =
+    std::chrono::duration_cast<FileTimeUnit>(now).count() +
+    116444736000000000LL;
+#endif
+  return this->Time + 2 * UtPerS > nowTime;
+}
@@ -121,11 +121,23 @@ public:
     return 0;
   }
 
+  /**
+   * @brief Return true if this is so recent that the file may still be
+   *        modified without a visible change of its time.  This allows
+   *        for file systems that store times with two second resolution.
+   */
+  bool IsRacy() const;
+
   /**
    * @brief The file modification time in unit time per second
    */
   TimeType GetTime() const { return this->Time; }
 
+  /**
+   * @brief Sets the file modification time in unit time per second
+   */
+  void SetTime(TimeType time) { this->Time = time; }
+
 private:
   TimeType Time = 0;
 };
@@ -2,9 +2,105 @@
    file LICENSE.rst or https://cmake.org/licensing for details.  */
 #include "cmFileTimeCache.h"
 
+#include <algorithm>
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
+
+#include "cmSystemTools.h"
+
+#ifndef CMAKE_BOOTSTRAP
+#  include <cstddef>
+#  include <cstdint>
+#  include <ios>
+#  include <iterator>
+#  include <ostream>
+
+#  include <cm/memory>
+
+#  include "cmsys/FStream.hxx"
+
+#  include "cmFileLock.h"
+#  include "cmFileLockResult.h"
+#  include "cmStringAlgorithms.h"
+#endif
+
+struct cmFileTimeCache::SharedCache
+{
+  std::string File;
+  std::vector<std::string> PrivateDirectories;
+  unsigned long long Generation = 0;
+  std::unordered_map<std::string, cmFileTime> Entries;
+  std::vector<std::string> Pending;
+};
+
+#ifndef CMAKE_BOOTSTRAP
+namespace {
+// The shared cache file holds a header followed by appended records:
+//
+//   magic <generation>
+//   { <path length> <path> <time> }
+//
+// Integers are stored as little-endian values of 64 bits, except the path
+// length of 32 bits.  Accesses are serialized by locking a sibling file.
+char const SharedCacheMagic[] = { 'C', 'M', 'F', 'T', 'I', 'M', 'E', '1' };
+
+void WriteInteger(std::string& out, std::uint64_t value, int size)
+{
+  for (int i = 0; i < size; ++i) {
+    out += static_cast<char>(value & 0xff);
+    value >>= 8;
+  }
+}
+
+bool ReadInteger(char const*& cur, char const* end, std::uint64_t& value,
+                 int size)
+{
+  if (end - cur < size) {
+    return false;
+  }
+  value = 0;
+  for (int i = size - 1; i >= 0; --i) {
+    value = (value << 8) | static_cast<unsigned char>(cur[i]);
+  }
+  cur += size;
+  return true;
+}
+
+std::string ReadSharedCacheFile(std::string const& file)
+{
+  cmsys::ifstream fin(file.c_str(), std::ios::in | std::ios::binary);
+  if (!fin) {
+    return std::string();
+  }
+  return std::string{ std::istreambuf_iterator<char>(fin),
+                      std::istreambuf_iterator<char>() };
+}
+
+bool ReadSharedCacheHeader(char const*& cur, char const* end,
+                           std::uint64_t& generation)
+{
+  if (static_cast<std::size_t>(end - cur) < sizeof(SharedCacheMagic) ||
+      !std::equal(std::begin(SharedCacheMagic), std::end(SharedCacheMagic),
+                  cur)) {
+    return false;
+  }
+  cur += sizeof(SharedCacheMagic);
+  return ReadInteger(cur, end, generation, 8);
+}
+
+bool LockSharedCache(cmFileLock& lock, std::string const& file)
+{
+  std::string const lockFile = cmStrCat(file, ".lock");
+  if (!cmSystemTools::FileExists(lockFile) &&
+      !cmSystemTools::Touch(lockFile, true)) {
+    return false;
+  }
+  return lock.Lock(lockFile, static_cast<unsigned long>(-1)).IsOk();
+}
+}
+#endif
 
 cmFileTimeCache::cmFileTimeCache() = default;
 
@@ -17,20 +113,44 @@ bool cmFileTimeCache::Load(std::string const& fileName, cmFileTime& fileTime)
     auto fit = this->Cache.find(fileName);
     if (fit != this->Cache.end()) {
       fileTime = fit->second;
+      ++this->Counters.Hits;
+      return true;
+    }
+  }
+  // Use the time read by another process if available.
+  bool const shared = this->Shared &&
+    std::none_of(this->Shared->PrivateDirectories.begin(),
+                 this->Shared->PrivateDirectories.end(),
+                 [&fileName](std::string const& dir) {
+                   return cmSystemTools::IsSubDirectory(fileName, dir);
+                 });
+  if (shared) {
+    auto sit = this->Shared->Entries.find(fileName);
+    if (sit != this->Shared->Entries.end()) {
+      fileTime = sit->second;
+      this->Cache[fileName] = fileTime;
+      ++this->Counters.SharedHits;
       return true;
     }
   }
   // Read file time from OS
+  ++this->Counters.Stats;
   if (!fileTime.Load(fileName)) {
     return false;
   }
   // Store file time in cache
   this->Cache[fileName] = fileTime;
+  if (shared) {
+    this->Shared->Pending.push_back(fileName);
+  }
   return true;
 }
 
 bool cmFileTimeCache::Remove(std::string const& fileName)
 {
+  if (this->Shared) {
+    this->Shared->Entries.erase(fileName);
+  }
   return (this->Cache.erase(fileName) != 0);
 }
 
@@ -62,3 +182,115 @@ bool cmFileTimeCache::DifferS(std::string const& f1, std::string const& f2)
   // No comparison available.  Default to different times.
   return true;
 }
+
+void cmFileTimeCache::EnableSharedCache(
+  std::string const& cacheFile, std::vector<std::string> privateDirectories)
+{
+#ifndef CMAKE_BOOTSTRAP
+  this->Shared = cm::make_unique<SharedCache>();
+  this->Shared->File = cacheFile;
+  this->Shared->PrivateDirectories = std::move(privateDirectories);
+
+  std::string content;
+  {
+    cmFileLock lock;
+    if (!LockSharedCache(lock, cacheFile)) {
+      this->Shared.reset();
+      return;
+    }
+    content = ReadSharedCacheFile(cacheFile);
+  }
+
+  char const* cur = content.data();
+  char const* const end = cur + content.size();
+  std::uint64_t generation;
+  if (!ReadSharedCacheHeader(cur, end, generation)) {
+    // The first process of the build creates the cache.
+    return;
+  }
+  this->Shared->Generation = generation;
+  for (;;) {
+    std::uint64_t length;
+    std::uint64_t time;
+    if (!ReadInteger(cur, end, length, 4) ||
+        static_cast<std::uint64_t>(end - cur) < length) {
+      break;
+    }
+    std::string path(cur, static_cast<std::size_t>(length));
+    cur += length;
+    if (!ReadInteger(cur, end, time, 8)) {
+      break;
+    }
+    this->Shared->Entries[std::move(path)].SetTime(
+      static_cast<cmFileTime::TimeType>(time));
+  }
+#else
+  static_cast<void>(cacheFile);
+  static_cast<void>(privateDirectories);
+#endif
+}
+
+void cmFileTimeCache::WriteSharedCache()
+{
+#ifndef CMAKE_BOOTSTRAP
+  if (!this->Shared || this->Shared->Pending.empty()) {
+    return;
+  }
+
+  std::string records;
+  for (std::string const& path : this->Shared->Pending) {
+    WriteInteger(records, path.size(), 4);
+    records += path;
+    WriteInteger(
+      records, static_cast<std::uint64_t>(this->Cache[path].GetTime()), 8);
+  }
+  this->Shared->Pending.clear();
+
+  cmFileLock lock;
+  if (!LockSharedCache(lock, this->Shared->File)) {
+    return;
+  }
+  std::string const content = ReadSharedCacheFile(this->Shared->File);
+  char const* cur = content.data();
+  std::uint64_t generation;
+  if (!ReadSharedCacheHeader(cur, cur + content.size(), generation)) {
+    // Create the cache with the times read by this process.
+    generation = this->Shared->Generation;
+    std::string header(SharedCacheMagic, sizeof(SharedCacheMagic));
+    WriteInteger(header, generation, 8);
+    records.insert(0, header);
+    cmsys::ofstream fout(this->Shared->File.c_str(),
+                         std::ios::out | std::ios::binary);
+    fout.write(records.data(), records.size());
+  } else if (generation == this->Shared->Generation) {
+    cmsys::ofstream fout(this->Shared->File.c_str(),
+                         std::ios::out | std::ios::app | std::ios::binary);
+    fout.write(records.data(), records.size());
+  }
+  // Otherwise a new build started and the times read may be outdated.
+#endif
+}
+
+void cmFileTimeCache::ResetSharedCache(std::string const& cacheFile)
+{
+#ifndef CMAKE_BOOTSTRAP
+  if (!cmSystemTools::FileExists(cacheFile)) {
+    return;
+  }
+  cmFileLock lock;
+  if (!LockSharedCache(lock, cacheFile)) {
+    return;
+  }
+  std::string const content = ReadSharedCacheFile(cacheFile);
+  char const* cur = content.data();
+  std::uint64_t generation = 0;
+  ReadSharedCacheHeader(cur, cur + content.size(), generation);
+
+  std::string header(SharedCacheMagic, sizeof(SharedCacheMagic));
+  WriteInteger(header, generation + 1, 8);
+  cmsys::ofstream fout(cacheFile.c_str(), std::ios::out | std::ios::binary);
+  fout.write(header.data(), header.size());
+#else
+  static_cast<void>(cacheFile);
+#endif
+}
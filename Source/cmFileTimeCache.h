@@ -4,8 +4,10 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "cmFileTime.h" // IWYU pragma: keep
 
@@ -49,6 +51,47 @@ public:
    */
   bool DifferS(std::string const& f1, std::string const& f2);
 
+  /**
+   * @brief Consults a file time cache shared with concurrent processes for
+   *        the files outside of all the given private directories.
+   *
+   * Files that may change while a build runs, such as those of the source
+   * and build trees, must be in a private directory.  The shared cache is
+   * valid for one build only: ResetSharedCache() starts a new generation of
+   * it, discarding the previous file times.
+   */
+  void EnableSharedCache(std::string const& cacheFile,
+                         std::vector<std::string> privateDirectories);
+
+  bool HasSharedCache() const { return static_cast<bool>(this->Shared); }
+
+  /**
+   * @brief Appends the file times read from the file system since the
+   *        shared cache was enabled, unless it has been reset meanwhile.
+   */
+  void WriteSharedCache();
+
+  /**
+   * @brief Starts a new generation of a shared cache, if it exists.
+   */
+  static void ResetSharedCache(std::string const& cacheFile);
+
+  struct Statistics
+  {
+    /** Loads served by the cache of this process.  */
+    unsigned long long Hits = 0;
+    /** Loads served by the shared cache.  */
+    unsigned long long SharedHits = 0;
+    /** Loads which queried the file system.  */
+    unsigned long long Stats = 0;
+  };
+
+  Statistics const& GetStatistics() const { return this->Counters; }
+
 private:
+  struct SharedCache;
+
   std::unordered_map<std::string, cmFileTime> Cache;
+  std::unique_ptr<SharedCache> Shared;
+  Statistics Counters;
 };
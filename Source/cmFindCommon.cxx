@@ -4,11 +4,13 @@
 
 #include <algorithm>
 #include <array>
+#include <thread>
 #include <utility>
 
 #include <cmext/algorithm>
 
 #include "cmExecutionStatus.h"
+#include "cmGlobalGenerator.h"
 #include "cmList.h"
 #include "cmMakefile.h"
 #include "cmMessageType.h"
@@ -484,6 +486,41 @@ void cmFindCommon::ComputeFinalPaths(IgnorePaths ignorePaths,
                 });
 }
 
+unsigned int cmFindCommon::GetFindParallelLevel()
+{
+  cmValue level = this->Makefile->GetDefinition("CMAKE_FIND_PARALLEL_LEVEL");
+  if (!level) {
+    return 1;
+  }
+  unsigned long threads = 1;
+  if (!cmStrToULong(*level, &threads)) {
+    this->Makefile->IssueMessage(
+      MessageType::WARNING,
+      cmStrCat("CMAKE_FIND_PARALLEL_LEVEL is set to \"", *level,
+               "\", which is not a non-negative integer.  Ignoring."));
+    return 1;
+  }
+  if (threads == 0) {
+    threads = std::thread::hardware_concurrency();
+  }
+  return threads > 1 ? static_cast<unsigned int>(threads) : 1;
+}
+
+void cmFindCommon::PrefetchSearchPaths()
+{
+  unsigned int const threads = this->GetFindParallelLevel();
+  if (threads <= 1) {
+    return;
+  }
+  this->Makefile->GetGlobalGenerator()->PrefetchDirectoryContent(
+    this->SearchPaths, threads);
+}
+
+void cmFindCommon::DropPrefetchedSearchPaths()
+{
+  this->Makefile->GetGlobalGenerator()->DropPrefetchedDirectoryContent();
+}
+
 cmFindCommonDebugState::cmFindCommonDebugState(std::string name,
                                                cmFindCommon const* findCommand)
   : FindCommand(findCommand)
@@ -111,6 +111,15 @@ protected:
   void ComputeFinalPaths(IgnorePaths ignorePaths,
                          std::string* debugBuffer = nullptr);
 
+  /** Get the number of threads CMAKE_FIND_PARALLEL_LEVEL requests for
+      loading search directories ahead of time, or 1 if none.  */
+  unsigned int GetFindParallelLevel();
+
+  /** Load the content of the final search paths from disk concurrently
+      if CMAKE_FIND_PARALLEL_LEVEL requests it.  */
+  void PrefetchSearchPaths();
+  void DropPrefetchedSearchPaths();
+
   /** Compute the current default root path mode.  */
   void SelectDefaultRootPathMode();
 
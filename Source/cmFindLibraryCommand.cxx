@@ -534,10 +534,12 @@ bool cmFindLibraryHelper::CheckDirectoryForName(std::string const& path,
 
 std::string cmFindLibraryCommand::FindNormalLibrary()
 {
-  if (this->NamesPerDir) {
-    return this->FindNormalLibraryNamesPerDir();
-  }
-  return this->FindNormalLibraryDirsPerName();
+  this->PrefetchSearchPaths();
+  std::string library = this->NamesPerDir
+    ? this->FindNormalLibraryNamesPerDir()
+    : this->FindNormalLibraryDirsPerName();
+  this->DropPrefetchedSearchPaths();
+  return library;
 }
 
 std::string cmFindLibraryCommand::FindNormalLibraryNamesPerDir()
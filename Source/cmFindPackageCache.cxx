@@ -0,0 +1,279 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#include "cmFindPackageCache.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <utility>
+
+#include "cmsys/FStream.hxx"
+
+#include "cmGeneratedFileStream.h"
+#include "cmSystemTools.h"
+
+namespace {
+
+// Bump this when the layout of the cache file changes.
+std::uint32_t const FindPackageCacheVersion = 1;
+char const FindPackageCacheMagic[4] = { 'F', 'P', 'C', '\0' };
+
+void WriteU64(std::ostream& os, std::uint64_t value)
+{
+  unsigned char buf[8];
+  for (unsigned char& b : buf) {
+    b = static_cast<unsigned char>(value & 0xff);
+    value >>= 8;
+  }
+  os.write(reinterpret_cast<char const*>(buf), sizeof(buf));
+}
+
+void WriteString(std::ostream& os, std::string const& str)
+{
+  WriteU64(os, str.size());
+  os.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+bool ReadU64(std::istream& is, std::uint64_t& value)
+{
+  unsigned char buf[8];
+  if (!is.read(reinterpret_cast<char*>(buf), sizeof(buf))) {
+    return false;
+  }
+  value = 0;
+  for (int i = 7; i >= 0; --i) {
+    value = (value << 8) | buf[i];
+  }
+  return true;
+}
+
+bool ReadString(std::istream& is, std::string& str)
+{
+  std::uint64_t size;
+  if (!ReadU64(is, size) || size > (std::uint64_t(1) << 32)) {
+    return false;
+  }
+  str.resize(static_cast<std::size_t>(size));
+  return size == 0 ||
+    static_cast<bool>(is.read(&str[0], static_cast<std::streamsize>(size)));
+}
+
+} // anonymous namespace
+
+cmFindPackageCache::cmFindPackageCache(std::string cacheFile)
+  : CacheFile(std::move(cacheFile))
+{
+}
+
+void cmFindPackageCache::Load()
+{
+  cmsys::ifstream fin(this->CacheFile.c_str(),
+                      std::ios::in | std::ios::binary);
+  if (!fin) {
+    return;
+  }
+
+  char magic[sizeof(FindPackageCacheMagic)];
+  std::uint64_t version;
+  std::uint64_t entryCount;
+  if (!fin.read(magic, sizeof(magic)) ||
+      !std::equal(magic, magic + sizeof(magic), FindPackageCacheMagic) ||
+      !ReadU64(fin, version) || version != FindPackageCacheVersion ||
+      !ReadU64(fin, entryCount)) {
+    return;
+  }
+
+  for (std::uint64_t i = 0; i < entryCount; ++i) {
+    std::string key;
+    Entry entry;
+    std::uint64_t count;
+    if (!ReadString(fin, key) || !ReadU64(fin, count)) {
+      // Discard a truncated or corrupt cache entirely.
+      this->Entries.clear();
+      return;
+    }
+    for (std::uint64_t j = 0; j < count; ++j) {
+      Dependency dep;
+      std::uint64_t time;
+      if (!ReadString(fin, dep.Directory) || !ReadU64(fin, time)) {
+        this->Entries.clear();
+        return;
+      }
+      dep.Time = static_cast<long long>(time);
+      entry.Dependencies.emplace_back(std::move(dep));
+    }
+    if (!ReadU64(fin, count)) {
+      this->Entries.clear();
+      return;
+    }
+    for (std::uint64_t j = 0; j < count; ++j) {
+      Candidate candidate;
+      std::uint64_t mode;
+      std::uint64_t reason;
+      if (!ReadString(fin, candidate.Path) || !ReadU64(fin, mode) ||
+          !ReadU64(fin, reason)) {
+        this->Entries.clear();
+        return;
+      }
+      candidate.Mode = static_cast<unsigned int>(mode);
+      candidate.Reason = static_cast<unsigned int>(reason);
+      entry.Candidates.emplace_back(std::move(candidate));
+    }
+    this->Entries.emplace(std::move(key), std::move(entry));
+  }
+}
+
+bool cmFindPackageCache::Save()
+{
+  bool unused = false;
+  for (auto const& e : this->Entries) {
+    if (!e.second.Used) {
+      unused = true;
+      break;
+    }
+  }
+  if (!this->Modified && !unused) {
+    return true;
+  }
+
+  cmGeneratedFileStream fout;
+  fout.Open(this->CacheFile, true, true);
+  if (!fout) {
+    return false;
+  }
+
+  std::uint64_t entryCount = 0;
+  for (auto const& e : this->Entries) {
+    if (e.second.Used) {
+      ++entryCount;
+    }
+  }
+
+  fout.write(FindPackageCacheMagic, sizeof(FindPackageCacheMagic));
+  WriteU64(fout, FindPackageCacheVersion);
+  WriteU64(fout, entryCount);
+  for (auto const& e : this->Entries) {
+    Entry const& entry = e.second;
+    if (!entry.Used) {
+      continue;
+    }
+    WriteString(fout, e.first);
+    WriteU64(fout, entry.Dependencies.size());
+    for (Dependency const& dep : entry.Dependencies) {
+      WriteString(fout, dep.Directory);
+      WriteU64(fout, static_cast<std::uint64_t>(dep.Time));
+    }
+    WriteU64(fout, entry.Candidates.size());
+    for (Candidate const& candidate : entry.Candidates) {
+      WriteString(fout, candidate.Path);
+      WriteU64(fout, candidate.Mode);
+      WriteU64(fout, candidate.Reason);
+    }
+  }
+  if (!fout.Close()) {
+    return false;
+  }
+  this->Modified = false;
+  return true;
+}
+
+bool cmFindPackageCache::LookupMissing(std::string const& key,
+                                       std::vector<Candidate>& candidates)
+{
+  // Take the start time before the first search of this run looks at
+  // any directory.
+  this->LoadStartTime();
+
+  auto it = this->Entries.find(key);
+  if (it == this->Entries.end()) {
+    ++this->Misses;
+    return false;
+  }
+  if (!this->IsCurrent(it->second)) {
+    this->Entries.erase(it);
+    this->Modified = true;
+    ++this->Misses;
+    return false;
+  }
+
+  it->second.Used = true;
+  candidates = it->second.Candidates;
+  ++this->Hits;
+  return true;
+}
+
+void cmFindPackageCache::StoreMissing(std::string const& key,
+                                      std::set<std::string> const& probedPaths,
+                                      std::vector<Candidate> candidates)
+{
+  this->LoadStartTime();
+  if (!this->StartTimeValid) {
+    return;
+  }
+
+  // A path that does not exist depends on the closest existing directory
+  // above it, whose modification time changes when the path is created.
+  std::map<std::string, long long> dependencies;
+  std::set<std::string> visited;
+  for (std::string path : probedPaths) {
+    while (path.size() > 1 && path.back() == '/') {
+      path.pop_back();
+    }
+    while (visited.insert(path).second) {
+      cmFileTime time;
+      if (cmSystemTools::FileIsDirectory(path) && time.Load(path)) {
+        // The result is exact only if the directory was not modified
+        // since the start time.  Otherwise, a modification made after the
+        // search looked at the directory may have kept its time.
+        if (!time.OlderS(this->StartTime)) {
+          return;
+        }
+        dependencies.emplace(path, time.GetTime());
+        break;
+      }
+      std::string parent = cmSystemTools::GetParentDirectory(path);
+      if (parent.empty() || parent == path) {
+        return;
+      }
+      path = std::move(parent);
+    }
+  }
+
+  Entry entry;
+  for (auto& dep : dependencies) {
+    Dependency d;
+    d.Directory = dep.first;
+    d.Time = dep.second;
+    entry.Dependencies.emplace_back(std::move(d));
+  }
+  entry.Candidates = std::move(candidates);
+  entry.Used = true;
+  this->Entries[key] = std::move(entry);
+  this->Modified = true;
+}
+
+bool cmFindPackageCache::IsCurrent(Entry const& entry) const
+{
+  return std::all_of(entry.Dependencies.begin(), entry.Dependencies.end(),
+                     [](Dependency const& dep) -> bool {
+                       cmFileTime time;
+                       return time.Load(dep.Directory) &&
+                         time.GetTime() == dep.Time;
+                     });
+}
+
+void cmFindPackageCache::LoadStartTime()
+{
+  if (this->StartTimeLoaded) {
+    return;
+  }
+  this->StartTimeLoaded = true;
+
+  // Touch the cache file to read the current time of the file system.
+  this->StartTimeValid =
+    cmSystemTools::Touch(this->CacheFile, true) &&
+    this->StartTime.Load(this->CacheFile);
+}
@@ -0,0 +1,85 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#pragma once
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "cmFileTime.h"
+
+/** \class cmFindPackageCache
+ * \brief Remember the search prefixes in which find_package found nothing.
+ *
+ * find_package probes dozens of directories below every search prefix
+ * for the configuration file of a package.  When a prefix does not
+ * provide the package, the cache records the directories the search
+ * depended on together with their modification times, and the candidate
+ * paths it considered.  A later search of the same prefix with the same
+ * search options reuses the result while none of the directories changed.
+ * The cache is stored in a binary file in the build tree.
+ */
+class cmFindPackageCache
+{
+public:
+  /** A path considered by a search, in terms of cmFindPackageCommand.  */
+  struct Candidate
+  {
+    std::string Path;
+    unsigned int Mode = 0;
+    unsigned int Reason = 0;
+  };
+
+  cmFindPackageCache(std::string cacheFile);
+
+  /** Load entries from the cache file.  A missing or unreadable cache file
+      is not an error; the cache simply starts empty.  */
+  void Load();
+
+  /** Save the entries looked up or stored during this run.  */
+  bool Save();
+
+  /** Get the candidates considered by a search that found nothing, if the
+      search identified by the given key is cached and current.  */
+  bool LookupMissing(std::string const& key,
+                     std::vector<Candidate>& candidates);
+
+  /** Store the result of a search that found nothing.  The probed paths
+      are the directories whose entries the search looked at, whether or
+      not they exist.  */
+  void StoreMissing(std::string const& key,
+                    std::set<std::string> const& probedPaths,
+                    std::vector<Candidate> candidates);
+
+  unsigned long GetHits() const { return this->Hits; }
+  unsigned long GetMisses() const { return this->Misses; }
+
+private:
+  struct Dependency
+  {
+    std::string Directory;
+    long long Time = 0;
+  };
+  struct Entry
+  {
+    std::vector<Dependency> Dependencies;
+    std::vector<Candidate> Candidates;
+    bool Used = false;
+  };
+
+  bool IsCurrent(Entry const& entry) const;
+  void LoadStartTime();
+
+  std::string CacheFile;
+  std::unordered_map<std::string, Entry> Entries;
+  // A time of the file system taken before the first search of this run.
+  cmFileTime StartTime;
+  bool StartTimeLoaded = false;
+  bool StartTimeValid = false;
+  unsigned long Hits = 0;
+  unsigned long Misses = 0;
+  bool Modified = false;
+};
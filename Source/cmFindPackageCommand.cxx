@@ -25,10 +25,13 @@
 
 #include "cmAlgorithms.h"
 #include "cmConfigureLog.h"
+#include "cmCryptoHash.h"
 #include "cmDependencyProvider.h"
 #include "cmExecutionStatus.h"
 #include "cmExperimental.h"
+#include "cmFindPackageCache.h"
 #include "cmFindPackageStack.h"
+#include "cmGlobalGenerator.h"
 #include "cmList.h"
 #include "cmListFileCache.h"
 #include "cmMakefile.h"
@@ -45,6 +48,7 @@
 #include "cmValue.h"
 #include "cmVersion.h"
 #include "cmWindowsRegistry.h"
+#include "cmake.h"
 
 #if defined(__HAIKU__)
 #  include <FindDirectory.h>
@@ -391,6 +395,47 @@ void ResetGenerator(Generator&& generator, Generators&&... generators)
   ResetGenerator(std::forward<Generators&&>(generators)...);
 }
 
+class cmRecordingSearchFn
+{
+public:
+  using SearchFn = std::function<bool(std::string const&, pdt)>;
+
+  cmRecordingSearchFn(SearchFn search, std::set<std::string>* probedPaths)
+    : Search{ std::move(search) }
+    , ProbedPaths{ probedPaths }
+  {
+  }
+
+  bool operator()(std::string const& fullPath, pdt type) const
+  {
+    return this->Search(fullPath, type);
+  }
+
+  void Probe(std::string const& path) const
+  {
+    if (this->ProbedPaths) {
+      this->ProbedPaths->insert(path);
+    }
+  }
+
+private:
+  SearchFn Search;
+  std::set<std::string>* ProbedPaths;
+};
+
+template <typename CallbackFn>
+void ProbeGeneratorPath(CallbackFn const& /*unused*/,
+                        std::string const& /*unused*/)
+{
+}
+
+// Record the directories whose entries a generator looks at.
+void ProbeGeneratorPath(cmRecordingSearchFn const& filesCollector,
+                        std::string const& path)
+{
+  filesCollector.Probe(path);
+}
+
 template <typename CallbackFn>
 bool TryGeneratedPaths(CallbackFn&& filesCollector,
                        cmFindPackageCommand::PackageDescriptionType type,
@@ -406,6 +451,7 @@ bool TryGeneratedPaths(CallbackFn&& filesCollector,
                        std::string const& startPath, Generator&& gen,
                        Rest&&... tail)
 {
+  ProbeGeneratorPath(filesCollector, startPath);
   ResetGenerator(std::forward<Generator&&>(gen));
   for (auto path = gen.GetNextCandidate(startPath); !path.empty();
        path = gen.GetNextCandidate(startPath)) {
@@ -2002,9 +2048,83 @@ void cmFindPackageCommand::SetConfigDirCacheVariable(std::string const& value)
 bool cmFindPackageCommand::FindPrefixedConfig()
 {
   std::vector<std::string> const& prefixes = this->SearchPaths;
-  return std::any_of(
+
+  // Every prefix is still probed by SearchPrefix so that the considered
+  // paths and debug output do not depend on the prefetch.
+  this->PrefetchConfigDirectories();
+  bool const found = std::any_of(
     prefixes.begin(), prefixes.end(),
     [this](std::string const& p) -> bool { return this->SearchPrefix(p); });
+  this->DropPrefetchedSearchPaths();
+  return found;
+}
+
+void cmFindPackageCommand::PrefetchConfigDirectories()
+{
+  unsigned int const threads = this->GetFindParallelLevel();
+  if (threads <= 1) {
+    return;
+  }
+  cmGlobalGenerator* gg = this->Makefile->GetGlobalGenerator();
+
+  // Load the prefixes, and the directories below them that the search
+  // may look into, one level at a time.  FindConfigFile then checks
+  // only for the configuration files that the listings contain.
+  std::vector<std::string> level;
+  for (std::string const& prefix : this->SearchPaths) {
+    if (prefix.size() > 1) {
+      level.emplace_back(prefix, 0, prefix.size() - 1);
+    }
+  }
+  // The deepest locations are PREFIX/(Foo|foo|FOO).*/lib/cmake/Foo*/.
+  int const maxDepth = 4;
+  std::vector<std::string> dirs;
+  for (int depth = 0; !level.empty(); ++depth) {
+    dirs.clear();
+    for (std::string const& dir : level) {
+      for (std::string const& suffix : this->SearchPathSuffixes) {
+        dirs.emplace_back(suffix.empty() ? dir
+                                         : cmStrCat(dir, '/', suffix));
+      }
+    }
+    gg->PrefetchDirectoryContent(dirs, threads);
+    if (depth == maxDepth) {
+      break;
+    }
+
+    std::vector<std::string> next;
+    for (std::string const& dir : level) {
+      std::set<std::string> const* content =
+        gg->GetPrefetchedDirectoryContent(dir);
+      if (!content) {
+        continue;
+      }
+      for (std::string const& name : *content) {
+        if (this->IsConfigDirectoryName(name)) {
+          next.emplace_back(cmStrCat(dir, '/', name));
+        }
+      }
+    }
+    level = std::move(next);
+  }
+}
+
+bool cmFindPackageCommand::IsConfigDirectoryName(
+  std::string const& name) const
+{
+  // Match the names the directory list generators of
+  // SearchPrefixDirectories look for.
+  if (cmsysString_strcasecmp(name.c_str(), "cmake") == 0 ||
+      cmsysString_strcasecmp(name.c_str(), "cps") == 0 || name == "lib" ||
+      name == "lib32" || name == "lib64" || name == "libx32" ||
+      name == "share" || name == this->LibraryArchitecture) {
+    return true;
+  }
+  return std::any_of(this->Names.begin(), this->Names.end(),
+                     [&name](std::string const& n) -> bool {
+                       return cmsysString_strncasecmp(name.c_str(), n.c_str(),
+                                                      n.size()) == 0;
+                     });
 }
 
 bool cmFindPackageCommand::FindFrameworkConfig()
@@ -2873,6 +2993,9 @@ bool cmFindPackageCommand::SearchDirectory(std::string const& dir,
       d += s;
       d += '/';
     }
+    if (this->ProbedPaths) {
+      this->ProbedPaths->insert(d);
+    }
     if (this->CheckDirectory(d, type)) {
       return true;
     }
@@ -2908,6 +3031,21 @@ bool cmFindPackageCommand::FindConfigFile(std::string const& dir,
                                           std::string& file,
                                           FoundPackageMode& foundMode)
 {
+  // A prefetched listing of the directory tells which files cannot
+  // exist.  Compare names case-insensitively, as the file system may.
+  std::set<std::string> const* content =
+    this->Makefile->GetGlobalGenerator()->GetPrefetchedDirectoryContent(dir);
+  auto listed = [content](std::string const& name) -> bool {
+    if (!content) {
+      return true;
+    }
+    return std::any_of(content->begin(), content->end(),
+                       [&name](std::string const& f) -> bool {
+                         return cmsysString_strcasecmp(
+                                  f.c_str(), name.c_str()) == 0;
+                       });
+  };
+
   for (auto const& config : this->Configs) {
     if (type != pdt::Any && config.Type != type) {
       continue;
@@ -2916,7 +3054,7 @@ bool cmFindPackageCommand::FindConfigFile(std::string const& dir,
     if (this->DebugModeEnabled()) {
       this->DebugBuffer = cmStrCat(this->DebugBuffer, "  ", file, '\n');
     }
-    if (cmSystemTools::FileExists(file, true)) {
+    if (listed(config.Name) && cmSystemTools::FileExists(file, true)) {
       if (this->CheckVersion(file)) {
         // Allow resolving symlinks when the config file is found through a
         // link
@@ -3247,9 +3385,91 @@ bool cmFindPackageCommand::SearchPrefix(std::string const& prefix)
     return false;
   }
 
-  auto searchFn = [this](std::string const& fullPath,
-                         PackageDescriptionType type) -> bool {
-    return this->SearchDirectory(fullPath, type);
+  // The search debug output lists every path probed, so do not skip it.
+  cmFindPackageCache* cache = this->DebugModeEnabled()
+    ? nullptr
+    : this->Makefile->GetCMakeInstance()->GetFindPackageCache();
+  if (!cache) {
+    return this->SearchPrefixDirectories(prefix);
+  }
+
+  std::string const key =
+    cmStrCat(prefix, '\n', this->GetPrefixCacheSignature());
+  std::vector<cmFindPackageCache::Candidate> candidates;
+  if (cache->LookupMissing(key, candidates)) {
+    for (cmFindPackageCache::Candidate& candidate : candidates) {
+      this->ConsideredPaths.emplace_back(
+        std::move(candidate.Path),
+        static_cast<FoundPackageMode>(candidate.Mode),
+        static_cast<SearchResult>(candidate.Reason));
+    }
+    return false;
+  }
+
+  std::set<std::string> probedPaths;
+  std::size_t const consideredBefore = this->ConsideredPaths.size();
+  this->ProbedPaths = &probedPaths;
+  bool const found = this->SearchPrefixDirectories(prefix);
+  this->ProbedPaths = nullptr;
+  if (found) {
+    return true;
+  }
+
+  // A search that found a configuration file of an unsuitable version
+  // depends on the content of the file, so cache only searches that found
+  // no file at all.
+  for (std::size_t i = consideredBefore; i < this->ConsideredPaths.size();
+       ++i) {
+    ConsideredPath const& considered = this->ConsideredPaths[i];
+    if (considered.Reason != SearchResult::NoExist &&
+        considered.Reason != SearchResult::Ignored) {
+      return false;
+    }
+    cmFindPackageCache::Candidate candidate;
+    candidate.Path = considered.Path;
+    candidate.Mode = static_cast<unsigned int>(considered.Mode);
+    candidate.Reason = static_cast<unsigned int>(considered.Reason);
+    candidates.emplace_back(std::move(candidate));
+  }
+  cache->StoreMissing(key, probedPaths, std::move(candidates));
+  return false;
+}
+
+std::string const& cmFindPackageCommand::GetPrefixCacheSignature()
+{
+  if (this->PrefixCacheSignature.empty()) {
+    // Everything but the prefix that selects the paths a search probes.
+    std::string signature;
+    for (std::string const& name : this->Names) {
+      signature += cmStrCat("name:", name, '\n');
+    }
+    for (ConfigName const& config : this->Configs) {
+      signature += cmStrCat("config:", static_cast<int>(config.Type), ':',
+                            config.Name, '\n');
+    }
+    for (std::string const& suffix : this->SearchPathSuffixes) {
+      signature += cmStrCat("suffix:", suffix, '\n');
+    }
+    for (std::string const& ignored : this->IgnoredPaths) {
+      signature += cmStrCat("ignore:", ignored, '\n');
+    }
+    signature += cmStrCat("arch:", this->LibraryArchitecture, '\n',
+                          "lib32:", this->UseLib32Paths ? '1' : '0', '\n',
+                          "lib64:", this->UseLib64Paths ? '1' : '0', '\n',
+                          "libx32:", this->UseLibx32Paths ? '1' : '0', '\n');
+    cmCryptoHash hasher(cmCryptoHash::AlgoSHA256);
+    this->PrefixCacheSignature = hasher.HashString(signature);
+  }
+  return this->PrefixCacheSignature;
+}
+
+bool cmFindPackageCommand::SearchPrefixDirectories(std::string const& prefix)
+{
+  auto searchFn = cmRecordingSearchFn{
+    [this](std::string const& fullPath, PackageDescriptionType type) -> bool {
+      return this->SearchDirectory(fullPath, type);
+    },
+    this->ProbedPaths
   };
 
   auto iCpsGen = cmCaseInsensitiveDirectoryListGenerator{ "cps"_s };
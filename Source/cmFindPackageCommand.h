@@ -138,6 +138,8 @@ private:
 
   bool FindConfig();
   bool FindPrefixedConfig();
+  void PrefetchConfigDirectories();
+  bool IsConfigDirectoryName(std::string const& name) const;
   bool FindFrameworkConfig();
   bool FindAppBundleConfig();
   bool FindEnvironmentConfig();
@@ -216,6 +218,8 @@ private:
   bool CheckVersionFile(std::string const& version_file,
                         std::string& result_version);
   bool SearchPrefix(std::string const& prefix);
+  bool SearchPrefixDirectories(std::string const& prefix);
+  std::string const& GetPrefixCacheSignature();
   bool SearchFrameworkPrefix(std::string const& prefix);
   bool SearchAppBundlePrefix(std::string const& prefix);
   bool SearchEnvironmentPrefix(std::string const& prefix);
@@ -314,6 +318,10 @@ private:
   };
   std::vector<ConsideredPath> ConsideredPaths;
 
+  // The paths probed by the search of a prefix, if recorded.
+  std::set<std::string>* ProbedPaths = nullptr;
+  std::string PrefixCacheSignature;
+
   static FoundPackageMode FoundMode(PackageDescriptionType type);
 
   struct ConfigName
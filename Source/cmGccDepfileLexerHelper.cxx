@@ -3,41 +3,54 @@
 #include "cmGccDepfileLexerHelper.h"
 
 #include <algorithm>
-#include <cstdio>
+#include <cstddef>
+#include <ios>
 #include <string>
 #include <vector>
 
+#include "cmsys/FStream.hxx"
+
 #include "cmGccDepfileReaderTypes.h"
 
 #include "LexerParser/cmGccDepfileLexer.h"
 
 #ifdef _WIN32
 #  include <cctype>
-
-#  include "cmsys/Encoding.h"
 #endif
 
 bool cmGccDepfileLexerHelper::readFile(char const* filePath)
 {
-#ifdef _WIN32
-  wchar_t* wpath = cmsysEncoding_DupToWide(filePath);
-  FILE* file = _wfopen(wpath, L"rb");
-  free(wpath);
-#else
-  FILE* file = fopen(filePath, "r");
-#endif
-  if (!file) {
-    return false;
+  // Read the whole file at once so that the lexer scans it in place
+  // instead of copying it through its own input buffer.
+  std::vector<char> buffer;
+  {
+    cmsys::ifstream fin(filePath, std::ios::in | std::ios::binary);
+    if (!fin) {
+      return false;
+    }
+    fin.seekg(0, std::ios::end);
+    std::streamoff const size = fin.tellg();
+    if (size < 0) {
+      return false;
+    }
+    fin.seekg(0, std::ios::beg);
+    buffer.resize(static_cast<std::size_t>(size));
+    if (!fin.read(buffer.data(), size)) {
+      return false;
+    }
   }
+  // The lexer requires the buffer to end in two null characters.
+  buffer.push_back('\0');
+  buffer.push_back('\0');
+
   this->newEntry();
   yyscan_t scanner;
   cmGccDepfile_yylex_init(&scanner);
   cmGccDepfile_yyset_extra(this, scanner);
-  cmGccDepfile_yyrestart(file, scanner);
+  cmGccDepfile_yy_scan_buffer(buffer.data(), buffer.size(), scanner);
   cmGccDepfile_yylex(scanner);
   cmGccDepfile_yylex_destroy(scanner);
   this->sanitizeContent();
-  fclose(file);
   return this->HelperState != State::Failed;
 }
 
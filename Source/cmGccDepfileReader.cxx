@@ -12,9 +12,34 @@
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
 
+namespace {
+void NormalizeDepfilePath(std::string& path)
+{
+  if (cmSystemTools::FileIsFullPath(path)) {
+    path = cmSystemTools::CollapseFullPath(path);
+  }
+  cmSystemTools::ConvertToLongPath(path);
+}
+
+void NormalizeDepfilePath(std::string& path, cmGccDepfilePathTable* pathTable)
+{
+  if (!pathTable) {
+    NormalizeDepfilePath(path);
+    return;
+  }
+  auto it = pathTable->find(path);
+  if (it == pathTable->end()) {
+    std::string normalized = path;
+    NormalizeDepfilePath(normalized);
+    it = pathTable->emplace(std::move(path), std::move(normalized)).first;
+  }
+  path = it->second;
+}
+}
+
 cm::optional<cmGccDepfileContent> cmReadGccDepfile(
   char const* filePath, std::string const& prefix,
-  GccDepfilePrependPaths prependPaths)
+  GccDepfilePrependPaths prependPaths, cmGccDepfilePathTable* pathTable)
 {
   cmGccDepfileLexerHelper helper;
   if (!helper.readFile(filePath)) {
@@ -28,19 +53,13 @@ cm::optional<cmGccDepfileContent> cmReadGccDepfile(
           !cmSystemTools::FileIsFullPath(rule)) {
         rule = cmStrCat(prefix, '/', rule);
       }
-      if (cmSystemTools::FileIsFullPath(rule)) {
-        rule = cmSystemTools::CollapseFullPath(rule);
-      }
-      cmSystemTools::ConvertToLongPath(rule);
+      NormalizeDepfilePath(rule, pathTable);
     }
     for (auto& path : dep.paths) {
       if (!prefix.empty() && !cmSystemTools::FileIsFullPath(path)) {
         path = cmStrCat(prefix, '/', path);
       }
-      if (cmSystemTools::FileIsFullPath(path)) {
-        path = cmSystemTools::CollapseFullPath(path);
-      }
-      cmSystemTools::ConvertToLongPath(path);
+      NormalizeDepfilePath(path, pathTable);
     }
   }
 
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 
 #include <cm/optional>
 
@@ -14,9 +15,17 @@ enum class GccDepfilePrependPaths
   Deps,
 };
 
+/*
+ * Normalized paths keyed by the paths read from dependencies files after
+ * prepending the prefix.  Share a table between the reading of many files
+ * to normalize each distinct path only once.
+ */
+using cmGccDepfilePathTable = std::unordered_map<std::string, std::string>;
+
 /*
  * Read dependencies file and prepend prefix to all relative paths
  */
 cm::optional<cmGccDepfileContent> cmReadGccDepfile(
   char const* filePath, std::string const& prefix = {},
-  GccDepfilePrependPaths prependPaths = GccDepfilePrependPaths::All);
+  GccDepfilePrependPaths prependPaths = GccDepfilePrependPaths::All,
+  cmGccDepfilePathTable* pathTable = nullptr);
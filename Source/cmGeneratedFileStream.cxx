@@ -2,8 +2,15 @@
    file LICENSE.rst or https://cmake.org/licensing for details.  */
 #include "cmGeneratedFileStream.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <locale>
+#include <utility>
+
+#if !defined(CMAKE_BOOTSTRAP)
+#  include <atomic>
+#  include <thread>
+#endif
 
 #include "cmStringAlgorithms.h"
 #include "cmSystemTools.h"
@@ -110,6 +117,11 @@ void cmGeneratedFileStream::SetCompressionExtraExtension(bool ext)
   this->CompressExtraExtension = ext;
 }
 
+void cmGeneratedFileStream::SetBatch(cmGeneratedFileStreamBatch* batch)
+{
+  this->Batch = batch;
+}
+
 cmGeneratedFileStreamBase::cmGeneratedFileStreamBase() = default;
 
 cmGeneratedFileStreamBase::cmGeneratedFileStreamBase(std::string const& name)
@@ -126,6 +138,7 @@ void cmGeneratedFileStreamBase::Open(std::string const& name)
 {
   // Save the original name of the file.
   this->Name = cmSystemTools::CollapseFullPath(name);
+  this->Deferred = false;
 
   // Create the name of the temporary file.
   this->TempName = this->Name;
@@ -159,6 +172,18 @@ bool cmGeneratedFileStreamBase::Close()
     resname += ".gz";
   }
 
+  // Let the batch replace the destination file later.  The content has
+  // been written completely, so report it as written.
+  if (this->Deferred) {
+    return true;
+  }
+  if (this->Batch && !this->Name.empty() && this->Okay && !this->Compress &&
+      !this->TempName.empty()) {
+    this->Batch->Defer(this->TempName, resname, this->CopyIfDifferent);
+    this->Deferred = true;
+    return true;
+  }
+
   // Only consider replacing the destination file if no error
   // occurred.
   if (!this->Name.empty() && this->Okay &&
@@ -230,6 +255,80 @@ int cmGeneratedFileStreamBase::RenameFile(std::string const& oldname,
   return cmSystemTools::RenameFile(oldname, newname);
 }
 
+cmGeneratedFileStreamBatch::~cmGeneratedFileStreamBatch()
+{
+  this->Commit();
+}
+
+void cmGeneratedFileStreamBatch::Defer(std::string const& tempName,
+                                       std::string const& name,
+                                       bool copyIfDifferent)
+{
+  auto i = this->Index.find(name);
+  if (i != this->Index.end()) {
+    // A later stream replaces the content of an earlier one.
+    Replacement& r = this->Replacements[i->second];
+    cmSystemTools::RemoveFile(r.TempName);
+    r.TempName = tempName;
+    r.CopyIfDifferent = r.CopyIfDifferent && copyIfDifferent;
+    return;
+  }
+  this->Index.emplace(name, this->Replacements.size());
+  this->Replacements.push_back({ tempName, name, copyIfDifferent });
+}
+
+std::size_t cmGeneratedFileStreamBatch::Commit(unsigned int threads)
+{
+  std::vector<Replacement> replacements = std::move(this->Replacements);
+  this->Replacements.clear();
+  this->Index.clear();
+
+  // Each worker records only the results of its own replacements.
+  std::vector<unsigned char> replaced(replacements.size(), 0);
+  auto replace = [&replacements, &replaced](std::size_t i) {
+    Replacement const& r = replacements[i];
+    if (!r.CopyIfDifferent || cmSystemTools::FilesDiffer(r.TempName, r.Name)) {
+      cmSystemTools::RenameFile(r.TempName, r.Name);
+      replaced[i] = 1;
+    }
+    cmSystemTools::RemoveFile(r.TempName);
+  };
+
+#if !defined(CMAKE_BOOTSTRAP)
+  if (threads > replacements.size()) {
+    threads = static_cast<unsigned int>(replacements.size());
+  }
+  if (threads > 1) {
+    // Each destination appears once, so replacements are independent.
+    std::atomic<std::size_t> next(0);
+    auto work = [&]() {
+      for (std::size_t i = next++; i < replacements.size(); i = next++) {
+        replace(i);
+      }
+    };
+    std::vector<std::thread> workers;
+    workers.reserve(threads - 1);
+    for (unsigned int i = 1; i < threads; ++i) {
+      workers.emplace_back(work);
+    }
+    work();
+    for (std::thread& worker : workers) {
+      worker.join();
+    }
+    return static_cast<std::size_t>(
+      std::count(replaced.begin(), replaced.end(), 1));
+  }
+#else
+  static_cast<void>(threads);
+#endif
+
+  for (std::size_t i = 0; i < replacements.size(); ++i) {
+    replace(i);
+  }
+  return static_cast<std::size_t>(
+    std::count(replaced.begin(), replaced.end(), 1));
+}
+
 void cmGeneratedFileStream::SetName(std::string const& fname)
 {
   this->Name = cmSystemTools::CollapseFullPath(fname);
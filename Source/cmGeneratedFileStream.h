@@ -4,10 +4,15 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <cstddef>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "cmsys/FStream.hxx"
 
+class cmGeneratedFileStreamBatch;
+
 #include "cm_codecvt_Encoding.hxx"
 
 // This is the first base class of cmGeneratedFileStream.  It will be
@@ -59,6 +64,12 @@ protected:
 
   // Whether the destination file is compressed
   bool CompressExtraExtension = true;
+
+  // The batch that replaces the destination file later, if any.
+  cmGeneratedFileStreamBatch* Batch = nullptr;
+
+  // Whether the temporary file was handed to the batch.
+  bool Deferred = false;
 };
 
 /** \class cmGeneratedFileStream
@@ -116,7 +127,9 @@ public:
    * Close the output file.  This should be used only with an open
    * stream.  The temporary file is atomically renamed to the
    * destination file if the stream is still valid when this method
-   * is called.
+   * is called.  Returns whether the destination file was written.  A
+   * replacement deferred to a batch counts as written because the
+   * complete content has been handed to the batch.
    */
   bool Close();
 
@@ -135,6 +148,13 @@ public:
    */
   void SetCompressionExtraExtension(bool ext);
 
+  /**
+   * Defer replacing the destination file to the given batch, if any.
+   * The file must not be read back before the batch is committed.
+   * Compressed files are always replaced when closed.
+   */
+  void SetBatch(cmGeneratedFileStreamBatch* batch);
+
   /**
    * Set name of the file that will hold the actual output. This method allows
    * the output file to be changed during the use of cmGeneratedFileStream.
@@ -158,3 +178,49 @@ public:
    */
   void WriteAltEncoding(std::string const& data, codecvt_Encoding encoding);
 };
+
+/** \class cmGeneratedFileStreamBatch
+ * \brief Defer replacement of generated files to a single commit.
+ *
+ * Closing a cmGeneratedFileStream associated with a batch by SetBatch
+ * leaves the complete temporary file in place and records it here instead
+ * of replacing the destination file immediately.  The recorded
+ * replacements, including the copy-if-different comparisons, are
+ * performed by Commit(), possibly on several threads.  The destructor
+ * commits any replacements still pending.
+ */
+class cmGeneratedFileStreamBatch
+{
+public:
+  cmGeneratedFileStreamBatch() = default;
+  ~cmGeneratedFileStreamBatch();
+
+  cmGeneratedFileStreamBatch(cmGeneratedFileStreamBatch const&) = delete;
+  cmGeneratedFileStreamBatch& operator=(cmGeneratedFileStreamBatch const&) =
+    delete;
+
+  /** Get the number of destination files waiting to be replaced.  */
+  std::size_t GetSize() const { return this->Replacements.size(); }
+
+  /**
+   * Replace all recorded destination files using up to the given number of
+   * threads.  Returns the number of files whose content changed.
+   */
+  std::size_t Commit(unsigned int threads = 1);
+
+private:
+  friend class cmGeneratedFileStreamBase;
+
+  struct Replacement
+  {
+    std::string TempName;
+    std::string Name;
+    bool CopyIfDifferent;
+  };
+
+  void Defer(std::string const& tempName, std::string const& name,
+             bool copyIfDifferent);
+
+  std::vector<Replacement> Replacements;
+  std::unordered_map<std::string, std::size_t> Index;
+};
@@ -41,18 +41,22 @@ cmGeneratorExpressionDAGChecker::cmGeneratorExpressionDAGChecker(
   }
 
   this->CheckResult = this->CheckGraph();
+  if (this->CheckResult != DAG) {
+    ++this->Top->Uncacheable;
+    return;
+  }
 
-  if (this->CheckResult == DAG && this->EvaluatingTransitiveProperty()) {
+  if (this->EvaluatingTransitiveProperty()) {
     auto const* top = this->Top;
-    auto it = top->Seen.find(this->Target);
-    if (it != top->Seen.end()) {
-      std::set<std::string> const& propSet = it->second;
-      if (propSet.find(this->Property) != propSet.end()) {
-        this->CheckResult = ALREADY_SEEN;
-        return;
-      }
+    auto& propMap = top->Seen[this->Target];
+    auto it = propMap.find(this->Property);
+    if (it != propMap.end()) {
+      top->AlreadySeenLog.push_back(it->second);
+      this->CheckResult = ALREADY_SEEN;
+      return;
     }
-    top->Seen[this->Target].insert(this->Property);
+    propMap.emplace(this->Property, top->SeenLog.size());
+    top->SeenLog.emplace_back(this->Target, this->Property);
   }
 }
 
@@ -227,3 +231,51 @@ cmGeneratorTarget const* cmGeneratorExpressionDAGChecker::TopTarget() const
 {
   return this->Top->Target;
 }
+
+cmGeneratorExpressionDAGChecker::SeenMark
+cmGeneratorExpressionDAGChecker::GetSeenMark() const
+{
+  auto const* top = this->Top;
+  return { top->SeenLog.size(), top->AlreadySeenLog.size(),
+           top->Uncacheable };
+}
+
+bool cmGeneratorExpressionDAGChecker::GetSeenSince(
+  SeenMark const& mark, std::vector<SeenProperty>& seen) const
+{
+  auto const* top = this->Top;
+  if (top->Uncacheable != mark.Uncacheable) {
+    return false;
+  }
+  for (std::size_t i = mark.AlreadySeen; i < top->AlreadySeenLog.size();
+       ++i) {
+    if (top->AlreadySeenLog[i] < mark.Seen) {
+      return false;
+    }
+  }
+  seen.assign(top->SeenLog.begin() + mark.Seen, top->SeenLog.end());
+  return true;
+}
+
+bool cmGeneratorExpressionDAGChecker::MarkSeen(
+  std::vector<SeenProperty> const& seen) const
+{
+  auto const* top = this->Top;
+  for (SeenProperty const& sp : seen) {
+    auto it = top->Seen.find(sp.first);
+    if (it != top->Seen.end() &&
+        it->second.find(sp.second) != it->second.end()) {
+      return false;
+    }
+  }
+  for (SeenProperty const& sp : seen) {
+    top->Seen[sp.first].emplace(sp.second, top->SeenLog.size());
+    top->SeenLog.push_back(sp);
+  }
+  return true;
+}
+
+void cmGeneratorExpressionDAGChecker::SetUncacheable() const
+{
+  ++this->Top->Uncacheable;
+}
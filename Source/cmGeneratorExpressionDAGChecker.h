@@ -4,9 +4,11 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <cstddef>
 #include <map>
-#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "cmListFileCache.h"
 
@@ -76,6 +78,34 @@ struct cmGeneratorExpressionDAGChecker
 
   cmGeneratorTarget const* TopTarget() const;
 
+  /** A (target, property) pair seen while evaluating a transitive
+      property.  */
+  using SeenProperty = std::pair<cmGeneratorTarget const*, std::string>;
+
+  /** Position in the evaluation of a transitive property after which
+      the seen properties may be collected by GetSeenSince.  */
+  struct SeenMark
+  {
+    std::size_t Seen;
+    std::size_t AlreadySeen;
+    std::size_t Uncacheable;
+  };
+  SeenMark GetSeenMark() const;
+
+  /** Collect the properties first seen since the given mark.  Returns
+      false if the evaluation since the mark depended on anything else,
+      such as a property seen before the mark, a dependency loop, or a
+      call to SetUncacheable.  */
+  bool GetSeenSince(SeenMark const& mark,
+                    std::vector<SeenProperty>& seen) const;
+
+  /** Mark the given properties as seen, as if they had been evaluated.
+      Returns false without marking anything if one was already seen.  */
+  bool MarkSeen(std::vector<SeenProperty> const& seen) const;
+
+  /** Record that the current evaluation depends on its context.  */
+  void SetUncacheable() const;
+
 private:
   Result CheckGraph() const;
 
@@ -83,7 +113,13 @@ private:
   cmGeneratorExpressionDAGChecker const* const Top;
   cmGeneratorTarget const* Target;
   std::string const Property;
-  mutable std::map<cmGeneratorTarget const*, std::set<std::string>> Seen;
+  // Index of each seen property in SeenLog.
+  mutable std::map<cmGeneratorTarget const*, std::map<std::string, std::size_t>>
+    Seen;
+  mutable std::vector<SeenProperty> SeenLog;
+  // Index in SeenLog of each property found to be already seen.
+  mutable std::vector<std::size_t> AlreadySeenLog;
+  mutable std::size_t Uncacheable = 0;
   GeneratorExpressionContent const* const Content;
   cmListFileBacktrace const Backtrace;
   Result CheckResult;
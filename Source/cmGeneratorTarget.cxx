@@ -21,6 +21,7 @@
 #include <cmext/string_view>
 
 #include "cmAlgorithms.h"
+#include "cmComputeLinkDepends.h"
 #include "cmComputeLinkInformation.h" // IWYU pragma: keep
 #include "cmCryptoHash.h"
 #include "cmCxxModuleUsageEffects.h"
@@ -548,12 +549,18 @@ void cmGeneratorTarget::ClearSourcesCache()
   this->LinkDirectoriesCache.clear();
   this->RuntimeBinaryFullNameCache.clear();
   this->ImportLibraryFullNameCache.clear();
+  ++this->GlobalGenerator->GetInterfacePropertyMemo().Epoch;
 }
 
 void cmGeneratorTarget::ClearLinkInterfaceCache()
 {
   this->LinkInterfaceMap.clear();
   this->LinkInterfaceUsageRequirementsOnlyMap.clear();
+  ++this->GlobalGenerator->GetInterfacePropertyMemo().Epoch;
+  if (cmComputeLinkDependsCache* linkDependsCache =
+        this->GlobalGenerator->GetLinkDependsCache()) {
+    linkDependsCache->Clear();
+  }
 }
 
 void cmGeneratorTarget::AddSourceCommon(std::string const& src, bool before)
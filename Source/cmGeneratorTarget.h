@@ -1319,6 +1319,18 @@ private:
                                   cmGeneratorExpressionContext* context,
                                   UseTo usage) const;
 
+  struct InterfacePropertyMemoEntry
+  {
+    unsigned long long Epoch = 0;
+    UseTo Usage = UseTo::Compile;
+    bool HadContextSensitiveCondition = false;
+    std::string Result;
+    // The transitive (target, property) pairs whose values are included.
+    std::vector<std::pair<cmGeneratorTarget const*, std::string>> Closure;
+  };
+  mutable std::unordered_map<std::string, InterfacePropertyMemoEntry>
+    InterfacePropertyMemo;
+
   using TargetPropertyEntryVector =
     std::vector<std::unique_ptr<TargetPropertyEntry>>;
 
@@ -19,6 +19,7 @@
 #include "cmGeneratorExpressionContext.h"
 #include "cmGeneratorExpressionDAGChecker.h"
 #include "cmGeneratorExpressionNode.h"
+#include "cmGlobalGenerator.h"
 #include "cmLinkItem.h"
 #include "cmList.h"
 #include "cmLocalGenerator.h"
@@ -133,16 +134,51 @@ std::string cmGeneratorTarget::EvaluateInterfaceProperty(
       break;
   }
 
+  // If no value in the transitive closure of this property contains a
+  // generator expression, the result does not depend on the consumer and
+  // a previous evaluation may be reused.  Its closure is marked as seen
+  // to deduplicate exactly as the evaluation itself would have done.
+  cmGlobalGenerator::InterfacePropertyMemo& memo =
+    this->GlobalGenerator->GetInterfacePropertyMemo();
+  bool const useMemo =
+    memo.Enabled && dagChecker.EvaluatingTransitiveProperty();
+  std::string memoKey;
+  if (useMemo) {
+    memoKey = cmStrCat(prop, '@', context->Config);
+    auto mi = this->InterfacePropertyMemo.find(memoKey);
+    if (mi != this->InterfacePropertyMemo.end() &&
+        mi->second.Epoch == memo.Epoch && mi->second.Usage == usage &&
+        dagChecker.MarkSeen(mi->second.Closure)) {
+      ++memo.Hits;
+      context->HadContextSensitiveCondition =
+        context->HadContextSensitiveCondition ||
+        mi->second.HadContextSensitiveCondition;
+      return mi->second.Result;
+    }
+    ++memo.Misses;
+  }
+  cmGeneratorExpressionDAGChecker::SeenMark const seenMark =
+    dagChecker.GetSeenMark();
+  bool const hadContextSensitiveCondition =
+    context->HadContextSensitiveCondition;
+  context->HadContextSensitiveCondition = false;
+
   cmGeneratorTarget const* headTarget =
     context->HeadTarget ? context->HeadTarget : this;
 
   if (cmValue p = this->GetProperty(prop)) {
+    if (cmGeneratorExpression::Find(*p) != std::string::npos) {
+      dagChecker.SetUncacheable();
+    }
     result = cmGeneratorExpressionNode::EvaluateDependentExpression(
       *p, context->LG, context, headTarget, &dagChecker, this);
   }
 
   if (cmLinkInterfaceLibraries const* iface =
         this->GetLinkInterfaceLibraries(context->Config, headTarget, usage)) {
+    if (iface->HadHeadSensitiveCondition) {
+      dagChecker.SetUncacheable();
+    }
     context->HadContextSensitiveCondition =
       context->HadContextSensitiveCondition ||
       iface->HadContextSensitiveCondition;
@@ -180,6 +216,20 @@ std::string cmGeneratorTarget::EvaluateInterfaceProperty(
     }
   }
 
+  if (useMemo) {
+    InterfacePropertyMemoEntry entry;
+    if (dagChecker.GetSeenSince(seenMark, entry.Closure)) {
+      entry.Epoch = memo.Epoch;
+      entry.Usage = usage;
+      entry.HadContextSensitiveCondition =
+        context->HadContextSensitiveCondition;
+      entry.Result = result;
+      this->InterfacePropertyMemo[memoKey] = std::move(entry);
+    }
+  }
+  context->HadContextSensitiveCondition =
+    context->HadContextSensitiveCondition || hadContextSensitiveCondition;
+
   return result;
 }
 
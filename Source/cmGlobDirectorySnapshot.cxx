@@ -0,0 +1,347 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#include "cmGlobDirectorySnapshot.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+#include <utility>
+
+#include "cmsys/Directory.hxx"
+#include "cmsys/FStream.hxx"
+
+#include "cmFileTime.h"
+#include "cmGeneratedFileStream.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+namespace {
+// Directories handled by each thread at least, below which spawning
+// threads costs more than it saves.
+std::size_t const MinimumDirectoriesPerThread = 64;
+
+template <typename F>
+void ForEachParallel(std::size_t count, unsigned int threads, F const& f)
+{
+  if (threads > count / MinimumDirectoriesPerThread) {
+    threads = static_cast<unsigned int>(count / MinimumDirectoriesPerThread);
+  }
+  std::atomic<std::size_t> next(0);
+  auto worker = [&next, count, &f]() {
+    for (std::size_t i = next++; i < count; i = next++) {
+      f(i);
+    }
+  };
+  std::vector<std::thread> workers;
+  if (threads > 1) {
+    workers.reserve(threads - 1);
+    for (unsigned int i = 1; i < threads; ++i) {
+      workers.emplace_back(worker);
+    }
+  }
+  worker();
+  for (std::thread& w : workers) {
+    w.join();
+  }
+}
+
+unsigned int DefaultThreads()
+{
+  unsigned int const threads = std::thread::hardware_concurrency();
+  return threads > 0 ? threads : 1;
+}
+
+// Levels of listing of a directory.
+enum ListedLevel
+{
+  NotListed = 0,
+  ListedWithoutSymlinks = 1,
+  ListedWithSymlinks = 2
+};
+}
+
+bool cmGlobDirectorySnapshot::AddGlob(
+  std::string const& expression, bool recurse, bool followSymlinks,
+  cmGlobDirectorySnapshot const* previous)
+{
+  // Only the last component of the expression may have wildcards, the
+  // directories matched by wildcards in other components are not known.
+  std::string const base = cmSystemTools::GetFilenamePath(expression);
+  if (base.empty() || base.find_first_of("*?[") != std::string::npos) {
+    this->Valid = false;
+    return false;
+  }
+  for (Glob const& glob : this->Globs) {
+    if (glob.Base == base && glob.Recurse == recurse &&
+        glob.FollowSymlinks == followSymlinks) {
+      return true;
+    }
+  }
+  this->Globs.push_back(Glob{ base, recurse, followSymlinks });
+  if (!previous || !this->Reuse(this->Globs.back(), *previous)) {
+    this->Walk(base, recurse, followSymlinks, DefaultThreads());
+  }
+  return true;
+}
+
+bool cmGlobDirectorySnapshot::Reuse(Glob const& glob,
+                                    cmGlobDirectorySnapshot const& previous)
+{
+  // Without recursion only the base directory is recorded, which costs
+  // no listing.  Symbolic links may lead outside of the base directory,
+  // so the directories they reach cannot be told apart.
+  if (!glob.Recurse || glob.FollowSymlinks) {
+    return false;
+  }
+  bool recorded = false;
+  for (Glob const& g : previous.Globs) {
+    if (g.Base == glob.Base && g.Recurse && !g.FollowSymlinks) {
+      recorded = true;
+      break;
+    }
+  }
+  if (!recorded) {
+    return false;
+  }
+
+  // The previous snapshot listed every directory below the base, and all
+  // of them are found there unless one was added, removed or renamed,
+  // which changed the time of its parent.
+  std::string prefix = glob.Base;
+  if (prefix.back() != '/') {
+    prefix += '/';
+  }
+  std::vector<Directory const*> tree;
+  for (Directory const& d : previous.Directories) {
+    if (d.Listed != NotListed &&
+        (d.Path == glob.Base || cmHasPrefix(d.Path, prefix))) {
+      tree.push_back(&d);
+    }
+  }
+  std::atomic<bool> unchanged(true);
+  ForEachParallel(tree.size(), DefaultThreads(),
+                  [&tree, &unchanged](std::size_t i) {
+                    if (!unchanged) {
+                      return;
+                    }
+                    Directory const& d = *tree[i];
+                    cmFileTime time;
+                    bool const exists = time.Load(d.Path);
+                    if (d.Racy || exists != d.Exists ||
+                        (exists && time.GetTime() != d.Time) ||
+                        (exists && time.IsRacy())) {
+                      unchanged = false;
+                    }
+                  });
+  if (tree.empty() || !unchanged) {
+    return false;
+  }
+
+  for (Directory const* d : tree) {
+    auto const it = this->Index.find(d->Path);
+    if (it == this->Index.end()) {
+      this->Index.emplace(d->Path, this->Directories.size());
+      this->Directories.push_back(*d);
+      this->Directories.back().Listed = ListedWithoutSymlinks;
+    } else if (this->Directories[it->second].Listed < ListedWithoutSymlinks) {
+      this->Directories[it->second].Listed = ListedWithoutSymlinks;
+    }
+  }
+  return true;
+}
+
+void cmGlobDirectorySnapshot::Clear()
+{
+  this->Globs.clear();
+  this->Directories.clear();
+  this->Index.clear();
+  this->Valid = true;
+}
+
+void cmGlobDirectorySnapshot::Walk(std::string const& base, bool recurse,
+                                   bool followSymlinks, unsigned int threads)
+{
+  int const level = !recurse
+    ? NotListed
+    : (followSymlinks ? ListedWithSymlinks : ListedWithoutSymlinks);
+
+  struct Work
+  {
+    Work(std::size_t index, std::string path, bool record)
+      : Index(index)
+      , Path(std::move(path))
+      , Record(record)
+    {
+    }
+    std::size_t Index;
+    std::string Path;
+    bool Record;
+    long long Time = 0;
+    bool Exists = false;
+    bool Racy = false;
+    std::vector<std::string> Subdirectories;
+  };
+
+  // Walk the tree breadth first, each level being processed in parallel.
+  std::vector<std::string> frontier{ base };
+  while (!frontier.empty()) {
+    std::vector<Work> work;
+    for (std::string& path : frontier) {
+      auto const it = this->Index.find(path);
+      if (it == this->Index.end()) {
+        std::size_t const index = this->Directories.size();
+        this->Index.emplace(path, index);
+        this->Directories.emplace_back();
+        this->Directories.back().Path = path;
+        work.emplace_back(index, std::move(path), true);
+      } else if (this->Directories[it->second].Listed < level) {
+        // Recorded earlier, which is fine, but not listed deep enough.
+        work.emplace_back(it->second, std::move(path), false);
+      }
+    }
+    frontier.clear();
+
+    ForEachParallel(work.size(), threads, [&work, level](std::size_t i) {
+      Work& w = work[i];
+      if (w.Record) {
+        // Record the time before listing the directory.
+        cmFileTime time;
+        w.Exists = time.Load(w.Path);
+        w.Time = time.GetTime();
+        w.Racy = w.Exists && time.IsRacy();
+      }
+      if (level == NotListed) {
+        return;
+      }
+      cmsys::Directory dir;
+      if (!dir.Load(w.Path)) {
+        return;
+      }
+      for (unsigned long f = 0; f < dir.GetNumberOfFiles(); ++f) {
+        std::string const& name = dir.GetFileName(f);
+        if (name == "." || name == ".." || !dir.FileIsDirectory(f)) {
+          continue;
+        }
+        if (!dir.FileIsSymlink(f)) {
+          w.Subdirectories.emplace_back(dir.GetFilePath(f));
+        } else if (level == ListedWithSymlinks) {
+          // Use the real path to stop at cycles.
+          w.Subdirectories.emplace_back(
+            cmSystemTools::GetRealPath(dir.GetFilePath(f)));
+        }
+      }
+    });
+
+    for (Work& w : work) {
+      Directory& d = this->Directories[w.Index];
+      if (w.Record) {
+        d.Time = w.Time;
+        d.Exists = w.Exists;
+        d.Racy = w.Racy;
+      }
+      if (d.Listed < level) {
+        d.Listed = level;
+      }
+      for (std::string& subdirectory : w.Subdirectories) {
+        frontier.emplace_back(std::move(subdirectory));
+      }
+    }
+  }
+}
+
+bool cmGlobDirectorySnapshot::Save(std::string const& file) const
+{
+  cmGeneratedFileStream fout(file);
+  fout.SetCopyIfDifferent(true);
+  if (!fout) {
+    return false;
+  }
+  fout << "# CMAKE generated file: DO NOT EDIT!\n"
+          "# Directories listed by the globs of VerifyGlobs.cmake.\n";
+  for (Glob const& glob : this->Globs) {
+    fout << "g " << (glob.Recurse ? '1' : '0')
+         << (glob.FollowSymlinks ? '1' : '0') << ' ' << glob.Base << '\n';
+  }
+  for (Directory const& d : this->Directories) {
+    fout << "d " << d.Listed << ' ';
+    if (d.Racy) {
+      fout << '?';
+    } else if (d.Exists) {
+      fout << d.Time;
+    } else {
+      fout << '-';
+    }
+    fout << ' ' << d.Path << '\n';
+  }
+  return fout.Close();
+}
+
+bool cmGlobDirectorySnapshot::Load(std::string const& file)
+{
+  this->Clear();
+  cmsys::ifstream fin(file.c_str());
+  if (!fin) {
+    return false;
+  }
+  std::string line;
+  while (cmSystemTools::GetLineFromStream(fin, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    if (cmHasLiteralPrefix(line, "g ") && line.size() > 5) {
+      // g <recurse><follow symlinks> <base>
+      this->Globs.push_back(
+        Glob{ line.substr(5), line[2] == '1', line[3] == '1' });
+    } else if (cmHasLiteralPrefix(line, "d ") && line.size() > 4) {
+      // d <listed> <time, '-' if missing or '?' if racy> <path>
+      std::string::size_type const path = line.find(' ', 4);
+      if (path == std::string::npos) {
+        this->Clear();
+        return false;
+      }
+      Directory d;
+      d.Listed = line[2] - '0';
+      d.Exists = line[4] != '-';
+      d.Racy = line[4] == '?';
+      if (d.Exists && !d.Racy) {
+        d.Time = std::strtoll(line.c_str() + 4, nullptr, 10);
+      }
+      d.Path = line.substr(path + 1);
+      this->Index.emplace(d.Path, this->Directories.size());
+      this->Directories.emplace_back(std::move(d));
+    } else {
+      this->Clear();
+      return false;
+    }
+  }
+  return true;
+}
+
+bool cmGlobDirectorySnapshot::IsUpToDate(unsigned int threads) const
+{
+  std::atomic<bool> upToDate(true);
+  ForEachParallel(this->Directories.size(), threads,
+                  [this, &upToDate](std::size_t i) {
+                    if (!upToDate) {
+                      return;
+                    }
+                    Directory const& d = this->Directories[i];
+                    cmFileTime time;
+                    bool const exists = time.Load(d.Path);
+                    if (d.Racy || exists != d.Exists ||
+                        (exists && time.GetTime() != d.Time)) {
+                      upToDate = false;
+                    }
+                  });
+  return upToDate;
+}
+
+void cmGlobDirectorySnapshot::Refresh(unsigned int threads)
+{
+  std::vector<Glob> globs = std::move(this->Globs);
+  this->Clear();
+  for (Glob& glob : globs) {
+    this->Walk(glob.Base, glob.Recurse, glob.FollowSymlinks, threads);
+    this->Globs.emplace_back(std::move(glob));
+  }
+}
@@ -0,0 +1,91 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#pragma once
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/** \class cmGlobDirectorySnapshot
+ * \brief Modification times of the directories listed by glob expressions.
+ *
+ * The result of a glob expression only depends on the listings of the
+ * directories it traverses.  Adding, removing or renaming an entry of a
+ * directory updates its modification time, so the expression needs to be
+ * evaluated again only if the time of one of these directories changed.
+ *
+ * Directories are recorded before being listed, so a change made while a
+ * snapshot is taken is detected by the next comparison.  A directory
+ * shared by several expressions is recorded and listed once.  A directory
+ * modified too recently to trust its time is always considered changed.
+ */
+class cmGlobDirectorySnapshot
+{
+public:
+  /**
+   * Record the directories traversed by a glob expression.  Return false
+   * if the expression cannot be tracked by the time of its directories,
+   * in which case the snapshot is no longer usable.  If a previous
+   * snapshot recorded the same expression and none of its directories
+   * changed since, they are taken from it instead of being listed again.
+   */
+  bool AddGlob(std::string const& expression, bool recurse,
+               bool followSymlinks,
+               cmGlobDirectorySnapshot const* previous = nullptr);
+
+  //! Whether all expressions added so far are tracked.
+  bool IsValid() const { return this->Valid; }
+
+  //! Forget all expressions and directories.
+  void Clear();
+
+  //! Save the snapshot to a file.
+  bool Save(std::string const& file) const;
+
+  //! Load a snapshot saved by Save().
+  bool Load(std::string const& file);
+
+  /**
+   * Compare the recorded times with those of the file system using the
+   * given number of threads.  Return true if no directory changed.
+   */
+  bool IsUpToDate(unsigned int threads) const;
+
+  //! Record again the directories of all expressions.
+  void Refresh(unsigned int threads);
+
+  //! Number of recorded directories.
+  std::size_t GetNumberOfDirectories() const
+  {
+    return this->Directories.size();
+  }
+
+private:
+  struct Glob
+  {
+    std::string Base;
+    bool Recurse;
+    bool FollowSymlinks;
+  };
+
+  struct Directory
+  {
+    std::string Path;
+    long long Time = 0;
+    bool Exists = false;
+    bool Racy = false;
+    int Listed = 0;
+  };
+
+  bool Reuse(Glob const& glob, cmGlobDirectorySnapshot const& previous);
+  void Walk(std::string const& base, bool recurse, bool followSymlinks,
+            unsigned int threads);
+
+  std::vector<Glob> Globs;
+  std::vector<Directory> Directories;
+  std::unordered_map<std::string, std::size_t> Index;
+  bool Valid = true;
+};
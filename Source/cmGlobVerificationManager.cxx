@@ -24,9 +24,11 @@ bool cmGlobVerificationManager::SaveVerificationScript(std::string const& path,
 
   std::string scriptFile = cmStrCat(path, "/CMakeFiles");
   std::string stampFile = scriptFile;
+  std::string directoriesFile = scriptFile;
   cmSystemTools::MakeDirectory(scriptFile);
   scriptFile += "/VerifyGlobs.cmake";
   stampFile += "/cmake.verify_globs";
+  directoriesFile += "/VerifyGlobs.dirs";
   cmGeneratedFileStream verifyScriptFile(scriptFile);
   verifyScriptFile.SetCopyIfDifferent(true);
   if (!verifyScriptFile) {
@@ -90,6 +92,18 @@ bool cmGlobVerificationManager::SaveVerificationScript(std::string const& path,
   }
   verifyScriptFile.Close();
 
+  // The directories listed by the globs let their verification be skipped
+  // while none of them changed.
+#ifndef CMAKE_BOOTSTRAP
+  if (this->Directories.IsValid()) {
+    this->Directories.Save(directoriesFile);
+  } else {
+    cmSystemTools::RemoveFile(directoriesFile);
+  }
+#else
+  static_cast<void>(directoriesFile);
+#endif
+
   cmsys::ofstream verifyStampFile(stampFile.c_str());
   if (!verifyStampFile) {
     cmSystemTools::Error("Unable to open verification stamp file for write. " +
@@ -205,9 +219,35 @@ std::vector<cmGlobCacheEntry> cmGlobVerificationManager::GetCacheEntries()
   return entries;
 }
 
+void cmGlobVerificationManager::AddDirectories(std::string const& path,
+                                               std::string const& expression,
+                                               bool recurse,
+                                               bool followSymlinks)
+{
+#ifndef CMAKE_BOOTSTRAP
+  if (!this->PreviousDirectoriesLoaded) {
+    this->PreviousDirectoriesLoaded = true;
+    this->PreviousDirectories.Load(
+      cmStrCat(path, "/CMakeFiles/VerifyGlobs.dirs"));
+  }
+  this->Directories.AddGlob(expression, recurse, followSymlinks,
+                            &this->PreviousDirectories);
+#else
+  static_cast<void>(path);
+  static_cast<void>(expression);
+  static_cast<void>(recurse);
+  static_cast<void>(followSymlinks);
+#endif
+}
+
 void cmGlobVerificationManager::Reset()
 {
   this->Cache.clear();
+#ifndef CMAKE_BOOTSTRAP
+  this->Directories.Clear();
+  this->PreviousDirectories.Clear();
+  this->PreviousDirectoriesLoaded = false;
+#endif
   this->VerifyScript.clear();
   this->VerifyStamp.clear();
 }
@@ -12,6 +12,10 @@
 
 #include "cmListFileCache.h"
 
+#ifndef CMAKE_BOOTSTRAP
+#  include "cmGlobDirectorySnapshot.h"
+#endif
+
 class cmMessenger;
 struct cmGlobCacheEntry;
 
@@ -33,6 +37,13 @@ protected:
                      std::string const& variable,
                      cmListFileBacktrace const& bt, cmMessenger* messenger);
 
+  //! Record the directories listed by a glob expression before it is
+  //! evaluated, to skip its verification while they are unchanged.
+  //! Reuses the directories saved for the build tree at <path> if none of
+  //! them changed.
+  void AddDirectories(std::string const& path, std::string const& expression,
+                      bool recurse, bool followSymlinks);
+
   //! Get all cache entries
   std::vector<cmGlobCacheEntry> GetCacheEntries() const;
 
@@ -76,6 +87,11 @@ private:
 
   using CacheEntryMap = std::map<CacheEntryKey, CacheEntryValue>;
   CacheEntryMap Cache;
+#ifndef CMAKE_BOOTSTRAP
+  cmGlobDirectorySnapshot Directories;
+  cmGlobDirectorySnapshot PreviousDirectories;
+  bool PreviousDirectoriesLoaded = false;
+#endif
   std::string VerifyScript;
   std::string VerifyStamp;
 
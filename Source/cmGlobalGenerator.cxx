@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
@@ -11,6 +12,7 @@
 #include <initializer_list>
 #include <iterator>
 #include <sstream>
+#include <thread>
 #include <type_traits>
 #include <utility>
 
@@ -21,6 +23,7 @@
 
 #include "cmsys/Directory.hxx"
 #include "cmsys/FStream.hxx"
+#include "cmsys/Glob.hxx"
 #include "cmsys/RegularExpression.hxx"
 
 #include "cm_codecvt_Encoding.hxx"
@@ -28,6 +31,7 @@
 #include "cmAlgorithms.h"
 #include "cmCMakePath.h"
 #include "cmCPackPropertiesGenerator.h"
+#include "cmComputeLinkDepends.h"
 #include "cmComputeTargetDepends.h"
 #include "cmCryptoHash.h"
 #include "cmCustomCommand.h"
@@ -49,6 +53,7 @@
 #include "cmMakefile.h"
 #include "cmMessageType.h"
 #include "cmOutputConverter.h"
+#include "cmPathTable.h"
 #include "cmPolicies.h"
 #include "cmRange.h"
 #include "cmSourceFile.h"
@@ -56,6 +61,7 @@
 #include "cmStateDirectory.h"
 #include "cmStateTypes.h"
 #include "cmStringAlgorithms.h"
+#include "cmStringPool.h"
 #include "cmSyntheticTargetCache.h"
 #include "cmSystemTools.h"
 #include "cmValue.h"
@@ -67,8 +73,13 @@
 #if !defined(CMAKE_BOOTSTRAP)
 #  include <cm3p/json/value.h>
 #  include <cm3p/json/writer.h>
+#  include <cm3p/uv.h>
 
+#  include "cmInstrumentation.h"
+#  include "cmInstrumentationQuery.h"
+#  include "cmMakefileProfilingData.h"
 #  include "cmQtAutoGenGlobalInitializer.h"
+#  include "cmThreadPool.h"
 #endif
 
 class cmListFileBacktrace;
@@ -108,6 +119,7 @@ bool cmTarget::StrictTargetComparison::operator()(cmTarget const* t1,
 
 cmGlobalGenerator::cmGlobalGenerator(cmake* cm)
   : CMakeInstance(cm)
+  , PathTable(cm::make_unique<cmPathTable>())
 {
   // By default the .SYMBOLIC dependency is not needed on symbolic rules.
   this->NeedSymbolicMark = false;
@@ -1267,11 +1279,39 @@ void cmGlobalGenerator::CreateLocalGenerators()
   }
 }
 
+std::string const& cmGlobalGenerator::GetModulePathDigest(
+  std::string const& modulePath)
+{
+  auto it = this->ModulePathDigests.find(modulePath);
+  if (it != this->ModulePathDigests.end()) {
+    return it->second;
+  }
+
+  cmCryptoHash hash(cmCryptoHash::AlgoSHA256);
+  cmCryptoHash contentHash(cmCryptoHash::AlgoSHA256);
+  hash.Initialize();
+  for (std::string const& dir : cmList{ modulePath }) {
+    cmsys::Glob glob;
+    glob.RecurseOn();
+    glob.FindFiles(cmStrCat(dir, "/*.cmake"));
+    std::vector<std::string> modules = glob.GetFiles();
+    std::sort(modules.begin(), modules.end());
+    for (std::string const& module : modules) {
+      // Prefix names by their size so that no two lists hash the same.
+      hash.Append(cmStrCat(module.size(), ' ', module, ' ',
+                           contentHash.HashFile(module), '\n'));
+    }
+  }
+  return this->ModulePathDigests.emplace(modulePath, hash.FinalizeHex())
+    .first->second;
+}
+
 void cmGlobalGenerator::Configure()
 {
   this->FirstTimeProgress = 0.0f;
   this->ClearGeneratorMembers();
   this->NextDeferId = 0;
+  this->ModulePathDigests.clear();
 
   cmStateSnapshot snapshot = this->CMakeInstance->GetCurrentSnapshot();
 
@@ -1322,8 +1362,79 @@ void cmGlobalGenerator::Configure()
   this->GetCMakeInstance()->AddCacheEntry(
     "CMAKE_NUMBER_OF_MAKEFILES", std::to_string(this->Makefiles.size()),
     "number of local generators", cmStateEnums::INTERNAL);
+
+#ifndef CMAKE_BOOTSTRAP
+  this->ReportConfigureMemory();
+#endif
 }
 
+#ifndef CMAKE_BOOTSTRAP
+void cmGlobalGenerator::ReportConfigureMemory() const
+{
+  cmInstrumentation* instrumentation =
+    this->CMakeInstance->GetInstrumentation();
+  bool const instrument = instrumentation &&
+    instrumentation->HasOption(
+      cmInstrumentationQuery::Option::DynamicSystemInformation);
+  bool const profile = this->CMakeInstance->IsProfilingEnabled();
+  if (!instrument && !profile) {
+    return;
+  }
+
+  cmMakefile::MemoryUsage total;
+  Json::Value directories = Json::arrayValue;
+  for (auto const& mf : this->Makefiles) {
+    cmMakefile::MemoryUsage const usage = mf->GetMemoryUsage();
+    total.Variables += usage.Variables;
+    total.DirectoryProperties += usage.DirectoryProperties;
+    total.TargetProperties += usage.TargetProperties;
+    if (instrument) {
+      Json::Value& dir = directories.append(Json::objectValue);
+      dir["source"] = mf->GetCurrentSourceDirectory();
+      dir["variables"] = static_cast<Json::UInt64>(usage.Variables);
+      dir["directoryProperties"] =
+        static_cast<Json::UInt64>(usage.DirectoryProperties);
+      dir["targetProperties"] =
+        static_cast<Json::UInt64>(usage.TargetProperties);
+    }
+  }
+  cmStringPool const& pool = this->CMakeInstance->GetState()->GetStringPool();
+  std::size_t rss = 0;
+  if (uv_resident_set_memory(&rss) != 0) {
+    rss = 0;
+  }
+
+  if (profile) {
+    Json::Value counters = Json::objectValue;
+    counters["variables"] = static_cast<Json::UInt64>(total.Variables);
+    counters["directory_properties"] =
+      static_cast<Json::UInt64>(total.DirectoryProperties);
+    counters["target_properties"] =
+      static_cast<Json::UInt64>(total.TargetProperties);
+    counters["string_pool"] = static_cast<Json::UInt64>(pool.GetBytes());
+    counters["string_pool_strings"] =
+      static_cast<Json::UInt64>(pool.GetCount());
+    counters["rss"] = static_cast<Json::UInt64>(rss);
+    this->CMakeInstance->GetProfilingOutput().CounterEntry(
+      "configure", "configure_memory", std::move(counters));
+  }
+
+  if (instrument) {
+    Json::Value content = Json::objectValue;
+    content["variables"] = static_cast<Json::UInt64>(total.Variables);
+    content["directoryProperties"] =
+      static_cast<Json::UInt64>(total.DirectoryProperties);
+    content["targetProperties"] =
+      static_cast<Json::UInt64>(total.TargetProperties);
+    content["stringPoolBytes"] = static_cast<Json::UInt64>(pool.GetBytes());
+    content["stringPoolStrings"] = static_cast<Json::UInt64>(pool.GetCount());
+    content["residentSetSize"] = static_cast<Json::UInt64>(rss);
+    content["directories"] = std::move(directories);
+    instrumentation->AddCustomContent("configureMemory", content);
+  }
+}
+#endif
+
 void cmGlobalGenerator::CreateGenerationObjects(TargetTypes targetTypes)
 {
   this->CreateLocalGenerators();
@@ -1634,6 +1745,21 @@ void cmGlobalGenerator::Generate()
   }
 #endif
 
+  // Optionally let the local generators defer replacing the project
+  // files they write so that the comparisons with their previous content
+  // and the renames run in parallel once all of them are written.
+  unsigned int const generateThreads = this->GetGenerateParallelLevel();
+  if (generateThreads > 1) {
+    this->GeneratedFileBatch = cm::make_unique<cmGeneratedFileStreamBatch>();
+  }
+
+  // The properties of the targets no longer change while the project
+  // files are generated, so context-independent transitive usage
+  // requirements may be reused across their consumers.
+  this->InterfacePropertyMemoState.Enabled = true;
+  ++this->InterfacePropertyMemoState.Epoch;
+  this->SetShareLinkDepends(true);
+
   // Generate project files
   for (unsigned int i = 0; i < this->LocalGenerators.size(); ++i) {
     this->SetCurrentMakefile(this->LocalGenerators[i]->GetMakefile());
@@ -1650,6 +1776,61 @@ void cmGlobalGenerator::Generate()
           static_cast<float>(this->LocalGenerators.size()));
   }
   this->SetCurrentMakefile(nullptr);
+  this->InterfacePropertyMemoState.Enabled = false;
+
+#ifndef CMAKE_BOOTSTRAP
+  if (this->CMakeInstance->IsProfilingEnabled()) {
+    Json::Value counters = Json::objectValue;
+    counters["hits"] =
+      static_cast<Json::UInt64>(this->InterfacePropertyMemoState.Hits);
+    counters["misses"] =
+      static_cast<Json::UInt64>(this->InterfacePropertyMemoState.Misses);
+    this->CMakeInstance->GetProfilingOutput().CounterEntry(
+      "generate", "interface_property_memo", std::move(counters));
+
+    counters = Json::objectValue;
+    counters["hits"] = static_cast<Json::UInt64>(this->LinkDependsCache->Hits);
+    counters["misses"] =
+      static_cast<Json::UInt64>(this->LinkDependsCache->Misses);
+    this->CMakeInstance->GetProfilingOutput().CounterEntry(
+      "generate", "link_depends_closure_cache", std::move(counters));
+
+    counters = Json::objectValue;
+    counters["paths"] =
+      static_cast<Json::UInt64>(this->PathTable->GetPathCount());
+    counters["hits"] = static_cast<Json::UInt64>(this->PathTable->GetHits());
+    counters["misses"] =
+      static_cast<Json::UInt64>(this->PathTable->GetMisses());
+    this->CMakeInstance->GetProfilingOutput().CounterEntry(
+      "generate", "path_table", std::move(counters));
+  }
+#endif
+  this->SetShareLinkDepends(false);
+
+  if (this->GeneratedFileBatch) {
+    std::size_t const deferred = this->GeneratedFileBatch->GetSize();
+    std::size_t replaced;
+    {
+#ifndef CMAKE_BOOTSTRAP
+      auto profilingRAII = this->CMakeInstance->CreateProfilingEntry(
+        "generate", "commit_generated_files");
+#endif
+      replaced = this->GeneratedFileBatch->Commit(generateThreads);
+    }
+    this->GeneratedFileBatch.reset();
+#ifndef CMAKE_BOOTSTRAP
+    if (this->CMakeInstance->IsProfilingEnabled()) {
+      Json::Value counters = Json::objectValue;
+      counters["deferred"] = static_cast<Json::UInt64>(deferred);
+      counters["replaced"] = static_cast<Json::UInt64>(replaced);
+      this->CMakeInstance->GetProfilingOutput().CounterEntry(
+        "generate", "generated_file_batch", std::move(counters));
+    }
+#else
+    static_cast<void>(deferred);
+    static_cast<void>(replaced);
+#endif
+  }
 
   if (!this->GenerateCPackPropertiesFile()) {
     this->GetCMakeInstance()->IssueMessage(
@@ -1695,6 +1876,15 @@ void cmGlobalGenerator::Generate()
   }
 }
 
+void cmGlobalGenerator::SetShareLinkDepends(bool share)
+{
+  if (!share) {
+    this->LinkDependsCache.reset();
+  } else if (!this->LinkDependsCache) {
+    this->LinkDependsCache = cm::make_unique<cmComputeLinkDependsCache>();
+  }
+}
+
 #if !defined(CMAKE_BOOTSTRAP)
 void cmGlobalGenerator::WriteJsonContent(std::string const& path,
                                          Json::Value const& value) const
@@ -1728,6 +1918,27 @@ void cmGlobalGenerator::WriteInstallJson() const
 }
 #endif
 
+unsigned int cmGlobalGenerator::GetGenerateParallelLevel() const
+{
+  if (!this->SupportsParallelGenerate() || this->Makefiles.empty()) {
+    return 1;
+  }
+  cmValue level =
+    this->Makefiles[0]->GetDefinition("CMAKE_GENERATE_PARALLEL_LEVEL");
+  unsigned long threads = 1;
+  if (level && !cmStrToULong(*level, &threads)) {
+    this->CMakeInstance->IssueMessage(
+      MessageType::WARNING,
+      cmStrCat("CMAKE_GENERATE_PARALLEL_LEVEL is set to \"", *level,
+               "\", which is not a non-negative integer.  Ignoring."));
+    return 1;
+  }
+  if (threads == 0) {
+    threads = std::thread::hardware_concurrency();
+  }
+  return threads > 1 ? static_cast<unsigned int>(threads) : 1;
+}
+
 bool cmGlobalGenerator::ComputeTargetDepends()
 {
   cmComputeTargetDepends ctd(this);
@@ -2004,6 +2215,7 @@ void cmGlobalGenerator::ClearGeneratorMembers()
   this->ProjectMap.clear();
   this->RuleHashes.clear();
   this->DirectoryContentMap.clear();
+  this->PrefetchedDirectoryContent.clear();
   this->XcFrameworkPListContentMap.clear();
   this->BinaryDirectories.clear();
   this->GeneratedFiles.clear();
@@ -2130,6 +2342,56 @@ int cmGlobalGenerator::TryCompile(int jobs, std::string const& srcdir,
                                   std::string const& projectName,
                                   std::string const& target, bool fast,
                                   std::string& output, cmMakefile* mf)
+{
+  this->UpdateTryCompileProgress();
+
+  std::vector<std::string> newTarget = {};
+  if (!target.empty()) {
+    newTarget = { target };
+  }
+  std::string config =
+    mf->GetSafeDefinition("CMAKE_TRY_COMPILE_CONFIGURATION");
+  cmBuildOptions defaultBuildOptions(false, fast, PackageResolveMode::Disable);
+
+  std::stringstream ostr;
+  auto ret = this->Build(jobs, srcdir, bindir, projectName, newTarget, ostr,
+                         "", config, defaultBuildOptions, true,
+                         this->TryCompileTimeout, cmSystemTools::OUTPUT_NONE);
+  output = ostr.str();
+  return ret;
+}
+
+bool cmGlobalGenerator::GenerateTryCompileBuildCommand(
+  int jobs, std::string const& bindir, std::string const& projectName,
+  std::string const& target, bool fast, cmMakefile* mf,
+  std::vector<GeneratedMakeCommand>& commands, std::string& output)
+{
+  this->UpdateTryCompileProgress();
+
+  // Generate the commands as Build() does for TryCompile().
+  cmWorkingDirectory workdir(bindir);
+  if (workdir.Failed()) {
+    std::string const& err = workdir.GetError();
+    cmSystemTools::Error(err);
+    output = cmStrCat("Change Dir: '", bindir, "'\n", err, '\n');
+    return false;
+  }
+  std::vector<std::string> newTarget = {};
+  if (!target.empty()) {
+    newTarget = { target };
+  }
+  std::string config =
+    mf->GetSafeDefinition("CMAKE_TRY_COMPILE_CONFIGURATION");
+  if (config.empty()) {
+    config = this->GetDefaultBuildConfig();
+  }
+  commands = this->GenerateBuildCommand(
+    "", projectName, bindir, newTarget, config, jobs, true,
+    cmBuildOptions(false, fast, PackageResolveMode::Disable));
+  return true;
+}
+
+void cmGlobalGenerator::UpdateTryCompileProgress()
 {
   // if this is not set, then this is a first time configure
   // and there is a good chance that the try compile stuff will
@@ -2148,21 +2410,6 @@ int cmGlobalGenerator::TryCompile(int jobs, std::string const& srcdir,
     this->CMakeInstance->UpdateProgress("Configuring",
                                         this->FirstTimeProgress);
   }
-
-  std::vector<std::string> newTarget = {};
-  if (!target.empty()) {
-    newTarget = { target };
-  }
-  std::string config =
-    mf->GetSafeDefinition("CMAKE_TRY_COMPILE_CONFIGURATION");
-  cmBuildOptions defaultBuildOptions(false, fast, PackageResolveMode::Disable);
-
-  std::stringstream ostr;
-  auto ret = this->Build(jobs, srcdir, bindir, projectName, newTarget, ostr,
-                         "", config, defaultBuildOptions, true,
-                         this->TryCompileTimeout, cmSystemTools::OUTPUT_NONE);
-  output = ostr.str();
-  return ret;
 }
 
 std::vector<cmGlobalGenerator::GeneratedMakeCommand>
@@ -3551,7 +3798,7 @@ std::set<std::string> const& cmGlobalGenerator::GetDirectoryContent(
   std::string const& dir, bool needDisk)
 {
   DirectoryContent& dc = this->DirectoryContentMap[dir];
-  if (needDisk) {
+  if (needDisk && !dc.Prefetched) {
     long mt = cmSystemTools::ModifiedTime(dir);
     if (mt != dc.LastDiskTime) {
       // Reset to non-loaded directory content.
@@ -3574,6 +3821,78 @@ std::set<std::string> const& cmGlobalGenerator::GetDirectoryContent(
   return dc.All;
 }
 
+void cmGlobalGenerator::PrefetchDirectoryContent(
+  std::vector<std::string> const& dirs, unsigned int threads)
+{
+  struct Listing
+  {
+    long DiskTime = 0;
+    std::vector<std::string> Files;
+  };
+  std::vector<Listing> listings(dirs.size());
+  auto load = [&dirs, &listings](std::size_t i) {
+    Listing& listing = listings[i];
+    listing.DiskTime = cmSystemTools::ModifiedTime(dirs[i]);
+    cmsys::Directory d;
+    if (d.Load(dirs[i])) {
+      unsigned long n = d.GetNumberOfFiles();
+      listing.Files.reserve(n);
+      for (unsigned long j = 0; j < n; ++j) {
+        char const* f = d.GetFile(j);
+        if (strcmp(f, ".") != 0 && strcmp(f, "..") != 0) {
+          listing.Files.emplace_back(f);
+        }
+      }
+    }
+  };
+
+#if !defined(CMAKE_BOOTSTRAP)
+  // Each task only reads the disk and writes its own listing.
+  this->CMakeInstance->GetThreadPool().ForEach(dirs.size(), threads, load);
+#else
+  static_cast<void>(threads);
+  for (std::size_t i = 0; i < dirs.size(); ++i) {
+    load(i);
+  }
+#endif
+
+  // Store the listings in the order a sequential search would load them.
+  for (std::size_t i = 0; i < dirs.size(); ++i) {
+    Listing& listing = listings[i];
+    DirectoryContent& dc = this->DirectoryContentMap[dirs[i]];
+    if (!dc.Prefetched) {
+      if (listing.DiskTime != dc.LastDiskTime) {
+        dc.All = dc.Generated;
+        dc.All.insert(std::make_move_iterator(listing.Files.begin()),
+                      std::make_move_iterator(listing.Files.end()));
+        dc.LastDiskTime = listing.DiskTime;
+      }
+      dc.Prefetched = true;
+      this->PrefetchedDirectoryContent.push_back(&dc);
+    }
+  }
+}
+
+void cmGlobalGenerator::DropPrefetchedDirectoryContent()
+{
+  // Check the disk again on the next access, the content may change
+  // between searches.
+  for (DirectoryContent* dc : this->PrefetchedDirectoryContent) {
+    dc->Prefetched = false;
+  }
+  this->PrefetchedDirectoryContent.clear();
+}
+
+std::set<std::string> const* cmGlobalGenerator::GetPrefetchedDirectoryContent(
+  std::string const& dir) const
+{
+  auto i = this->DirectoryContentMap.find(dir);
+  if (i == this->DirectoryContentMap.end() || !i->second.Prefetched) {
+    return nullptr;
+  }
+  return &i->second.All;
+}
+
 void cmGlobalGenerator::AddRuleHash(std::vector<std::string> const& outputs,
                                     std::string const& content)
 {
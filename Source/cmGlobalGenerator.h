@@ -45,9 +45,12 @@
 enum class cmDepfileFormat;
 enum class codecvt_Encoding;
 
+class cmComputeLinkDependsCache;
+class cmPathTable;
 class cmDirectoryId;
 class cmExportBuildFileGenerator;
 class cmExternalMakefileProjectGenerator;
+class cmGeneratedFileStreamBatch;
 class cmGeneratorTarget;
 class cmInstallRuntimeDependencySet;
 class cmLinkLineComputer;
@@ -183,6 +186,10 @@ public:
 
   virtual bool IsGNUMakeJobServerAware() const { return false; }
 
+  /** Whether the files written by the local generators may be replaced
+      after all of them are generated, possibly concurrently.  */
+  virtual bool SupportsParallelGenerate() const { return false; }
+
   bool Compute();
   virtual void AddExtraIDETargets() {}
 
@@ -281,6 +288,16 @@ public:
 
   virtual void PrintBuildCommandAdvice(std::ostream& os, int jobs) const;
 
+  /**
+   * Get the commands with which TryCompile() would build a project
+   * already generated, to run them later.  Return false and set
+   * \p output to the reason if they cannot be generated.
+   */
+  bool GenerateTryCompileBuildCommand(
+    int jobs, std::string const& bindir, std::string const& projectName,
+    std::string const& targetName, bool fast, cmMakefile* mf,
+    std::vector<GeneratedMakeCommand>& commands, std::string& output);
+
   /**
    * Generate a "cmake --build" call for a given target, config and parallel
    * level.
@@ -493,6 +510,19 @@ public:
   std::set<std::string> const& GetDirectoryContent(std::string const& dir,
                                                    bool needDisk = true);
 
+  /** Load the content of the given directories from disk on up to the
+      given number of threads.  Until DropPrefetchedDirectoryContent is
+      called, GetDirectoryContent returns the loaded content without
+      accessing the disk again.  */
+  void PrefetchDirectoryContent(std::vector<std::string> const& dirs,
+                                unsigned int threads);
+  void DropPrefetchedDirectoryContent();
+
+  /** Get the content of a directory loaded by PrefetchDirectoryContent,
+      or nullptr if the directory has not been prefetched.  */
+  std::set<std::string> const* GetPrefetchedDirectoryContent(
+    std::string const& dir) const;
+
   void IndexTarget(cmTarget* t);
   void IndexGeneratorTarget(cmGeneratorTarget* gt);
 
@@ -651,6 +681,50 @@ public:
   std::set<cmGeneratorTarget const*> const& GetFilenameTargetDepends(
     cmSourceFile* sf) const;
 
+  /** State of the memoization of transitive usage requirements that do
+      not depend on the evaluation context.  Entries are stored by the
+      targets and are valid only for the current epoch.  */
+  struct InterfacePropertyMemo
+  {
+    bool Enabled = false;
+    unsigned long long Epoch = 0;
+    unsigned long long Hits = 0;
+    unsigned long long Misses = 0;
+  };
+  InterfacePropertyMemo& GetInterfacePropertyMemo() const
+  {
+    return this->InterfacePropertyMemoState;
+  }
+
+  /** Get the link dependency closures shared among targets, or nullptr
+      if they are not shared.  They are shared while the project files
+      are generated.  */
+  cmComputeLinkDependsCache* GetLinkDependsCache() const
+  {
+    return this->LinkDependsCache.get();
+  }
+
+  /** Start sharing link dependency closures among targets, or stop and
+      drop the closures shared so far.  */
+  void SetShareLinkDepends(bool share);
+
+  /** Get the batch to which the local generators may defer replacing the
+      project files they write, or nullptr if they must replace them when
+      closed.  See CMAKE_GENERATE_PARALLEL_LEVEL.  */
+  cmGeneratedFileStreamBatch* GetGeneratedFileBatch() const
+  {
+    return this->GeneratedFileBatch.get();
+  }
+
+  /** Get a digest of the names and content of the modules found below
+      the directories of the given CMAKE_MODULE_PATH value.  It is
+      computed once per configure.  */
+  std::string const& GetModulePathDigest(std::string const& modulePath);
+
+  /** Get the table of paths and their converted forms shared by the
+      generators.  */
+  cmPathTable* GetPathTable() const { return this->PathTable.get(); }
+
 #if !defined(CMAKE_BOOTSTRAP)
   cmFileLockPool& GetFileLockPool() { return this->FileLockPool; }
 #endif
@@ -722,10 +796,13 @@ protected:
 
   virtual bool ComputeTargetDepends();
 
+  unsigned int GetGenerateParallelLevel() const;
+
 #if !defined(CMAKE_BOOTSTRAP)
   void WriteJsonContent(std::string const& fname,
                         Json::Value const& value) const;
   void WriteInstallJson() const;
+  void ReportConfigureMemory() const;
 #endif
 
   virtual bool CheckALLOW_DUPLICATE_CUSTOM_TARGETS() const;
@@ -833,6 +910,8 @@ private:
 
   void ComputeTargetOrder();
   void ComputeTargetOrder(cmGeneratorTarget const* gt, size_t& index);
+
+  void UpdateTryCompileProgress();
   std::map<cmGeneratorTarget const*, size_t> TargetOrderIndex;
 
   cmMakefile* TryCompileOuterMakefile;
@@ -921,8 +1000,10 @@ private:
     long LastDiskTime = -1;
     std::set<std::string> All;
     std::set<std::string> Generated;
+    bool Prefetched = false;
   };
   std::map<std::string, DirectoryContent> DirectoryContentMap;
+  std::vector<DirectoryContent*> PrefetchedDirectoryContent;
 
   // Cache parsed PList files
   std::map<std::string, cmXcFrameworkPlist> XcFrameworkPListContentMap;
@@ -938,8 +1019,16 @@ private:
   mutable std::map<cmSourceFile*, std::set<cmGeneratorTarget const*>>
     FilenameTargetDepends;
 
+  mutable InterfacePropertyMemo InterfacePropertyMemoState;
+  std::unique_ptr<cmComputeLinkDependsCache> LinkDependsCache;
+  std::unique_ptr<cmGeneratedFileStreamBatch> GeneratedFileBatch;
+  std::unique_ptr<cmPathTable> PathTable;
+
   std::map<std::string, std::string> RealPaths;
 
+  // Digests of the modules found in CMAKE_MODULE_PATH values.
+  std::map<std::string, std::string> ModulePathDigests;
+
   std::unordered_set<std::string> GeneratedFiles;
 
   std::vector<std::unique_ptr<cmInstallRuntimeDependencySet>>
@@ -42,6 +42,7 @@
 #include "cmMessageType.h"
 #include "cmNinjaLinkLineComputer.h"
 #include "cmOutputConverter.h"
+#include "cmPathTable.h"
 #include "cmRange.h"
 #include "cmScanDepFormat.h"
 #include "cmSourceFile.h"
@@ -78,6 +79,77 @@ bool DetectGCCOnWindows(cm::string_view compilerId, cm::string_view simulateId,
             cmHasLiteralSuffix(compilerId, "Clang"))));
 }
 #endif
+
+void AppendComment(std::string& out, std::string const& comment)
+{
+  if (comment.empty()) {
+    return;
+  }
+
+  std::string::size_type lpos = 0;
+  std::string::size_type rpos;
+  out += "\n#############################################\n";
+  while ((rpos = comment.find('\n', lpos)) != std::string::npos) {
+    out += "# ";
+    out.append(comment, lpos, rpos - lpos);
+    out += '\n';
+    lpos = rpos + 1;
+  }
+  out += "# ";
+  out.append(comment, lpos, std::string::npos);
+  out += "\n\n";
+}
+
+// Get the value of a variable as written to a Ninja file.
+cm::string_view GetVariableValue(std::string const& name,
+                                 std::string const& value)
+{
+  static std::unordered_set<std::string> const variablesShouldNotBeTrimmed = {
+    "CODE_CHECK", "LAUNCHER"
+  };
+  cm::string_view val = value;
+  if (variablesShouldNotBeTrimmed.find(name) ==
+      variablesShouldNotBeTrimmed.end()) {
+    while (!val.empty() && cmIsSpace(val.front())) {
+      val.remove_prefix(1);
+    }
+    while (!val.empty() && cmIsSpace(val.back())) {
+      val.remove_suffix(1);
+    }
+  }
+  return val;
+}
+
+// Append a variable binding as written to a Ninja file, with an optional
+// comment, unless the value is empty.
+void AppendVariable(std::string& out, std::string const& name,
+                    std::string const& value, std::string const& comment,
+                    int indent)
+{
+  // Make sure we have a name.
+  if (name.empty()) {
+    cmSystemTools::Error(cmStrCat("No name given for WriteVariable! called "
+                                  "with comment: ",
+                                  comment));
+    return;
+  }
+
+  cm::string_view const val = GetVariableValue(name, value);
+
+  // Do not add a variable if the value is empty.
+  if (val.empty()) {
+    return;
+  }
+
+  AppendComment(out, comment);
+  for (int i = 0; i < indent; ++i) {
+    out += cmGlobalNinjaGenerator::INDENT;
+  }
+  out += name;
+  out += " = ";
+  out.append(val.data(), val.size());
+  out += '\n';
+}
 }
 
 bool operator==(
@@ -142,18 +214,9 @@ void cmGlobalNinjaGenerator::WriteDivider(std::ostream& os)
 void cmGlobalNinjaGenerator::WriteComment(std::ostream& os,
                                           std::string const& comment)
 {
-  if (comment.empty()) {
-    return;
-  }
-
-  std::string::size_type lpos = 0;
-  std::string::size_type rpos;
-  os << "\n#############################################\n";
-  while ((rpos = comment.find('\n', lpos)) != std::string::npos) {
-    os << "# " << comment.substr(lpos, rpos - lpos) << "\n";
-    lpos = rpos + 1;
-  }
-  os << "# " << comment.substr(lpos) << "\n\n";
+  std::string text;
+  AppendComment(text, comment);
+  os << text;
 }
 
 std::unique_ptr<cmLinkLineComputer>
@@ -197,17 +260,67 @@ std::string& cmGlobalNinjaGenerator::EncodeLiteral(std::string& lit)
 
 std::string cmGlobalNinjaGenerator::EncodePath(std::string const& path)
 {
-  std::string result = path;
+  std::string result;
+  this->AppendEncodedPath(result, path);
+  return result;
+}
+
+void cmGlobalNinjaGenerator::AppendEncodedPath(std::string& out,
+                                               std::string const& path)
+{
+  // Most paths need no encoding.  Append them as they are.
 #ifdef _WIN32
-  if (this->IsGCCOnWindows())
-    std::replace(result.begin(), result.end(), '\\', '/');
-  else
-    std::replace(result.begin(), result.end(), '/', '\\');
+  char const* const special = "$\n :/\\";
+#else
+  char const* const special = "$\n :";
 #endif
-  this->EncodeLiteral(result);
-  cmSystemTools::ReplaceString(result, " ", "$ ");
-  cmSystemTools::ReplaceString(result, ":", "$:");
-  return result;
+  std::string::size_type pos = path.find_first_of(special);
+  if (pos == std::string::npos) {
+    out += path;
+    return;
+  }
+
+  // Encode the rest in one pass, with the result of EncodeLiteral
+  // followed by escaping spaces and colons.
+  cm::string_view cfgIntDir;
+  if (this->IsMultiConfig()) {
+    cfgIntDir = this->GetCMakeCFGIntDir();
+  }
+  out.reserve(out.size() + path.size() + 8);
+  out.append(path, 0, pos);
+  for (; pos < path.size(); ++pos) {
+    char const c = path[pos];
+    switch (c) {
+#ifdef _WIN32
+      case '/':
+      case '\\':
+        out += this->IsGCCOnWindows() ? '/' : '\\';
+        break;
+#endif
+      case '$':
+        if (!cfgIntDir.empty() &&
+            path.compare(pos, cfgIntDir.size(), cfgIntDir.data(),
+                         cfgIntDir.size()) == 0) {
+          out.append(cfgIntDir.data(), cfgIntDir.size());
+          pos += cfgIntDir.size() - 1;
+        } else {
+          out += "$$";
+        }
+        break;
+      case '\n':
+        out += "$\n";
+        break;
+      case ' ':
+        out += "$ ";
+        break;
+      case ':':
+        out += "$:";
+        break;
+      default:
+        out += c;
+        break;
+    }
+  }
 }
 
 void cmGlobalNinjaGenerator::WriteBuild(std::ostream& os,
@@ -229,22 +342,34 @@ void cmGlobalNinjaGenerator::WriteBuild(std::ostream& os,
     return;
   }
 
-  cmGlobalNinjaGenerator::WriteComment(os, build.Comment);
+#ifndef CMAKE_BOOTSTRAP
+  bool const timed = this->GetCMakeInstance()->IsProfilingEnabled();
+  auto const startTime = timed ? std::chrono::steady_clock::now()
+                               : std::chrono::steady_clock::time_point();
+#endif
+
+  // Assemble the whole statement and write it at once.
+  std::string& out = this->BuildStatement;
+  out.clear();
+  AppendComment(out, build.Comment);
+  std::string::size_type const statementStart = out.size();
 
   // Write output files.
-  std::string buildStr("build");
+  out += "build";
   {
     // Write explicit outputs
     for (std::string const& output : build.Outputs) {
-      buildStr = cmStrCat(buildStr, ' ', this->EncodePath(output));
+      out += ' ';
+      this->AppendEncodedPath(out, output);
     }
     // Write implicit outputs
     if (!build.ImplicitOuts.empty()) {
       // Assume Ninja is new enough to support implicit outputs.
       // Callers should not populate this field otherwise.
-      buildStr = cmStrCat(buildStr, " |");
+      out += " |";
       for (std::string const& implicitOut : build.ImplicitOuts) {
-        buildStr = cmStrCat(buildStr, ' ', this->EncodePath(implicitOut));
+        out += ' ';
+        this->AppendEncodedPath(out, implicitOut);
       }
     }
 
@@ -255,74 +380,76 @@ void cmGlobalNinjaGenerator::WriteBuild(std::ostream& os,
     if (!build.WorkDirOuts.empty()) {
       if (this->SupportsImplicitOuts() && build.ImplicitOuts.empty()) {
         // Make them implicit outputs if supported by this version of Ninja.
-        buildStr = cmStrCat(buildStr, " |");
+        out += " |";
       }
       for (std::string const& workdirOut : build.WorkDirOuts) {
-        buildStr = cmStrCat(buildStr, " ${cmake_ninja_workdir}",
-                            this->EncodePath(workdirOut));
+        out += " ${cmake_ninja_workdir}";
+        this->AppendEncodedPath(out, workdirOut);
       }
     }
 
     // Write the rule.
-    buildStr = cmStrCat(buildStr, ": ", build.Rule);
+    out += ": ";
+    out += build.Rule;
   }
 
-  std::string arguments;
   {
     // TODO: Better formatting for when there are multiple input/output files.
 
     // Write explicit dependencies.
     for (std::string const& explicitDep : build.ExplicitDeps) {
-      arguments += cmStrCat(' ', this->EncodePath(explicitDep));
+      out += ' ';
+      this->AppendEncodedPath(out, explicitDep);
     }
 
     // Write implicit dependencies.
     if (!build.ImplicitDeps.empty()) {
-      arguments += " |";
+      out += " |";
       for (std::string const& implicitDep : build.ImplicitDeps) {
-        arguments += cmStrCat(' ', this->EncodePath(implicitDep));
+        out += ' ';
+        this->AppendEncodedPath(out, implicitDep);
       }
     }
 
     // Write order-only dependencies.
     if (!build.OrderOnlyDeps.empty()) {
-      arguments += " ||";
+      out += " ||";
       for (std::string const& orderOnlyDep : build.OrderOnlyDeps) {
-        arguments += cmStrCat(' ', this->EncodePath(orderOnlyDep));
+        out += ' ';
+        this->AppendEncodedPath(out, orderOnlyDep);
       }
     }
 
-    arguments += '\n';
+    out += '\n';
   }
 
   // Write the variables bound to this build statement.
-  std::string assignments;
-  {
-    std::ostringstream variable_assignments;
-    for (auto const& variable : build.Variables) {
-      cmGlobalNinjaGenerator::WriteVariable(
-        variable_assignments, variable.first, variable.second, "", 1);
-    }
+  for (auto const& variable : build.Variables) {
+    AppendVariable(out, variable.first, variable.second, std::string(), 1);
+  }
 
-    // check if a response file rule should be used
-    assignments = variable_assignments.str();
-    bool useResponseFile = false;
-    if (cmdLineLimit < 0 ||
-        (cmdLineLimit > 0 &&
-         (arguments.size() + buildStr.size() + assignments.size() + 1000) >
-           static_cast<size_t>(cmdLineLimit))) {
-      variable_assignments.str(std::string());
-      cmGlobalNinjaGenerator::WriteVariable(variable_assignments, "RSP_FILE",
-                                            build.RspFile, "", 1);
-      assignments += variable_assignments.str();
-      useResponseFile = true;
-    }
-    if (usedResponseFile) {
-      *usedResponseFile = useResponseFile;
-    }
+  // check if a response file rule should be used
+  bool useResponseFile = false;
+  if (cmdLineLimit < 0 ||
+      (cmdLineLimit > 0 &&
+       (out.size() - statementStart + 1000) >
+         static_cast<size_t>(cmdLineLimit))) {
+    AppendVariable(out, "RSP_FILE", build.RspFile, std::string(), 1);
+    useResponseFile = true;
+  }
+  if (usedResponseFile) {
+    *usedResponseFile = useResponseFile;
   }
 
-  os << buildStr << arguments << assignments << "\n";
+  out += '\n';
+  os.write(out.data(), static_cast<std::streamsize>(out.size()));
+  ++this->BuildStatementCount;
+  this->BuildStatementBytes += out.size();
+#ifndef CMAKE_BOOTSTRAP
+  if (timed) {
+    this->BuildStatementTime += std::chrono::steady_clock::now() - startTime;
+  }
+#endif
 }
 
 void cmGlobalNinjaGenerator::AddCustomCommandRule()
@@ -506,33 +633,9 @@ void cmGlobalNinjaGenerator::WriteVariable(std::ostream& os,
                                            std::string const& comment,
                                            int indent)
 {
-  // Make sure we have a name.
-  if (name.empty()) {
-    cmSystemTools::Error(cmStrCat("No name given for WriteVariable! called "
-                                  "with comment: ",
-                                  comment));
-    return;
-  }
-
-  std::string val;
-  static std::unordered_set<std::string> const variablesShouldNotBeTrimmed = {
-    "CODE_CHECK", "LAUNCHER"
-  };
-  if (variablesShouldNotBeTrimmed.find(name) ==
-      variablesShouldNotBeTrimmed.end()) {
-    val = cmTrimWhitespace(value);
-  } else {
-    val = value;
-  }
-
-  // Do not add a variable if the value is empty.
-  if (val.empty()) {
-    return;
-  }
-
-  cmGlobalNinjaGenerator::WriteComment(os, comment);
-  cmGlobalNinjaGenerator::Indent(os, indent);
-  os << name << " = " << val << "\n";
+  std::string text;
+  AppendVariable(text, name, value, comment, indent);
+  os << text;
 }
 
 void cmGlobalNinjaGenerator::WriteInclude(std::ostream& os,
@@ -629,6 +732,9 @@ void cmGlobalNinjaGenerator::Generate()
   this->DiagnosedCxxModuleNinjaSupport = false;
   this->ClangTidyExportFixesDirs.clear();
   this->ClangTidyExportFixesFiles.clear();
+  this->BuildStatementCount = 0;
+  this->BuildStatementBytes = 0;
+  this->BuildStatementTime = std::chrono::steady_clock::duration();
 
   this->cmGlobalGenerator::Generate();
 
@@ -637,6 +743,21 @@ void cmGlobalNinjaGenerator::Generate()
   this->WriteFolderTargets(*this->GetCommonFileStream());
   this->WriteBuiltinTargets(*this->GetCommonFileStream());
 
+#ifndef CMAKE_BOOTSTRAP
+  if (this->GetCMakeInstance()->IsProfilingEnabled()) {
+    Json::Value counters = Json::objectValue;
+    counters["statements"] =
+      static_cast<Json::UInt64>(this->BuildStatementCount);
+    counters["bytes"] = static_cast<Json::UInt64>(this->BuildStatementBytes);
+    counters["microseconds"] = static_cast<Json::UInt64>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+        this->BuildStatementTime)
+        .count());
+    this->GetCMakeInstance()->GetProfilingOutput().CounterEntry(
+      "generate", "ninja_build_statements", std::move(counters));
+  }
+#endif
+
   if (cmSystemTools::GetErrorOccurredFlag()) {
     this->RulesFileStream->setstate(std::ios::failbit);
     for (std::string const& config : this->GetConfigNames()) {
@@ -1182,19 +1303,16 @@ static void EnsureTrailingSlash(std::string& path)
 std::string const& cmGlobalNinjaGenerator::ConvertToNinjaPath(
   std::string const& path) const
 {
-  auto const f = this->ConvertToNinjaPathCache.find(path);
-  if (f != this->ConvertToNinjaPathCache.end()) {
-    return f->second;
-  }
-
-  std::string convPath =
-    this->LocalGenerators[0]->MaybeRelativeToTopBinDir(path);
-  convPath = this->NinjaOutputPath(convPath);
+  return this->GetPathTable()->GetForm(
+    path, cmPathTable::NinjaPathForm, [this](std::string const& p) {
+      std::string convPath =
+        this->LocalGenerators[0]->MaybeRelativeToTopBinDir(p);
+      convPath = this->NinjaOutputPath(convPath);
 #ifdef _WIN32
-  std::replace(convPath.begin(), convPath.end(), '/', '\\');
+      std::replace(convPath.begin(), convPath.end(), '/', '\\');
 #endif
-  return this->ConvertToNinjaPathCache.emplace(path, std::move(convPath))
-    .first->second;
+      return convPath;
+    });
 }
 
 std::string cmGlobalNinjaGenerator::ConvertToNinjaAbsPath(
@@ -1877,7 +1995,7 @@ void cmGlobalNinjaGenerator::WriteTargetRebuildManifest(std::ostream& os)
     {
       cmNinjaRule rule("VERIFY_GLOBS");
       rule.Command =
-        cmStrCat(this->CMakeCmd(), " -P ",
+        cmStrCat(this->CMakeCmd(), " -E cmake_verify_globs ",
                  lg->ConvertToOutputFormat(cm->GetGlobVerifyScript(),
                                            cmOutputConverter::SHELL));
       rule.Description = "Re-checking globbed directories...";
@@ -4,6 +4,7 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <chrono>
 #include <iosfwd>
 #include <map>
 #include <memory>
@@ -79,6 +80,9 @@ public:
   std::string& EncodeLiteral(std::string& lit) override;
   std::string EncodePath(std::string const& path);
 
+  /// Append the encoding of @a path computed by EncodePath to @a out.
+  void AppendEncodedPath(std::string& out, std::string const& path);
+
   std::unique_ptr<cmLinkLineComputer> CreateLinkLineComputer(
     cmOutputConverter* outputConverter,
     cmStateDirectory const& stateDir) const override;
@@ -189,6 +193,8 @@ public:
 
   bool IsNinja() const override { return true; }
 
+  bool SupportsParallelGenerate() const override { return true; }
+
   /** Get encoding used by generator for ninja files */
   codecvt_Encoding GetMakefileEncoding() const override;
 
@@ -582,8 +588,13 @@ private:
   TargetAliasMap TargetAliases;
   TargetAliasMap DefaultTargetAliases;
 
-  /// the local cache for calls to ConvertToNinjaPath
-  mutable std::unordered_map<std::string, std::string> ConvertToNinjaPathCache;
+  /// The text of the build statement being written, kept across calls to
+  /// WriteBuild to reuse its storage.
+  std::string BuildStatement;
+  unsigned long long BuildStatementCount = 0;
+  unsigned long long BuildStatementBytes = 0;
+  // Time spent writing build statements, measured when profiling.
+  std::chrono::steady_clock::duration BuildStatementTime{};
 
   std::string NinjaCommand;
   std::string NinjaVersion;
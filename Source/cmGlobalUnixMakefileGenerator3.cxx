@@ -19,6 +19,7 @@
 #include "cmMakefile.h"
 #include "cmMakefileTargetGenerator.h"
 #include "cmOutputConverter.h"
+#include "cmPathTable.h"
 #include "cmState.h"
 #include "cmStateTypes.h"
 #include "cmStringAlgorithms.h"
@@ -523,12 +524,15 @@ std::string ConvertToMakefilePathForWindows(std::string const& path)
 std::string cmGlobalUnixMakefileGenerator3::ConvertToMakefilePath(
   std::string const& path) const
 {
+  cmPathTable* table = this->GetPathTable();
 #if defined(_WIN32) && !defined(__CYGWIN__)
   if (!this->ForceUnixPaths) {
-    return ConvertToMakefilePathForWindows(path);
+    return table->GetForm(path, cmPathTable::MakefilePathForm | 1,
+                          ConvertToMakefilePathForWindows);
   }
 #endif
-  return ConvertToMakefilePathForUnix(path);
+  return table->GetForm(path, cmPathTable::MakefilePathForm,
+                        ConvertToMakefilePathForUnix);
 }
 
 std::vector<cmGlobalGenerator::GeneratedMakeCommand>
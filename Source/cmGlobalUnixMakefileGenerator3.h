@@ -122,6 +122,8 @@ public:
 
   bool IsGNUMakeJobServerAware() const override { return true; }
 
+  bool SupportsParallelGenerate() const override { return true; }
+
   /**
    * Generate the all required files for building this project/tree. This
    * basically creates a series of LocalGenerators for each directory and
@@ -3,7 +3,12 @@
 #define cmListFileCache_cxx
 #include "cmListFileCache.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <utility>
 
@@ -11,6 +16,10 @@
 #  include <cmsys/Encoding.hxx>
 #endif
 
+#include "cmsys/FStream.hxx"
+
+#include "cmCryptoHash.h"
+#include "cmFileTime.h"
 #include "cmList.h"
 #include "cmListFileLexer.h"
 #include "cmMessageType.h"
@@ -53,6 +62,8 @@ public:
   bool ParseFile(char const* filename);
   bool ParseString(char const* str, char const* virtual_filename);
 
+  bool IssuedWarning() const { return this->Warning; }
+
 private:
   bool Parse();
   bool ParseFunction(char const* name, long line);
@@ -74,6 +85,7 @@ private:
   cmListFileBacktrace Backtrace;
   cmMessenger* Messenger;
   char const* FileName = nullptr;
+  bool Warning = false;
   std::unique_ptr<cmListFileLexer, void (*)(cmListFileLexer*)> Lexer;
   std::string FunctionName;
   long FunctionLine;
@@ -326,6 +338,7 @@ bool cmListFileParser::AddArgument(cmListFileLexer_Token* token,
     return false;
   }
   this->Messenger->IssueMessage(MessageType::AUTHOR_WARNING, msg, lfbt);
+  this->Warning = true;
   return true;
 }
 
@@ -422,21 +435,118 @@ cm::optional<cmListFileContext> cmListFileParser::CheckNesting() const
   return cm::nullopt;
 }
 
+// Parsed list files shared by all cmake instances in this process,
+// keyed by canonical path and validated by file time and size.
+class ParsedListFileMemo
+{
+public:
+  bool Lookup(std::string const& path, long long fileTime,
+              unsigned long long fileSize,
+              std::vector<cmListFileFunction>& functions)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto it = this->Entries.find(path);
+    if (it == this->Entries.end() || it->second.FileTime != fileTime ||
+        it->second.FileSize != fileSize) {
+      ++this->Misses;
+      return false;
+    }
+    ++this->Hits;
+    functions = it->second.Functions;
+    return true;
+  }
+
+  void Store(std::string const& path, long long fileTime,
+             unsigned long long fileSize,
+             std::vector<cmListFileFunction> const& functions)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    Entry& entry = this->Entries[path];
+    entry.FileTime = fileTime;
+    entry.FileSize = fileSize;
+    entry.Functions = functions;
+  }
+
+  void GetCounts(unsigned long& hits, unsigned long& misses)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    hits = this->Hits;
+    misses = this->Misses;
+  }
+
+private:
+  struct Entry
+  {
+    long long FileTime = 0;
+    unsigned long long FileSize = 0;
+    std::vector<cmListFileFunction> Functions;
+  };
+
+  std::mutex Mutex;
+  unsigned long Hits = 0;
+  unsigned long Misses = 0;
+  std::unordered_map<std::string, Entry> Entries;
+};
+
+ParsedListFileMemo& GetParsedListFileMemo()
+{
+  static ParsedListFileMemo memo;
+  return memo;
+}
+
 } // anonymous namespace
 
+void cmListFile::GetMemoCounts(unsigned long& hits, unsigned long& misses)
+{
+  GetParsedListFileMemo().GetCounts(hits, misses);
+}
+
 bool cmListFile::ParseFile(char const* filename, cmMessenger* messenger,
-                           cmListFileBacktrace const& lfbt)
+                           cmListFileBacktrace const& lfbt,
+                           cmListFileCache* cache)
 {
   if (!cmSystemTools::FileExists(filename) ||
       cmSystemTools::FileIsDirectory(filename)) {
     return false;
   }
 
+  if (cache && cache->Lookup(filename, this->Functions)) {
+    return true;
+  }
+
+  // Record the file time before parsing so that a concurrent modification
+  // invalidates the cached entries.
+  cmFileTime fileTime;
+  bool const reusable = fileTime.Load(filename) && !fileTime.IsRacy();
+  std::string realPath;
+  unsigned long long fileSize = 0;
+  if (reusable) {
+    realPath = cmSystemTools::GetRealPath(filename);
+    fileSize = cmSystemTools::FileLength(filename);
+    if (GetParsedListFileMemo().Lookup(realPath, fileTime.GetTime(),
+                                       fileSize, this->Functions)) {
+      if (cache) {
+        cache->Store(filename, fileTime.GetTime(), this->Functions);
+      }
+      return true;
+    }
+  }
+
   bool parseError = false;
 
   {
     cmListFileParser parser(this, lfbt, messenger);
     parseError = !parser.ParseFile(filename);
+
+    // Diagnostics are issued only while parsing, so files that produced
+    // any must be parsed again to reproduce them.
+    if (!parseError && reusable && !parser.IssuedWarning()) {
+      GetParsedListFileMemo().Store(realPath, fileTime.GetTime(), fileSize,
+                                    this->Functions);
+      if (cache) {
+        cache->Store(filename, fileTime.GetTime(), this->Functions);
+      }
+    }
   }
 
   return !parseError;
@@ -456,6 +566,295 @@ bool cmListFile::ParseString(char const* str, char const* virtual_filename,
   return !parseError;
 }
 
+namespace {
+
+// Bump this when the layout of the cache file changes.
+std::uint32_t const ListFileCacheVersion = 1;
+char const ListFileCacheMagic[4] = { 'L', 'F', 'C', '\0' };
+
+void WriteU64(std::ostream& os, std::uint64_t value)
+{
+  unsigned char buf[8];
+  for (unsigned char& b : buf) {
+    b = static_cast<unsigned char>(value & 0xff);
+    value >>= 8;
+  }
+  os.write(reinterpret_cast<char const*>(buf), sizeof(buf));
+}
+
+void WriteString(std::ostream& os, std::string const& str)
+{
+  WriteU64(os, str.size());
+  os.write(str.data(), static_cast<std::streamsize>(str.size()));
+}
+
+/** Read the values of a cache file of the given size.  No value may
+    claim more bytes than are left in the file, so a corrupt length does
+    not allocate more memory than the file holds.  */
+class ListFileCacheReader
+{
+public:
+  ListFileCacheReader(std::istream& is, std::uint64_t size)
+    : Stream(is)
+    , Remaining(size)
+  {
+  }
+
+  bool ReadBytes(char* data, std::uint64_t size)
+  {
+    if (size > this->Remaining ||
+        !this->Stream.read(data, static_cast<std::streamsize>(size))) {
+      return false;
+    }
+    this->Remaining -= size;
+    return true;
+  }
+
+  bool ReadU64(std::uint64_t& value)
+  {
+    unsigned char buf[8];
+    if (!this->ReadBytes(reinterpret_cast<char*>(buf), sizeof(buf))) {
+      return false;
+    }
+    value = 0;
+    for (int i = 7; i >= 0; --i) {
+      value = (value << 8) | buf[i];
+    }
+    return true;
+  }
+
+  bool ReadLong(long& value)
+  {
+    std::uint64_t v;
+    if (!this->ReadU64(v)) {
+      return false;
+    }
+    value = static_cast<long>(static_cast<std::int64_t>(v));
+    return true;
+  }
+
+  bool ReadString(std::string& str)
+  {
+    std::uint64_t size;
+    if (!this->ReadU64(size) || size > this->Remaining) {
+      return false;
+    }
+    str.resize(static_cast<std::size_t>(size));
+    return size == 0 || this->ReadBytes(&str[0], size);
+  }
+
+  bool ReadFunction(std::vector<cmListFileFunction>& out)
+  {
+    std::string name;
+    long line;
+    long lineEnd;
+    std::uint64_t argCount;
+    if (!this->ReadString(name) || !this->ReadLong(line) ||
+        !this->ReadLong(lineEnd) || !this->ReadU64(argCount)) {
+      return false;
+    }
+    std::vector<cmListFileArgument> args;
+    for (std::uint64_t i = 0; i < argCount; ++i) {
+      std::string value;
+      std::uint64_t delim;
+      long argLine;
+      if (!this->ReadString(value) || !this->ReadU64(delim) ||
+          !this->ReadLong(argLine) || delim > cmListFileArgument::Bracket) {
+        return false;
+      }
+      args.emplace_back(std::move(value),
+                        static_cast<cmListFileArgument::Delimiter>(delim),
+                        argLine);
+    }
+    out.emplace_back(std::move(name), line, lineEnd, std::move(args));
+    return true;
+  }
+
+private:
+  std::istream& Stream;
+  std::uint64_t Remaining;
+};
+
+std::string HashListFile(std::string const& path)
+{
+  cmCryptoHash hasher(cmCryptoHash::AlgoSHA256);
+  return hasher.HashFile(path);
+}
+
+} // anonymous namespace
+
+cmListFileCache::cmListFileCache(std::string cacheFile)
+  : CacheFile(std::move(cacheFile))
+{
+}
+
+void cmListFileCache::Load()
+{
+  cmsys::ifstream fin(this->CacheFile.c_str(),
+                      std::ios::in | std::ios::binary);
+  if (!fin) {
+    return;
+  }
+
+  ListFileCacheReader reader(fin,
+                             cmSystemTools::FileLength(this->CacheFile));
+  char magic[sizeof(ListFileCacheMagic)];
+  std::uint64_t version;
+  std::uint64_t entryCount;
+  if (!reader.ReadBytes(magic, sizeof(magic)) ||
+      !std::equal(magic, magic + sizeof(magic), ListFileCacheMagic) ||
+      !reader.ReadU64(version) || version != ListFileCacheVersion ||
+      !reader.ReadU64(entryCount)) {
+    return;
+  }
+
+  for (std::uint64_t i = 0; i < entryCount; ++i) {
+    std::string path;
+    Entry entry;
+    std::uint64_t fileTime;
+    std::uint64_t fileSize;
+    std::uint64_t functionCount;
+    if (!reader.ReadString(path) || !reader.ReadU64(fileTime) ||
+        !reader.ReadU64(fileSize) || !reader.ReadString(entry.Hash) ||
+        !reader.ReadU64(functionCount)) {
+      // Discard a truncated or corrupt cache entirely.
+      this->Entries.clear();
+      return;
+    }
+    entry.FileTime = static_cast<long long>(fileTime);
+    entry.FileSize = fileSize;
+    for (std::uint64_t j = 0; j < functionCount; ++j) {
+      if (!reader.ReadFunction(entry.Functions)) {
+        this->Entries.clear();
+        return;
+      }
+    }
+    this->Entries.emplace(std::move(path), std::move(entry));
+  }
+}
+
+bool cmListFileCache::Save()
+{
+  bool unused = false;
+  for (auto const& e : this->Entries) {
+    if (!e.second.Used) {
+      unused = true;
+      break;
+    }
+  }
+  if (!this->Modified && !unused) {
+    return true;
+  }
+
+  // Write to a temporary file and rename it into place so that an
+  // interrupted run never leaves a partially written cache behind.
+  std::string const tempFile = cmStrCat(this->CacheFile, ".tmp");
+  {
+    cmsys::ofstream fout(tempFile.c_str(),
+                         std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!fout) {
+      return false;
+    }
+
+    std::uint64_t entryCount = 0;
+    for (auto const& e : this->Entries) {
+      if (e.second.Used) {
+        ++entryCount;
+      }
+    }
+
+    fout.write(ListFileCacheMagic, sizeof(ListFileCacheMagic));
+    WriteU64(fout, ListFileCacheVersion);
+    WriteU64(fout, entryCount);
+    for (auto const& e : this->Entries) {
+      Entry const& entry = e.second;
+      if (!entry.Used) {
+        continue;
+      }
+      WriteString(fout, e.first);
+      WriteU64(fout, static_cast<std::uint64_t>(entry.FileTime));
+      WriteU64(fout, entry.FileSize);
+      WriteString(fout, entry.Hash);
+      WriteU64(fout, entry.Functions.size());
+      for (cmListFileFunction const& func : entry.Functions) {
+        WriteString(fout, func.OriginalName());
+        WriteU64(fout, static_cast<std::uint64_t>(func.Line()));
+        WriteU64(fout, static_cast<std::uint64_t>(func.LineEnd()));
+        WriteU64(fout, func.Arguments().size());
+        for (cmListFileArgument const& arg : func.Arguments()) {
+          WriteString(fout, arg.Value);
+          WriteU64(fout, static_cast<std::uint64_t>(arg.Delim));
+          WriteU64(fout, static_cast<std::uint64_t>(arg.Line));
+        }
+      }
+    }
+    if (!fout) {
+      fout.close();
+      cmSystemTools::RemoveFile(tempFile);
+      return false;
+    }
+  }
+
+  if (!cmSystemTools::RenameFile(tempFile, this->CacheFile)) {
+    cmSystemTools::RemoveFile(tempFile);
+    return false;
+  }
+  this->Modified = false;
+  return true;
+}
+
+bool cmListFileCache::Lookup(std::string const& path,
+                             std::vector<cmListFileFunction>& functions)
+{
+  auto it = this->Entries.find(path);
+  if (it == this->Entries.end()) {
+    ++this->Misses;
+    return false;
+  }
+
+  Entry& entry = it->second;
+  cmFileTime fileTime;
+  if (!fileTime.Load(path)) {
+    this->Entries.erase(it);
+    this->Modified = true;
+    ++this->Misses;
+    return false;
+  }
+  unsigned long long fileSize = cmSystemTools::FileLength(path);
+  if (fileTime.GetTime() != entry.FileTime || fileSize != entry.FileSize) {
+    // The file was touched.  Reuse the entry if the content is unchanged.
+    if (fileSize != entry.FileSize || HashListFile(path) != entry.Hash) {
+      this->Entries.erase(it);
+      this->Modified = true;
+      ++this->Misses;
+      return false;
+    }
+    entry.FileTime = fileTime.GetTime();
+    this->Modified = true;
+  }
+
+  entry.Used = true;
+  functions = entry.Functions;
+  ++this->Hits;
+  return true;
+}
+
+void cmListFileCache::Store(std::string const& path, long long fileTime,
+                            std::vector<cmListFileFunction> const& functions)
+{
+  std::string hash = HashListFile(path);
+  if (hash.empty()) {
+    return;
+  }
+  Entry& entry = this->Entries[path];
+  entry.FileTime = fileTime;
+  entry.FileSize = cmSystemTools::FileLength(path);
+  entry.Hash = std::move(hash);
+  entry.Functions = functions;
+  entry.Used = true;
+  this->Modified = true;
+}
+
 #include "cmStack.tcc"
 template class cmStack<cmListFileContext const, cmListFileBacktrace,
                        cmStackType::Const>;
@@ -7,6 +7,7 @@
 #include <iosfwd>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -16,13 +17,7 @@
 #include "cmStack.h"
 #include "cmSystemTools.h"
 
-/** \class cmListFileCache
- * \brief A class to cache list file contents.
- *
- * cmListFileCache is a class used to cache the contents of parsed
- * cmake list files.
- */
-
+class cmListFileCache;
 class cmMessenger;
 
 struct cmListFileArgument
@@ -78,6 +73,21 @@ public:
     return this->Impl->Arguments;
   }
 
+  /** Information derived from the call when it is executed, such as the
+      resolved command.  It is shared by all copies of the call and is
+      defined by the interpreter in cmMakefile.  */
+  struct Compiled;
+
+  Compiled* GetCompiled() const noexcept
+  {
+    return this->Impl->CompiledForm.get();
+  }
+
+  void SetCompiled(std::shared_ptr<Compiled> compiled) const
+  {
+    this->Impl->CompiledForm = std::move(compiled);
+  }
+
 private:
   struct Implementation
   {
@@ -96,6 +106,7 @@ private:
     long Line = 0;
     long LineEnd = 0;
     std::vector<cmListFileArgument> Arguments;
+    mutable std::shared_ptr<Compiled> CompiledForm;
   };
 
   std::shared_ptr<Implementation const> Impl;
@@ -239,10 +250,65 @@ std::vector<BT<std::string>> cmExpandListWithBacktrace(
 struct cmListFile
 {
   bool ParseFile(char const* path, cmMessenger* messenger,
-                 cmListFileBacktrace const& lfbt);
+                 cmListFileBacktrace const& lfbt,
+                 cmListFileCache* cache = nullptr);
 
   bool ParseString(char const* str, char const* virtual_filename,
                    cmMessenger* messenger, cmListFileBacktrace const& lfbt);
 
+  /** Count the lookups of files parsed before in this process.  Files
+      modified too recently to be reused are not counted.  */
+  static void GetMemoCounts(unsigned long& hits, unsigned long& misses);
+
   std::vector<cmListFileFunction> Functions;
 };
+
+/** \class cmListFileCache
+ * \brief A class to cache list file contents.
+ *
+ * cmListFileCache is a class used to cache the contents of parsed
+ * cmake list files.  The cache is stored in a binary file in the build
+ * tree so that files unchanged since a previous run are loaded without
+ * lexing them again.  An entry is reused if the modification time and
+ * size of its file are unchanged, or if the content hash still matches.
+ */
+class cmListFileCache
+{
+public:
+  cmListFileCache(std::string cacheFile);
+
+  /** Load entries from the cache file.  A missing or unreadable cache file
+      is not an error; the cache simply starts empty.  */
+  void Load();
+
+  /** Save the entries looked up or stored during this run.  */
+  bool Save();
+
+  /** Get the parsed functions of the given file, if cached and current.  */
+  bool Lookup(std::string const& path,
+              std::vector<cmListFileFunction>& functions);
+
+  /** Store the parsed functions of the given file.  The file time must be
+      the one observed before parsing.  */
+  void Store(std::string const& path, long long fileTime,
+             std::vector<cmListFileFunction> const& functions);
+
+  unsigned long GetHits() const { return this->Hits; }
+  unsigned long GetMisses() const { return this->Misses; }
+
+private:
+  struct Entry
+  {
+    long long FileTime = 0;
+    unsigned long long FileSize = 0;
+    std::string Hash;
+    std::vector<cmListFileFunction> Functions;
+    bool Used = false;
+  };
+
+  std::string CacheFile;
+  std::unordered_map<std::string, Entry> Entries;
+  unsigned long Hits = 0;
+  unsigned long Misses = 0;
+  bool Modified = false;
+};
@@ -108,6 +108,7 @@ cmLocalGenerator::cmLocalGenerator(cmGlobalGenerator* gg, cmMakefile* makefile)
   , DirectoryBacktrace(makefile->GetBacktrace())
 {
   this->GlobalGenerator = gg;
+  this->PathTable = gg->GetPathTable();
 
   this->Makefile = makefile;
 
@@ -337,6 +338,7 @@ void cmLocalGenerator::GenerateTestFiles()
   this->GlobalGenerator->AddTestFile(file);
 
   cmGeneratedFileStream fout(file);
+  fout.SetBatch(this->GlobalGenerator->GetGeneratedFileBatch());
 
   fout << "# CMake generated Testfile for \n"
           "# Source directory: "
@@ -520,6 +522,7 @@ void cmLocalGenerator::GenerateInstallRules()
   file += "/cmake_install.cmake";
   this->GetGlobalGenerator()->AddInstallScript(file);
   cmGeneratedFileStream fout(file);
+  fout.SetBatch(this->GlobalGenerator->GetGeneratedFileBatch());
 
   // Write the header.
   /* clang-format off */
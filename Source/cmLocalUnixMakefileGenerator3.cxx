@@ -294,6 +294,7 @@ void cmLocalUnixMakefileGenerator3::WriteLocalMakefile()
   if (!this->IsRootMakefile()) {
     ruleFileStream.SetCopyIfDifferent(true);
   }
+  ruleFileStream.SetBatch(this->GlobalGenerator->GetGeneratedFileBatch());
 
   // write the all rules
   this->WriteLocalAllRules(ruleFileStream);
@@ -844,7 +845,7 @@ void cmLocalUnixMakefileGenerator3::WriteSpecialTargetsBottom(
     cmake* cm = this->GlobalGenerator->GetCMakeInstance();
     if (cm->DoWriteGlobVerifyTarget()) {
       std::string rescanRule =
-        cmStrCat("$(CMAKE_COMMAND) -P ",
+        cmStrCat("$(CMAKE_COMMAND) -E cmake_verify_globs ",
                  this->ConvertToOutputFormat(cm->GetGlobVerifyScript(),
                                              cmOutputConverter::SHELL));
       commands.push_back(rescanRule);
@@ -1395,6 +1396,18 @@ bool cmLocalUnixMakefileGenerator3::UpdateDependencies(
     cmSystemTools::Error("Target DependInfo.cmake file not found");
   }
 
+  // Share the times of files outside the source and build trees with the
+  // dependency scanning of the other targets of the build.  Files in these
+  // trees may be edited or generated while the build runs.
+  if (this->Makefile->IsOn("CMAKE_DEPENDS_SHARED_STAT_CACHE")) {
+    this->GlobalGenerator->GetCMakeInstance()
+      ->GetFileTimeCache()
+      ->EnableSharedCache(cmStrCat(this->GetBinaryDirectory(),
+                                   "/CMakeFiles/SharedFileTimes.bin"),
+                          { this->GetBinaryDirectory(),
+                            this->GetSourceDirectory() });
+  }
+
   bool status = true;
 
   // Check if any multiple output pairs have a missing file.
@@ -1532,17 +1545,16 @@ bool cmLocalUnixMakefileGenerator3::UpdateDependencies(
         return false;
       }
 
-      // Open the cmake dependency tracking file.  This should not be
+      // Open the cmake dependency database.  This should not be
       // copy-if-different because dependencies are re-scanned when it is
       // older than the DependInfo.cmake.
-      cmGeneratedFileStream internalRuleFileStream(
-        internalDepFile, false, this->GlobalGenerator->GetMakefileEncoding());
+      cmGeneratedFileStream internalRuleFileStream;
+      internalRuleFileStream.Open(internalDepFile, false, true);
       if (!internalRuleFileStream) {
         return false;
       }
 
       this->WriteDisclaimer(ruleFileStream);
-      this->WriteDisclaimer(internalRuleFileStream);
 
       depsManager.WriteDependencies(dependencies, ruleFileStream,
                                     internalRuleFileStream);
@@ -1857,7 +1869,7 @@ void cmLocalUnixMakefileGenerator3::WriteLocalAllRules(
     cmake* cm = this->GlobalGenerator->GetCMakeInstance();
     if (cm->DoWriteGlobVerifyTarget()) {
       std::string rescanRule =
-        cmStrCat("$(CMAKE_COMMAND) -P ",
+        cmStrCat("$(CMAKE_COMMAND) -E cmake_verify_globs ",
                  this->ConvertToOutputFormat(cm->GetGlobVerifyScript(),
                                              cmOutputConverter::SHELL));
       commands.push_back(rescanRule);
@@ -1958,6 +1970,11 @@ void cmLocalUnixMakefileGenerator3::WriteDependLanguageInfo(
                         : "OFF")
                   << ")\n\n";
 
+  if (this->Makefile->IsOn("CMAKE_DEPENDS_SHARED_STAT_CACHE")) {
+    cmakefileStream << "# Share file times with other targets.\n"
+                       "set(CMAKE_DEPENDS_SHARED_STAT_CACHE ON)\n\n";
+  }
+
   bool requireFortran = false;
   if (target->HaveFortranSources(this->GetConfigName())) {
     requireFortran = true;
@@ -2076,6 +2093,12 @@ void cmLocalUnixMakefileGenerator3::WriteDependLanguageInfo(
     }
   }
 
+  this->WriteDependencyFilesInfo(cmakefileStream, target);
+}
+
+void cmLocalUnixMakefileGenerator3::WriteDependencyFilesInfo(
+  std::ostream& cmakefileStream, cmGeneratorTarget* target)
+{
   auto const& compilerLangs =
     this->GetImplicitDepends(target, cmDependencyScannerKind::Compiler);
 
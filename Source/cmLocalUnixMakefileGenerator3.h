@@ -211,6 +211,10 @@ protected:
   void WriteDependLanguageInfo(std::ostream& cmakefileStream,
                                cmGeneratorTarget* tgt);
 
+  // write the list of dependency files generated by the compiler
+  void WriteDependencyFilesInfo(std::ostream& cmakefileStream,
+                                cmGeneratorTarget* tgt);
+
   // this converts a file name that is relative to the StartOutputDirectory
   // into a full path
   std::string ConvertToFullPath(std::string const& localPath);
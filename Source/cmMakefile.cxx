@@ -11,6 +11,7 @@
 #include <cstdlib>
 #include <cstring>
 #include <sstream>
+#include <thread>
 #include <utility>
 
 #include <cm/iterator>
@@ -24,6 +25,7 @@
 #ifndef CMAKE_BOOTSTRAP
 #  include <cm3p/json/value.h>
 #  include <cm3p/json/writer.h>
+#  include <cm3p/uv.h>
 #endif
 
 #include "cmsys/FStream.hxx"
@@ -47,6 +49,7 @@
 #include "cmListFileCache.h"
 #include "cmLocalGenerator.h"
 #include "cmMessageType.h"
+#include "cmPropertyMap.h"
 #include "cmRange.h"
 #include "cmSourceFile.h"
 #include "cmSourceFileLocation.h"
@@ -60,6 +63,7 @@
 #include "cmTargetLinkLibraryType.h"
 #include "cmTest.h"
 #include "cmTestGenerator.h" // IWYU pragma: keep
+#include "cmTryCompileBatch.h"
 #include "cmVersion.h"
 #include "cmWorkingDirectory.h"
 #include "cmake.h"
@@ -461,6 +465,128 @@ cmMakefile* cmMakefile::CallRAII::Detach()
   return mf;
 }
 
+struct cmListFileFunction::Compiled
+{
+  // The command resolved from the name of the call.  It is current while
+  // the commands of the state have the recorded generation.
+  cmState::CommandPtr Command;
+  unsigned long long CommandGeneration = 0;
+
+  // An argument split into the parts substituted on each call.
+  struct Argument
+  {
+    enum class Form
+    {
+      // The values are the final arguments, split into a list already if
+      // the argument is unquoted.
+      Literal,
+      // The values alternate literal text and names of variables to
+      // substitute, starting and ending with text.
+      Variables,
+      // The argument needs a full expansion.
+      Expand
+    };
+    Form Type = Form::Expand;
+    std::vector<std::string> Values;
+  };
+
+  // The arguments are compiled when the call runs a second time, so that
+  // code run only once does not pay for it.
+  std::vector<Argument> Arguments;
+  bool ArgumentsCompiled = false;
+};
+
+namespace {
+bool IsVariableNameChar(char c)
+{
+  return isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '/' ||
+    c == '.' || c == '+' || c == '-';
+}
+
+cmListFileFunction::Compiled::Argument CompileArgument(
+  cmListFileArgument const& arg)
+{
+  using Argument = cmListFileFunction::Compiled::Argument;
+  Argument compiled;
+  if (arg.Delim == cmListFileArgument::Bracket) {
+    compiled.Type = Argument::Form::Literal;
+    compiled.Values.push_back(arg.Value);
+    return compiled;
+  }
+
+  // Split off plain ${VAR} references and resolve escapes.  Leave
+  // everything else that ExpandVariablesInString treats specially to a
+  // full expansion: invalid escapes, nested references, environment and
+  // cache references, and the line number the expansion computes.
+  std::string const& value = arg.Value;
+  std::vector<std::string> parts;
+  std::string text;
+  for (std::string::size_type i = 0; i < value.size(); ++i) {
+    char const c = value[i];
+    if (c == '\0') {
+      return compiled;
+    }
+    if (c == '\\') {
+      if (i + 1 == value.size()) {
+        return compiled;
+      }
+      char const next = value[++i];
+      if (next == 't') {
+        text += '\t';
+      } else if (next == 'n') {
+        text += '\n';
+      } else if (next == 'r') {
+        text += '\r';
+      } else if (next == ';') {
+        // Keep the escape for the list expansion.
+        text += "\\;";
+      } else if (isalnum(static_cast<unsigned char>(next))) {
+        return compiled;
+      } else {
+        text += next;
+      }
+      continue;
+    }
+    if (c == '$' && i + 1 < value.size() && value[i + 1] != '<') {
+      if (value[i + 1] != '{') {
+        return compiled;
+      }
+      std::string::size_type const start = i + 2;
+      std::string::size_type end = start;
+      while (end < value.size() && IsVariableNameChar(value[end])) {
+        ++end;
+      }
+      if (end == value.size() || value[end] != '}') {
+        return compiled;
+      }
+      std::string name = value.substr(start, end - start);
+      if (name == "CMAKE_CURRENT_LIST_LINE"_s) {
+        return compiled;
+      }
+      parts.emplace_back(std::move(text));
+      parts.emplace_back(std::move(name));
+      text.clear();
+      i = end;
+      continue;
+    }
+    text += c;
+  }
+
+  if (!parts.empty()) {
+    parts.emplace_back(std::move(text));
+    compiled.Type = Argument::Form::Variables;
+    compiled.Values = std::move(parts);
+  } else if (arg.Delim == cmListFileArgument::Quoted) {
+    compiled.Type = Argument::Form::Literal;
+    compiled.Values.emplace_back(std::move(text));
+  } else {
+    compiled.Type = Argument::Form::Literal;
+    cmExpandList(text, compiled.Values);
+  }
+  return compiled;
+}
+}
+
 // Helper class to make sure the call stack is valid.
 class cmMakefile::CallScope : public CallRAII
 {
@@ -478,7 +604,9 @@ public:
   CallScope(cmMakefile* mf, cmListFileFunction const& lff,
             cmListFileContext const& lfc, cmExecutionStatus& status)
     : CallRAII{ mf, lfc, status }
+    , OuterFunction{ mf->ExecutingFunction }
   {
+    mf->ExecutingFunction = &lff;
 #if !defined(CMAKE_BOOTSTRAP)
     this->ProfilingDataRAII =
       this->Makefile->GetCMakeInstance()->CreateProfilingEntry(
@@ -510,6 +638,7 @@ public:
     this->ProfilingDataRAII.reset();
 #endif
     auto* const mf = this->Detach();
+    mf->ExecutingFunction = this->OuterFunction;
 #ifdef CMake_ENABLE_DEBUGGER
     if (mf->GetCMakeInstance()->GetDebugAdapter()) {
       mf->GetCMakeInstance()->GetDebugAdapter()->OnEndFunctionCall();
@@ -523,6 +652,7 @@ public:
   CallScope& operator=(CallScope const&) = delete;
 
 private:
+  cmListFileFunction const* OuterFunction;
 #if !defined(CMAKE_BOOTSTRAP)
   cm::optional<cmMakefileProfilingData::RAII> ProfilingDataRAII;
 #endif
@@ -560,8 +690,7 @@ bool cmMakefile::ExecuteCommand(cmListFileFunction const& lff,
   }
 
   // Lookup the command prototype.
-  if (cmState::Command command =
-        this->GetState()->GetCommandByExactName(lff.LowerCaseName())) {
+  if (cmState::CommandPtr command = this->CompileFunction(lff).Command) {
     // Decide whether to invoke the command.
     if (!cmSystemTools::GetFatalErrorOccurred()) {
       // if trace is enabled, print out invoke information
@@ -569,7 +698,7 @@ bool cmMakefile::ExecuteCommand(cmListFileFunction const& lff,
         this->PrintCommandTrace(lff, this->Backtrace);
       }
       // Try invoking the command.
-      bool invokeSucceeded = command(lff.Arguments(), status);
+      bool invokeSucceeded = (*command)(lff.Arguments(), status);
       bool hadNestedError = status.GetNestedError();
       if (!invokeSucceeded || hadNestedError) {
         if (!hadNestedError) {
@@ -608,6 +737,64 @@ bool cmMakefile::ExecuteCommand(cmListFileFunction const& lff,
   return result;
 }
 
+cmListFileFunction::Compiled& cmMakefile::CompileFunction(
+  cmListFileFunction const& lff)
+{
+  cmListFileFunction::Compiled* compiled = lff.GetCompiled();
+  if (!compiled) {
+    auto newCompiled = std::make_shared<cmListFileFunction::Compiled>();
+    compiled = newCompiled.get();
+    lff.SetCompiled(std::move(newCompiled));
+  } else if (!compiled->ArgumentsCompiled) {
+    compiled->Arguments.reserve(lff.Arguments().size());
+    for (cmListFileArgument const& arg : lff.Arguments()) {
+      compiled->Arguments.emplace_back(CompileArgument(arg));
+    }
+    compiled->ArgumentsCompiled = true;
+  }
+
+  // Resolve the command again only after commands have been defined.
+  cmState const* state = this->GetState();
+  if (compiled->CommandGeneration != state->GetCommandGeneration()) {
+    compiled->Command = state->GetCommandPtrByExactName(lff.LowerCaseName());
+    compiled->CommandGeneration = state->GetCommandGeneration();
+  }
+  return *compiled;
+}
+
+cmListFileFunction::Compiled const* cmMakefile::GetCompiledArguments(
+  std::vector<cmListFileArgument> const& args) const
+{
+  // Commands get the arguments of their call, but may also expand other
+  // arguments, such as those recorded for a loop condition.
+  if (!this->ExecutingFunction ||
+      &this->ExecutingFunction->Arguments() != &args) {
+    return nullptr;
+  }
+  cmListFileFunction::Compiled const* compiled =
+    this->ExecutingFunction->GetCompiled();
+  if (!compiled || !compiled->ArgumentsCompiled) {
+    return nullptr;
+  }
+  return compiled;
+}
+
+void cmMakefile::SubstituteVariables(std::vector<std::string> const& parts,
+                                     std::string const& filename,
+                                     std::string& value) const
+{
+  value.clear();
+  for (std::size_t i = 0; i < parts.size(); ++i) {
+    if (i % 2 == 0) {
+      value += parts[i];
+    } else if (cmValue def = this->GetDefinition(parts[i])) {
+      value += *def;
+    } else {
+      this->MaybeWarnUninitialized(parts[i], filename.c_str());
+    }
+  }
+}
+
 bool cmMakefile::IsImportedTargetGlobalScope() const
 {
   return this->CurrentImportedTargetScope == ImportedTargetScope::Global;
@@ -680,7 +867,8 @@ bool cmMakefile::ReadDependentFile(std::string const& filename,
 
   cmListFile listFile;
   if (!listFile.ParseFile(filenametoread.c_str(), this->GetMessenger(),
-                          this->Backtrace)) {
+                          this->Backtrace,
+                          this->GetCMakeInstance()->GetListFileCache())) {
 #ifdef CMake_ENABLE_DEBUGGER
     if (this->GetCMakeInstance()->GetDebugAdapter()) {
       this->GetCMakeInstance()->GetDebugAdapter()->OnEndFileParse();
@@ -803,7 +991,8 @@ bool cmMakefile::ReadListFile(std::string const& filename)
 
   cmListFile listFile;
   if (!listFile.ParseFile(filenametoread.c_str(), this->GetMessenger(),
-                          this->Backtrace)) {
+                          this->Backtrace,
+                          this->GetCMakeInstance()->GetListFileCache())) {
 #ifdef CMake_ENABLE_DEBUGGER
     if (this->GetCMakeInstance()->GetDebugAdapter()) {
       this->GetCMakeInstance()->GetDebugAdapter()->OnEndFileParse();
@@ -1581,7 +1770,8 @@ void cmMakefile::Configure()
 
   cmListFile listFile;
   if (!listFile.ParseFile(currentStart.c_str(), this->GetMessenger(),
-                          this->Backtrace)) {
+                          this->Backtrace,
+                          this->GetCMakeInstance()->GetListFileCache())) {
 #ifdef CMake_ENABLE_DEBUGGER
     if (this->GetCMakeInstance()->GetDebugAdapter()) {
       this->GetCMakeInstance()->GetDebugAdapter()->OnEndFileParse();
@@ -1677,6 +1867,10 @@ void cmMakefile::Configure()
   this->Defer = cm::make_unique<DeferCommands>();
   this->RunListFile(listFile, currentStart, this->Defer.get());
   this->Defer.reset();
+  if (this->TryCompileBatch) {
+    // Set the results of asynchronous checks not waited for explicitly.
+    this->TryCompileBatch->Wait();
+  }
   if (cmSystemTools::GetFatalErrorOccurred()) {
     scope.Quiet();
   }
@@ -1692,6 +1886,41 @@ void cmMakefile::Configure()
   }
 
   this->AddCMakeDependFilesFromUser();
+
+#ifndef CMAKE_BOOTSTRAP
+  if (this->GetCMakeInstance()->IsProfilingEnabled()) {
+    MemoryUsage const usage = this->GetMemoryUsage();
+    Json::Value counters = Json::objectValue;
+    counters["variables"] = static_cast<Json::UInt64>(usage.Variables);
+    counters["directory_properties"] =
+      static_cast<Json::UInt64>(usage.DirectoryProperties);
+    counters["target_properties"] =
+      static_cast<Json::UInt64>(usage.TargetProperties);
+    std::size_t rss = 0;
+    if (uv_resident_set_memory(&rss) == 0) {
+      counters["rss"] = static_cast<Json::UInt64>(rss);
+    }
+    std::string dir = cmSystemTools::RelativePath(
+      this->GetHomeDirectory(), this->GetCurrentSourceDirectory());
+    if (dir.empty()) {
+      dir = ".";
+    }
+    this->GetCMakeInstance()->GetProfilingOutput().CounterEntry(
+      "configure", cmStrCat("memory ", dir), std::move(counters));
+  }
+#endif
+}
+
+cmMakefile::MemoryUsage cmMakefile::GetMemoryUsage() const
+{
+  MemoryUsage usage;
+  usage.Variables = this->StateSnapshot.GetDefinitionsMemoryUsage();
+  usage.DirectoryProperties =
+    this->StateSnapshot.GetDirectory().GetMemoryUsage();
+  for (auto const& target : this->Targets) {
+    usage.TargetProperties += target.second.GetProperties().GetMemoryUsage();
+  }
+  return usage;
 }
 
 void cmMakefile::ConfigureSubDirectory(cmMakefile* mf)
@@ -2590,6 +2819,23 @@ MessageType cmMakefile::ExpandVariablesInStringImpl(
   // It also supports the $ENV{VAR} syntax where VAR is looked up in
   // the current environment variables.
 
+  // Most strings contain nothing to expand.  Look for the characters
+  // that start a reference or an escape with memchr, which is much
+  // faster than the scan below, and keep such strings unchanged.  The
+  // scan truncates a string at an embedded null character, so such a
+  // string is scanned too.
+  {
+    char const* data = source.data();
+    std::size_t const size = source.size();
+    bool const mayExpand = (!atOnly && std::memchr(data, '$', size)) ||
+      (!noEscapes && std::memchr(data, '\\', size)) ||
+      (replaceAt && std::memchr(data, '@', size)) ||
+      std::memchr(data, '\0', size);
+    if (!mayExpand) {
+      return MessageType::LOG;
+    }
+  }
+
   char const* in = source.c_str();
   char const* last = in;
   std::string result;
@@ -2963,19 +3209,33 @@ bool cmMakefile::IsLoopBlock() const
 bool cmMakefile::ExpandArguments(std::vector<cmListFileArgument> const& inArgs,
                                  std::vector<std::string>& outArgs) const
 {
+  using Form = cmListFileFunction::Compiled::Argument::Form;
+  cmListFileFunction::Compiled const* compiled =
+    this->GetCompiledArguments(inArgs);
   std::string const& filename = this->GetBacktrace().Top().FilePath;
   std::string value;
   outArgs.reserve(inArgs.size());
-  for (cmListFileArgument const& i : inArgs) {
+  for (std::size_t k = 0; k < inArgs.size(); ++k) {
+    cmListFileArgument const& i = inArgs[k];
+    Form const form = compiled ? compiled->Arguments[k].Type : Form::Expand;
+    if (form == Form::Literal) {
+      cm::append(outArgs, compiled->Arguments[k].Values);
+      continue;
+    }
     // No expansion in a bracket argument.
     if (i.Delim == cmListFileArgument::Bracket) {
       outArgs.push_back(i.Value);
       continue;
     }
     // Expand the variables in the argument.
-    value = i.Value;
-    this->ExpandVariablesInString(value, false, false, false, filename.c_str(),
-                                  i.Line, false, false);
+    if (form == Form::Variables) {
+      this->SubstituteVariables(compiled->Arguments[k].Values, filename,
+                                value);
+    } else {
+      value = i.Value;
+      this->ExpandVariablesInString(value, false, false, false,
+                                    filename.c_str(), i.Line, false, false);
+    }
 
     // If the argument is quoted, it should be one argument.
     // Otherwise, it may be a list of arguments.
@@ -2992,19 +3252,36 @@ bool cmMakefile::ExpandArguments(
   std::vector<cmListFileArgument> const& inArgs,
   std::vector<cmExpandedCommandArgument>& outArgs) const
 {
+  using Form = cmListFileFunction::Compiled::Argument::Form;
+  cmListFileFunction::Compiled const* compiled =
+    this->GetCompiledArguments(inArgs);
   std::string const& filename = this->GetBacktrace().Top().FilePath;
   std::string value;
   outArgs.reserve(inArgs.size());
-  for (cmListFileArgument const& i : inArgs) {
+  for (std::size_t k = 0; k < inArgs.size(); ++k) {
+    cmListFileArgument const& i = inArgs[k];
+    Form const form = compiled ? compiled->Arguments[k].Type : Form::Expand;
+    if (form == Form::Literal) {
+      bool const quoted = i.Delim != cmListFileArgument::Unquoted;
+      for (std::string const& v : compiled->Arguments[k].Values) {
+        outArgs.emplace_back(v, quoted);
+      }
+      continue;
+    }
     // No expansion in a bracket argument.
     if (i.Delim == cmListFileArgument::Bracket) {
       outArgs.emplace_back(i.Value, true);
       continue;
     }
     // Expand the variables in the argument.
-    value = i.Value;
-    this->ExpandVariablesInString(value, false, false, false, filename.c_str(),
-                                  i.Line, false, false);
+    if (form == Form::Variables) {
+      this->SubstituteVariables(compiled->Arguments[k].Values, filename,
+                                value);
+    } else {
+      value = i.Value;
+      this->ExpandVariablesInString(value, false, false, false,
+                                    filename.c_str(), i.Line, false, false);
+    }
 
     // If the argument is quoted, it should be one argument.
     // Otherwise, it may be a list of arguments.
@@ -3222,6 +3499,32 @@ int cmMakefile::TryCompile(std::string const& srcdir,
                            std::string const& targetName, bool fast, int jobs,
                            std::vector<std::string> const* cmakeArgs,
                            std::string& output)
+{
+  // unset the NINJA_STATUS environment variable while running try compile.
+  // since we parse the output, we need to ensure there aren't any unexpected
+  // characters that will cause issues, such as ANSI color escape codes.
+  cm::optional<cmSystemTools::ScopedEnv> maybeNinjaStatus;
+  if (this->GetGlobalGenerator()->IsNinja()) {
+    maybeNinjaStatus.emplace("NINJA_STATUS=");
+  }
+
+  int ret = this->GenerateTryCompile(srcdir, bindir, fast, cmakeArgs);
+  if (ret != 0) {
+    return ret;
+  }
+
+  // finally call the generator to actually build the resulting project
+  this->IsSourceFileTryCompile = fast;
+  ret = this->GetGlobalGenerator()->TryCompile(
+    jobs, srcdir, bindir, projectName, targetName, fast, output, this);
+
+  this->IsSourceFileTryCompile = false;
+  return ret;
+}
+
+int cmMakefile::GenerateTryCompile(std::string const& srcdir,
+                                   std::string const& bindir, bool fast,
+                                   std::vector<std::string> const* cmakeArgs)
 {
   this->IsSourceFileTryCompile = fast;
   // does the binary directory exist ? If not create it...
@@ -3239,14 +3542,6 @@ int cmMakefile::TryCompile(std::string const& srcdir,
     return 1;
   }
 
-  // unset the NINJA_STATUS environment variable while running try compile.
-  // since we parse the output, we need to ensure there aren't any unexpected
-  // characters that will cause issues, such as ANSI color escape codes.
-  cm::optional<cmSystemTools::ScopedEnv> maybeNinjaStatus;
-  if (this->GetGlobalGenerator()->IsNinja()) {
-    maybeNinjaStatus.emplace("NINJA_STATUS=");
-  }
-
   // make sure the same generator is used
   // use this program as the cmake to be run, it should not
   // be run that way but the cmake object requires a valid path
@@ -3346,12 +3641,19 @@ int cmMakefile::TryCompile(std::string const& srcdir,
     return 1;
   }
 
-  // finally call the generator to actually build the resulting project
-  int ret = this->GetGlobalGenerator()->TryCompile(
-    jobs, srcdir, bindir, projectName, targetName, fast, output, this);
-
   this->IsSourceFileTryCompile = false;
-  return ret;
+  return 0;
+}
+
+cmTryCompileBatch& cmMakefile::GetTryCompileBatch()
+{
+  if (!this->TryCompileBatch) {
+    unsigned int jobs = std::thread::hardware_concurrency();
+    this->TryCompileBatch = cm::make_unique<cmTryCompileBatch>(
+      jobs > 0 ? jobs : 1, this->GetState()->UseWatcomWMake(),
+      this->GetGlobalGenerator()->TryCompileTimeout);
+  }
+  return *this->TryCompileBatch;
 }
 
 bool cmMakefile::GetIsSourceFileTryCompile() const
@@ -61,6 +61,7 @@ class cmSourceFile;
 class cmState;
 class cmTest;
 class cmTestGenerator;
+class cmTryCompileBatch;
 class cmVariableWatch;
 class cmake;
 
@@ -135,6 +136,20 @@ public:
                  std::vector<std::string> const* cmakeArgs,
                  std::string& output);
 
+  /**
+   * Configure and generate a project like TryCompile, but leave building
+   * it to the caller.
+   */
+  int GenerateTryCompile(std::string const& srcdir, std::string const& bindir,
+                         bool fast, std::vector<std::string> const* cmakeArgs);
+
+  /**
+   * Get the builds of the asynchronous try_compile checks of this
+   * directory.  They are waited for at the latest when the directory is
+   * configured.
+   */
+  cmTryCompileBatch& GetTryCompileBatch();
+
   bool GetIsSourceFileTryCompile() const;
 
   /**
@@ -1014,6 +1029,16 @@ public:
 
   cmStateSnapshot GetStateSnapshot() const;
 
+  /** Estimated bytes held by the state of this directory, not counting
+      the strings shared with the pool of the state.  */
+  struct MemoryUsage
+  {
+    std::size_t Variables = 0;
+    std::size_t DirectoryProperties = 0;
+    std::size_t TargetProperties = 0;
+  };
+  MemoryUsage GetMemoryUsage() const;
+
   void EnforceDirectoryLevelRules() const;
 
   void AddEvaluationFile(
@@ -1170,6 +1195,18 @@ private:
                         std::string const& binPath) const;
 
   std::function<void()> ExecuteCommandCallback;
+
+  // The call whose command is running.  Its arguments may be expanded
+  // using its compiled form.
+  cmListFileFunction const* ExecutingFunction = nullptr;
+  cmListFileFunction::Compiled& CompileFunction(
+    cmListFileFunction const& lff);
+  cmListFileFunction::Compiled const* GetCompiledArguments(
+    std::vector<cmListFileArgument> const& args) const;
+  void SubstituteVariables(std::vector<std::string> const& parts,
+                           std::string const& filename,
+                           std::string& value) const;
+
   using FunctionBlockerPtr = std::unique_ptr<cmFunctionBlocker>;
   using FunctionBlockersType =
     std::stack<FunctionBlockerPtr, std::vector<FunctionBlockerPtr>>;
@@ -1246,5 +1283,6 @@ private:
   std::set<std::string> WarnedCMP0074;
   std::set<std::string> WarnedCMP0144;
   bool IsSourceFileTryCompile;
+  std::unique_ptr<cmTryCompileBatch> TryCompileBatch;
   ImportedTargetScope CurrentImportedTargetScope = ImportedTargetScope::Local;
 };
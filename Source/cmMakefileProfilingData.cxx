@@ -106,6 +106,41 @@ void cmMakefileProfilingData::StopEntry()
   }
 }
 
+void cmMakefileProfilingData::CounterEntry(std::string const& category,
+                                           std::string const& name,
+                                           Json::Value values)
+{
+  /* Do not try again if we previously failed to write to output. */
+  if (!this->ProfileStream.good()) {
+    return;
+  }
+
+  try {
+    if (this->ProfileStream.tellp() > 1) {
+      this->ProfileStream << ",";
+    }
+    cmsys::SystemInformation info;
+    Json::Value v;
+    v["ph"] = "C";
+    v["name"] = name;
+    v["cat"] = category;
+    v["ts"] = static_cast<Json::Value::UInt64>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count());
+    v["pid"] = static_cast<int>(info.GetProcessId());
+    v["tid"] = 0;
+    v["args"] = std::move(values);
+
+    this->JsonWriter->write(v, &this->ProfileStream);
+  } catch (std::ios_base::failure& fail) {
+    cmSystemTools::Error(
+      cmStrCat("Failed to write to profiling output: ", fail.what()));
+  } catch (...) {
+    cmSystemTools::Error("Error writing profiling output!");
+  }
+}
+
 cmMakefileProfilingData::RAII::RAII(cmMakefileProfilingData& data,
                                     std::string const& category,
                                     std::string const& name,
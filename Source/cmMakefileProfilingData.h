@@ -22,6 +22,8 @@ public:
   void StartEntry(std::string const& category, std::string const& name,
                   cm::optional<Json::Value> args = cm::nullopt);
   void StopEntry();
+  void CounterEntry(std::string const& category, std::string const& name,
+                    Json::Value values);
 
   class RAII
   {
@@ -17,9 +17,12 @@
 #include <cmext/algorithm>
 #include <cmext/string_view>
 
+#include "cmsys/FStream.hxx"
+
 #include "cm_codecvt_Encoding.hxx"
 
 #include "cmComputeLinkInformation.h"
+#include "cmCryptoHash.h"
 #include "cmCustomCommand.h"
 #include "cmCustomCommandGenerator.h"
 #include "cmFileSet.h"
@@ -192,6 +195,8 @@ void cmMakefileTargetGenerator::CreateRuleFile()
     return;
   }
   this->BuildFileStream->SetCopyIfDifferent(true);
+  this->BuildFileStream->SetBatch(
+    this->GlobalGenerator->GetGeneratedFileBatch());
   this->LocalGenerator->WriteDisclaimer(*this->BuildFileStream);
   if (this->GlobalGenerator->AllowDeleteOnError()) {
     std::vector<std::string> no_depends;
@@ -459,15 +464,19 @@ void cmMakefileTargetGenerator::WriteCommonCodeRules()
                                   compilerDependFile))
                            << "\n\n";
 
-    // Write an empty dependency file.
-    cmGeneratedFileStream depFileStream(
-      compilerDependFile, false, this->GlobalGenerator->GetMakefileEncoding());
-    depFileStream << "# Empty compiler generated dependencies file for "
-                  << this->GeneratorTarget->GetName() << ".\n"
-                  << "# This may be replaced when dependencies are built.\n";
-    // remove internal dependency file
-    cmSystemTools::RemoveFile(
-      cmStrCat(this->TargetBuildDirectoryFull, "/compiler_depend.internal"));
+    this->HasCompilerDependFile = true;
+    if (!cmSystemTools::FileExists(compilerDependFile)) {
+      // Write an empty dependency file.  Dependencies consolidated by a
+      // previous build are kept unless CheckCompilerDependFingerprint
+      // finds that they are out of date.
+      cmGeneratedFileStream depFileStream(
+        compilerDependFile, false,
+        this->GlobalGenerator->GetMakefileEncoding());
+      depFileStream
+        << "# Empty compiler generated dependencies file for "
+        << this->GeneratorTarget->GetName() << ".\n"
+        << "# This may be replaced when dependencies are built.\n";
+    }
 
     std::string compilerDependTimestamp =
       cmStrCat(this->TargetBuildDirectoryFull, "/compiler_depend.ts");
@@ -489,6 +498,7 @@ void cmMakefileTargetGenerator::WriteCommonCodeRules()
     // Write an empty dependency file.
     cmGeneratedFileStream legacyDepFileStream(
       dependFileNameFull, false, this->GlobalGenerator->GetMakefileEncoding());
+    legacyDepFileStream.SetCopyIfDifferent(true);
     legacyDepFileStream
       << "# Empty dependencies file for " << this->GeneratorTarget->GetName()
       << ".\n"
@@ -531,6 +541,8 @@ void cmMakefileTargetGenerator::WriteCommonCodeRules()
     return;
   }
   this->FlagFileStream->SetCopyIfDifferent(true);
+  this->FlagFileStream->SetBatch(
+    this->GlobalGenerator->GetGeneratedFileBatch());
   this->LocalGenerator->WriteDisclaimer(*this->FlagFileStream);
 
   // Include the flags for the target.
@@ -1422,6 +1434,49 @@ void cmMakefileTargetGenerator::WriteTargetLinkDependRules()
     this->GeneratorTarget->GetFullPath(this->GetConfigName()), depFile,
     cmDependencyScannerKind::Compiler);
 }
+void cmMakefileTargetGenerator::CheckCompilerDependFingerprint()
+{
+  // The dependencies consolidated from the compiler generated dependency
+  // files are updated incrementally by the build as long as the set of
+  // those files, and how they are read, stays the same.  Fingerprint
+  // these inputs so that an unrelated change does not force all of them
+  // to be read again after the build system is regenerated.
+  std::ostringstream inputs;
+  inputs << this->Makefile->IsOn("CMAKE_DEPENDS_IN_PROJECT_ONLY") << '\n';
+  this->LocalGenerator->WriteDependencyFilesInfo(inputs,
+                                                 this->GeneratorTarget);
+  std::string const fingerprint =
+    cmCryptoHash(cmCryptoHash::AlgoSHA256).HashString(inputs.str());
+
+  std::string const fingerprintFile =
+    cmStrCat(this->TargetBuildDirectoryFull, "/compiler_depend.fingerprint");
+  std::string previous;
+  {
+    cmsys::ifstream fin(fingerprintFile.c_str());
+    if (fin) {
+      std::getline(fin, previous);
+    }
+  }
+  if (previous == fingerprint) {
+    return;
+  }
+
+  // Write an empty dependency file.
+  std::string const compilerDependFile =
+    cmStrCat(this->TargetBuildDirectoryFull, "/compiler_depend.make");
+  cmGeneratedFileStream depFileStream(
+    compilerDependFile, false, this->GlobalGenerator->GetMakefileEncoding());
+  depFileStream << "# Empty compiler generated dependencies file for "
+                << this->GeneratorTarget->GetName() << ".\n"
+                << "# This may be replaced when dependencies are built.\n";
+  // remove internal dependency file
+  cmSystemTools::RemoveFile(
+    cmStrCat(this->TargetBuildDirectoryFull, "/compiler_depend.internal"));
+
+  cmGeneratedFileStream fingerprintStream(fingerprintFile);
+  fingerprintStream << fingerprint << '\n';
+}
+
 std::string cmMakefileTargetGenerator::GetClangTidyReplacementsFilePath(
   std::string const& directory, cmSourceFile const& source,
   std::string const& config) const
@@ -1456,6 +1511,8 @@ void cmMakefileTargetGenerator::WriteTargetDependRules()
     return;
   }
   this->InfoFileStream->SetCopyIfDifferent(true);
+  this->InfoFileStream->SetBatch(
+    this->GlobalGenerator->GetGeneratedFileBatch());
   this->LocalGenerator->WriteDependLanguageInfo(*this->InfoFileStream,
                                                 this->GeneratorTarget);
 
@@ -1521,6 +1578,10 @@ void cmMakefileTargetGenerator::WriteTargetDependRules()
   }
   /* clang-format on */
 
+  if (this->HasCompilerDependFile) {
+    this->CheckCompilerDependFingerprint();
+  }
+
   // and now write the rule to use it
   std::vector<std::string> depends;
   std::vector<std::string> commands;
@@ -2101,6 +2162,7 @@ void cmMakefileTargetGenerator::CreateLinkScript(
     cmStrCat(this->TargetBuildDirectoryFull, '/', name);
   cmGeneratedFileStream linkScriptStream(linkScriptName);
   linkScriptStream.SetCopyIfDifferent(true);
+  linkScriptStream.SetBatch(this->GlobalGenerator->GetGeneratedFileBatch());
   for (std::string const& link_command : link_commands) {
     // Do not write out empty commands or commands beginning in the
     // shell no-op ":".
@@ -82,6 +82,10 @@ protected:
   // write the depend rules for this target
   void WriteTargetDependRules();
 
+  // discard the consolidated compiler generated dependencies if the
+  // dependency files from which they are read changed
+  void CheckCompilerDependFingerprint();
+
   std::string GetClangTidyReplacementsFilePath(
     std::string const& directory, cmSourceFile const& source,
     std::string const& config) const override;
@@ -224,6 +228,9 @@ protected:
 
   bool CMP0113New = false;
 
+  // whether compiler_depend.make is included by the build file
+  bool HasCompilerDependFile = false;
+
   // the path to the directory the build file is in
   std::string TargetBuildDirectory;
   std::string TargetBuildDirectoryFull;
@@ -0,0 +1,21 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#pragma once
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstddef>
+#include <functional>
+#include <string>
+
+/** Estimate the bytes a string allocated outside of its own object.  */
+inline std::size_t cmHeapBytes(std::string const& str)
+{
+  // Short strings are stored within the object itself.
+  char const* object = reinterpret_cast<char const*>(&str);
+  std::less<char const*> less;
+  if (!less(str.data(), object) && less(str.data(), object + sizeof(str))) {
+    return 0;
+  }
+  return str.capacity() + 1;
+}
@@ -2174,6 +2174,10 @@ void cmNinjaTargetGenerator::WriteTargetDependInfo(std::string const& lang,
 
   std::string const tdin = this->GetTargetDependInfoPath(lang, config);
   cmGeneratedFileStream tdif(tdin);
+  // The collation step depends on this file, so leave it untouched when
+  // a regeneration does not change it.
+  tdif.SetCopyIfDifferent(true);
+  tdif.SetBatch(this->GetGlobalGenerator()->GetGeneratedFileBatch());
   tdif << tdi;
 }
 
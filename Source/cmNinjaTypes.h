@@ -48,6 +48,12 @@ public:
   {
   }
 
+  // Build statements hold many paths.  Move them instead of copying.
+  cmNinjaBuild(cmNinjaBuild const&) = delete;
+  cmNinjaBuild(cmNinjaBuild&&) = default;
+  cmNinjaBuild& operator=(cmNinjaBuild const&) = delete;
+  cmNinjaBuild& operator=(cmNinjaBuild&&) = default;
+
   std::string Comment;
   std::string Rule;
   cmNinjaDeps Outputs;
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cctype>
+#include <cstdint>
 #include <set>
 #include <vector>
 
@@ -14,6 +15,7 @@
 #endif
 
 #include "cmList.h"
+#include "cmPathTable.h"
 #include "cmState.h"
 #include "cmStateDirectory.h"
 #include "cmSystemTools.h"
@@ -25,6 +27,14 @@ bool PathEqOrSubDir(std::string const& a, std::string const& b)
   return (cmSystemTools::ComparePath(a, b) ||
           cmSystemTools::IsSubDirectory(a, b));
 }
+
+// Whether a string is a full path.  Relative paths, such as those of
+// object files, are mostly converted once for the target they belong to.
+bool IsSharedPath(cm::string_view str)
+{
+  return (!str.empty() && (str[0] == '/' || str[0] == '\\')) ||
+    (str.size() > 2 && str[1] == ':' && (str[2] == '/' || str[2] == '\\'));
+}
 }
 
 cmOutputConverter::cmOutputConverter(cmStateSnapshot const& snapshot)
@@ -198,17 +208,39 @@ std::string cmOutputConverter::ConvertToOutputFormat(cm::string_view source,
                                                      OutputFormat format,
                                                      bool useWatcomQuote) const
 {
-  std::string result(source);
-  // Convert it to an output path.
-  if (format == SHELL || format == NINJAMULTI) {
-    result = this->ConvertDirectorySeparatorsForShell(source);
-    result = this->EscapeForShell(result, true, false, useWatcomQuote,
-                                  format == NINJAMULTI);
-  } else if (format == RESPONSE) {
-    result =
-      this->EscapeForShell(result, false, false, useWatcomQuote, false, true);
+  auto convert = [this, format, useWatcomQuote](cm::string_view path) {
+    std::string result(path);
+    // Convert it to an output path.
+    if (format == SHELL || format == NINJAMULTI) {
+      result = this->ConvertDirectorySeparatorsForShell(path);
+      result = this->EscapeForShell(result, true, false, useWatcomQuote,
+                                    format == NINJAMULTI);
+    } else if (format == RESPONSE) {
+      result = this->EscapeForShell(result, false, false, useWatcomQuote,
+                                    false, true);
+    }
+    return result;
+  };
+  // The table lives as long as the generator, so keep only the full
+  // paths that other targets are likely to convert again.
+  if (!this->PathTable || !IsSharedPath(source)) {
+    return convert(source);
+  }
+
+  // The form is determined by the shell flags, the output format, and
+  // the conversion of directory separators.
+  std::uint32_t form = cmPathTable::ShellForm |
+    static_cast<std::uint32_t>(format) << 16 |
+    static_cast<std::uint32_t>(this->GetShellFlags(
+      format != RESPONSE, false, useWatcomQuote, format == NINJAMULTI,
+      format == RESPONSE));
+  if (this->GetState()->UseMSYSShell() && !this->LinkScriptShell) {
+    form |= 1u << 14;
   }
-  return result;
+  if (this->GetState()->UseWindowsShell()) {
+    form |= 1u << 15;
+  }
+  return this->PathTable->GetForm(source, form, convert);
 }
 
 std::string cmOutputConverter::ConvertDirectorySeparatorsForShell(
@@ -243,6 +275,17 @@ std::string cmOutputConverter::EscapeForShell(cm::string_view str,
                                               bool useWatcomQuote,
                                               bool unescapeNinjaConfiguration,
                                               bool forResponse) const
+{
+  return cmOutputConverter::EscapeForShell(
+    str,
+    this->GetShellFlags(makeVars, forEcho, useWatcomQuote,
+                        unescapeNinjaConfiguration, forResponse));
+}
+
+int cmOutputConverter::GetShellFlags(bool makeVars, bool forEcho,
+                                     bool useWatcomQuote,
+                                     bool unescapeNinjaConfiguration,
+                                     bool forResponse) const
 {
   // Compute the flags for the target shell environment.
   int flags = 0;
@@ -285,8 +328,7 @@ std::string cmOutputConverter::EscapeForShell(cm::string_view str,
     // Fastbuild needs to escape very few characters.
     flags = Shell_Flag_Fastbuild;
   }
-
-  return cmOutputConverter::EscapeForShell(str, flags);
+  return flags;
 }
 
 std::string cmOutputConverter::EscapeForShell(cm::string_view str, int flags)
@@ -10,6 +10,7 @@
 
 #include "cmStateSnapshot.h"
 
+class cmPathTable;
 class cmState;
 
 class cmOutputConverter
@@ -145,9 +146,15 @@ public:
 protected:
   cmStateSnapshot StateSnapshot;
 
+  // Converted forms of paths shared with other converters, if any.
+  cmPathTable* PathTable = nullptr;
+
 private:
   cmState* GetState() const;
 
+  int GetShellFlags(bool makeVars, bool forEcho, bool useWatcomQuote,
+                    bool unescapeNinjaConfiguration, bool forResponse) const;
+
   static bool Shell_CharNeedsQuotes(char c, int flags);
   static cm::string_view::iterator Shell_SkipMakeVariables(
     cm::string_view::iterator begin, cm::string_view::iterator end);
@@ -0,0 +1,15 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#include "cmPathTable.h"
+
+cmPathTable::Id cmPathTable::Intern(cm::string_view path)
+{
+  auto it = this->Ids.find(path);
+  if (it != this->Ids.end()) {
+    return it->second;
+  }
+  Id const id = this->Paths.size();
+  this->Paths.emplace_back(path);
+  this->Ids.emplace(this->Paths.back(), id);
+  return id;
+}
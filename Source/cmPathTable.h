@@ -0,0 +1,82 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#pragma once
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include <cm/string_view>
+
+/** \class cmPathTable
+ * \brief Intern paths and remember their converted forms.
+ *
+ * Generators convert the same paths over and over: every target that
+ * uses an include directory or depends on a library escapes its path for
+ * the build tool again.  The table gives each distinct path a stable id
+ * and remembers each form the path was converted to, such as a path
+ * relative to the build tree or a path escaped for the shell.  A form is
+ * identified by a number that must determine the conversion completely,
+ * so the table can be shared by all local generators of a global
+ * generator.
+ */
+class cmPathTable
+{
+public:
+  using Id = std::size_t;
+
+  /** Kinds of forms.  A shell form also holds the shell flags and output
+      format of cmOutputConverter in the low bits.  */
+  enum FormKind : std::uint32_t
+  {
+    NinjaPathForm = 1u << 24,
+    MakefilePathForm = 2u << 24,
+    ShellForm = 3u << 24,
+  };
+
+  /** Get the id of a path, adding the path to the table on first use.  */
+  Id Intern(cm::string_view path);
+
+  std::string const& GetPath(Id id) const { return this->Paths[id]; }
+
+  /** Get a form of a path.  On first use of the form with the path, the
+      form is computed by calling the given function with the path.  */
+  template <typename Convert>
+  std::string const& GetForm(Id id, std::uint32_t form, Convert&& convert)
+  {
+    std::uint64_t const key = (static_cast<std::uint64_t>(id) << 32) | form;
+    auto it = this->Forms.find(key);
+    if (it != this->Forms.end()) {
+      ++this->Hits;
+      return it->second;
+    }
+    ++this->Misses;
+    return this->Forms.emplace(key, convert(this->Paths[id])).first->second;
+  }
+
+  template <typename Convert>
+  std::string const& GetForm(cm::string_view path, std::uint32_t form,
+                             Convert&& convert)
+  {
+    return this->GetForm(this->Intern(path), form,
+                         std::forward<Convert>(convert));
+  }
+
+  std::size_t GetPathCount() const { return this->Paths.size(); }
+  std::size_t GetFormCount() const { return this->Forms.size(); }
+  unsigned long long GetHits() const { return this->Hits; }
+  unsigned long long GetMisses() const { return this->Misses; }
+
+private:
+  // A deque does not move its elements, so the ids may refer to them.
+  std::deque<std::string> Paths;
+  std::unordered_map<cm::string_view, Id> Ids;
+  std::unordered_map<std::uint64_t, std::string> Forms;
+  unsigned long long Hits = 0;
+  unsigned long long Misses = 0;
+};
@@ -5,6 +5,8 @@
 #include <algorithm>
 #include <utility>
 
+#include "cmMemoryUsage.h"
+
 void cmPropertyMap::Clear()
 {
   this->Map_.clear();
@@ -76,3 +78,15 @@ std::vector<std::pair<std::string, std::string>> cmPropertyMap::GetList() const
             });
   return kvList;
 }
+
+std::size_t cmPropertyMap::GetMemoryUsage() const
+{
+  using value_type = decltype(this->Map_)::value_type;
+  std::size_t bytes =
+    this->Map_.size() * (sizeof(value_type) + 2 * sizeof(void*)) +
+    this->Map_.bucket_count() * sizeof(void*);
+  for (auto const& item : this->Map_) {
+    bytes += cmHeapBytes(item.first) + cmHeapBytes(item.second);
+  }
+  return bytes;
+}
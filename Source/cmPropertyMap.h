@@ -4,6 +4,7 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <cstddef>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -49,6 +50,9 @@ public:
   //! Get a sorted by key list of property key,value pairs
   std::vector<std::pair<std::string, std::string>> GetList() const;
 
+  //! Estimate the bytes held by the map
+  std::size_t GetMemoryUsage() const;
+
 private:
   std::unordered_map<std::string, std::string> Map_;
 };
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <cstdlib>
 #include <utility>
@@ -31,12 +32,19 @@ namespace cmStateDetail {
 std::string const PropertySentinel = std::string{};
 } // namespace cmStateDetail
 
+static unsigned long long NewCommandGeneration()
+{
+  static std::atomic<unsigned long long> lastGeneration{ 0 };
+  return ++lastGeneration;
+}
+
 cmState::cmState(Mode mode, ProjectKind projectKind)
   : StateMode(mode)
   , StateProjectKind(projectKind)
 {
   this->CacheManager = cm::make_unique<cmCacheManager>();
   this->GlobVerificationManager = cm::make_unique<cmGlobVerificationManager>();
+  this->CommandGeneration = NewCommandGeneration();
 }
 
 cmState::~cmState() = default;
@@ -251,6 +259,13 @@ void cmState::AddGlobCacheEntry(cmGlobCacheEntry const& entry,
                                                messenger);
 }
 
+void cmState::AddGlobDirectories(std::string const& expression,
+                                 bool recurse, bool followSymlinks)
+{
+  this->GlobVerificationManager->AddDirectories(
+    this->GetBinaryDirectory(), expression, recurse, followSymlinks);
+}
+
 std::vector<cmGlobCacheEntry> cmState::GetGlobCacheEntries() const
 {
   return this->GlobVerificationManager->GetCacheEntries();
@@ -302,17 +317,17 @@ cmStateSnapshot cmState::Reset()
   assert(pos->PolicyRoot.IsValid());
 
   {
-    std::string srcDir =
-      *cmDefinitions::Get("CMAKE_SOURCE_DIR", pos->Vars, pos->Root);
-    std::string binDir =
-      *cmDefinitions::Get("CMAKE_BINARY_DIR", pos->Vars, pos->Root);
+    std::string srcDir = *cmDefinitions::Get("CMAKE_SOURCE_DIR", pos->Vars,
+                                             pos->Root, this->VarTreeEpoch);
+    std::string binDir = *cmDefinitions::Get("CMAKE_BINARY_DIR", pos->Vars,
+                                             pos->Root, this->VarTreeEpoch);
     this->VarTree.Clear();
     pos->Vars = this->VarTree.Push(this->VarTree.Root());
     pos->Parent = this->VarTree.Root();
     pos->Root = this->VarTree.Root();
 
-    pos->Vars->Set("CMAKE_SOURCE_DIR", srcDir);
-    pos->Vars->Set("CMAKE_BINARY_DIR", binDir);
+    pos->Vars->Set("CMAKE_SOURCE_DIR", srcDir, this->StringPool);
+    pos->Vars->Set("CMAKE_BINARY_DIR", binDir, this->StringPool);
   }
 
   this->DefineProperty("RULE_LAUNCH_COMPILE", cmProperty::DIRECTORY, "", "",
@@ -400,7 +415,9 @@ void cmState::AddBuiltinCommand(std::string const& name, Command command)
 {
   assert(name == cmSystemTools::LowerCase(name));
   assert(this->BuiltinCommands.find(name) == this->BuiltinCommands.end());
-  this->BuiltinCommands.emplace(name, std::move(command));
+  this->BuiltinCommands.emplace(
+    name, std::make_shared<Command const>(std::move(command)));
+  this->CommandGeneration = NewCommandGeneration();
 }
 
 static bool InvokeBuiltinCommand(cmState::BuiltinCommand command,
@@ -524,11 +541,13 @@ bool cmState::AddScriptedCommand(std::string const& name, BT<Command> command,
   }
 
   // if the command already exists, give a new name to the old command.
-  if (Command oldCmd = this->GetCommandByExactName(sName)) {
-    this->ScriptedCommands["_" + sName] = oldCmd;
+  if (CommandPtr oldCmd = this->GetCommandPtrByExactName(sName)) {
+    this->ScriptedCommands["_" + sName] = std::move(oldCmd);
   }
 
-  this->ScriptedCommands[sName] = std::move(command.Value);
+  this->ScriptedCommands[sName] =
+    std::make_shared<Command const>(std::move(command.Value));
+  this->CommandGeneration = NewCommandGeneration();
   return true;
 }
 
@@ -538,6 +557,15 @@ cmState::Command cmState::GetCommand(std::string const& name) const
 }
 
 cmState::Command cmState::GetCommandByExactName(std::string const& name) const
+{
+  if (CommandPtr command = this->GetCommandPtrByExactName(name)) {
+    return *command;
+  }
+  return nullptr;
+}
+
+cmState::CommandPtr cmState::GetCommandPtrByExactName(
+  std::string const& name) const
 {
   auto pos = this->ScriptedCommands.find(name);
   if (pos != this->ScriptedCommands.end()) {
@@ -571,11 +599,13 @@ void cmState::RemoveBuiltinCommand(std::string const& name)
 {
   assert(name == cmSystemTools::LowerCase(name));
   this->BuiltinCommands.erase(name);
+  this->CommandGeneration = NewCommandGeneration();
 }
 
 void cmState::RemoveUserDefinedCommands()
 {
   this->ScriptedCommands.clear();
+  this->CommandGeneration = NewCommandGeneration();
 }
 
 void cmState::SetGlobalProperty(std::string const& prop,
@@ -814,6 +844,13 @@ unsigned int cmState::GetCacheMinorVersion() const
   return this->CacheManager->GetCacheMinorVersion();
 }
 
+void cmState::GetCacheSidecarCounts(unsigned long& sidecarLoads,
+                                    unsigned long& textLoads) const
+{
+  sidecarLoads = this->CacheManager->GetSidecarLoads();
+  textLoads = this->CacheManager->GetTextLoads();
+}
+
 cmState::Mode cmState::GetMode() const
 {
   return this->StateMode;
@@ -24,6 +24,7 @@
 #include "cmPropertyMap.h"
 #include "cmStatePrivate.h"
 #include "cmStateTypes.h"
+#include "cmStringPool.h"
 #include "cmValue.h"
 
 class cmCacheManager;
@@ -157,6 +158,9 @@ public:
   bool IsPropertyChained(std::string const& name,
                          cmProperty::ScopeType scope) const;
 
+  /** Get the pool sharing the storage of variable names and values.  */
+  cmStringPool& GetStringPool() { return this->StringPool; }
+
   void SetLanguageEnabled(std::string const& l);
   bool GetLanguageEnabled(std::string const& l) const;
   std::vector<std::string> GetEnabledLanguages() const;
@@ -170,11 +174,22 @@ public:
                                      cmExecutionStatus&)>;
   using BuiltinCommand = bool (*)(std::vector<std::string> const&,
                                   cmExecutionStatus&);
+  using CommandPtr = std::shared_ptr<Command const>;
 
   // Returns a command from its name, case insensitive, or nullptr
   Command GetCommand(std::string const& name) const;
   // Returns a command from its name, or nullptr
   Command GetCommandByExactName(std::string const& name) const;
+  // Returns a command from its name, or nullptr.  The command stays
+  // alive while it runs even if it is redefined.
+  CommandPtr GetCommandPtrByExactName(std::string const& name) const;
+  // Returns a number that changes whenever commands are added or removed.
+  // No two states ever have the same number, so a command looked up by
+  // name is still current while the number is unchanged.
+  unsigned long long GetCommandGeneration() const
+  {
+    return this->CommandGeneration;
+  }
 
   void AddBuiltinCommand(std::string const& name, Command command);
   void AddBuiltinCommand(std::string const& name, BuiltinCommand command);
@@ -230,6 +245,8 @@ public:
 
   unsigned int GetCacheMajorVersion() const;
   unsigned int GetCacheMinorVersion() const;
+  void GetCacheSidecarCounts(unsigned long& sidecarLoads,
+                             unsigned long& textLoads) const;
 
   Mode GetMode() const;
   std::string GetModeString() const;
@@ -270,12 +287,15 @@ private:
                          std::string const& variable,
                          cmListFileBacktrace const& bt,
                          cmMessenger* messenger);
+  void AddGlobDirectories(std::string const& expression, bool recurse,
+                          bool followSymlinks);
   std::vector<cmGlobCacheEntry> GetGlobCacheEntries() const;
 
   cmPropertyDefinitionMap PropertyDefinitions;
   std::vector<std::string> EnabledLanguages;
-  std::unordered_map<std::string, Command> BuiltinCommands;
-  std::unordered_map<std::string, Command> ScriptedCommands;
+  std::unordered_map<std::string, CommandPtr> BuiltinCommands;
+  std::unordered_map<std::string, CommandPtr> ScriptedCommands;
+  unsigned long long CommandGeneration;
   std::unordered_set<std::string> FlowControlCommands;
   cmPropertyMap GlobalProperties;
   std::unique_ptr<cmCacheManager> CacheManager;
@@ -288,7 +308,10 @@ private:
 
   cmLinkedTree<cmStateDetail::PolicyStackEntry> PolicyStack;
   cmLinkedTree<cmStateDetail::SnapshotDataType> SnapshotData;
+  cmStringPool StringPool;
   cmLinkedTree<cmDefinitions> VarTree;
+  // Changed to invalidate the lookups cached by variable scopes.
+  std::size_t VarTreeEpoch = 1;
 
   std::string SourceDirectory;
   std::string BinaryDirectory;
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <vector>
 
 #include <cm/iterator>
@@ -15,6 +16,7 @@
 #include "cmAlgorithms.h"
 #include "cmList.h"
 #include "cmListFileCache.h"
+#include "cmMemoryUsage.h"
 #include "cmProperty.h"
 #include "cmPropertyMap.h"
 #include "cmRange.h"
@@ -454,6 +456,23 @@ std::vector<std::string> cmStateDirectory::GetPropertyKeys() const
   return this->DirectoryState->Properties.GetKeys();
 }
 
+std::size_t cmStateDirectory::GetMemoryUsage() const
+{
+  auto entriesBytes = [](std::vector<BT<std::string>> const& entries) {
+    std::size_t bytes = entries.capacity() * sizeof(BT<std::string>);
+    for (BT<std::string> const& entry : entries) {
+      bytes += cmHeapBytes(entry.Value);
+    }
+    return bytes;
+  };
+  auto const& state = *this->DirectoryState;
+  return state.Properties.GetMemoryUsage() +
+    entriesBytes(state.IncludeDirectories) +
+    entriesBytes(state.CompileDefinitions) +
+    entriesBytes(state.CompileOptions) + entriesBytes(state.LinkOptions) +
+    entriesBytes(state.LinkDirectories);
+}
+
 void cmStateDirectory::AddNormalTargetName(std::string const& name)
 {
   this->DirectoryState->NormalTargetNames.push_back(name);
@@ -72,6 +72,9 @@ public:
   bool GetPropertyAsBool(std::string const& prop) const;
   std::vector<std::string> GetPropertyKeys() const;
 
+  /** Estimate the bytes held by the properties of the directory.  */
+  std::size_t GetMemoryUsage() const;
+
   void AddNormalTargetName(std::string const& name);
   void AddImportedTargetName(std::string const& name);
 
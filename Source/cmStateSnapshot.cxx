@@ -227,7 +227,8 @@ cmPolicies::PolicyStatus cmStateSnapshot::GetPolicy(cmPolicies::PolicyID id,
 cmValue cmStateSnapshot::GetDefinition(std::string const& name) const
 {
   assert(this->Position->Vars.IsValid());
-  return cmDefinitions::Get(name, this->Position->Vars, this->Position->Root);
+  return cmDefinitions::Get(name, this->Position->Vars, this->Position->Root,
+                            this->State->VarTreeEpoch);
 }
 
 bool cmStateSnapshot::IsInitialized(std::string const& name) const
@@ -239,12 +240,24 @@ bool cmStateSnapshot::IsInitialized(std::string const& name) const
 void cmStateSnapshot::SetDefinition(std::string const& name,
                                     cm::string_view value)
 {
-  this->Position->Vars->Set(name, value);
+  this->Position->Vars->Set(name, value, this->State->GetStringPool());
+  this->DefinitionChanged();
 }
 
 void cmStateSnapshot::RemoveDefinition(std::string const& name)
 {
-  this->Position->Vars->Unset(name);
+  this->Position->Vars->Unset(name, this->State->GetStringPool());
+  this->DefinitionChanged();
+}
+
+void cmStateSnapshot::DefinitionChanged()
+{
+  // Nested scopes cache the definitions they read from this scope.
+  // Only the current scope of a directory has no nested scopes.
+  if (this->Position->Vars !=
+      this->Position->BuildSystemDirectory->CurrentScope->Vars) {
+    ++this->State->VarTreeEpoch;
+  }
 }
 
 std::vector<std::string> cmStateSnapshot::ClosureKeys() const
@@ -253,6 +266,11 @@ std::vector<std::string> cmStateSnapshot::ClosureKeys() const
                                     this->Position->Root);
 }
 
+std::size_t cmStateSnapshot::GetDefinitionsMemoryUsage() const
+{
+  return this->Position->Vars->GetMemoryUsage();
+}
+
 bool cmStateSnapshot::RaiseScope(std::string const& var, char const* varDef)
 {
   if (this->Position->ScopeParent == this->Position->DirectoryParent) {
@@ -271,13 +289,15 @@ bool cmStateSnapshot::RaiseScope(std::string const& var, char const* varDef)
     return true;
   }
   // First localize the definition in the current scope.
-  cmDefinitions::Raise(var, this->Position->Vars, this->Position->Root);
+  cmStringPool& pool = this->State->GetStringPool();
+  cmDefinitions::Raise(var, this->Position->Vars, this->Position->Root,
+                       this->State->VarTreeEpoch, pool);
 
   // Now update the definition in the parent scope.
   if (varDef) {
-    this->Position->Parent->Set(var, varDef);
+    this->Position->Parent->Set(var, varDef, pool);
   } else {
-    this->Position->Parent->Unset(var);
+    this->Position->Parent->Unset(var, pool);
   }
   return true;
 }
@@ -5,6 +5,7 @@
 
 #include "cmConfigure.h" // IWYU pragma: keep
 
+#include <cstddef>
 #include <string>
 #include <vector>
 
@@ -29,6 +30,9 @@ public:
   void SetDefinition(std::string const& name, cm::string_view value);
   void RemoveDefinition(std::string const& name);
   std::vector<std::string> ClosureKeys() const;
+  /** Estimate the bytes held by the variable scope of this snapshot, not
+      counting the strings shared with the pool of the state.  */
+  std::size_t GetDefinitionsMemoryUsage() const;
   bool RaiseScope(std::string const& var, char const* varDef);
 
   void SetListFile(std::string const& listfile);
@@ -88,6 +92,7 @@ private:
   friend struct StrictWeakOrder;
 
   void InitializeFromParent();
+  void DefinitionChanged();
 
   cmState* State;
   cmStateDetail::PositionType Position;
@@ -384,6 +384,10 @@ public:
   /** If 'is_stable()' does not return true, mutate so it does.  */
   void stabilize();
 
+  /** Return the number of instances sharing ownership of the string
+      owned by this instance, or 0 if this instance owns no string.  */
+  long use_count() const noexcept { return this->string_.use_count(); }
+
   /** Get a pointer to a normal std::string if 'is_stable()' returns
       true and otherwise nullptr.  The pointer is valid until this
       instance is mutated or destroyed.  */
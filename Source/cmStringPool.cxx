@@ -0,0 +1,54 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#include "cmStringPool.h"
+
+#include <algorithm>
+#include <string>
+
+cm::String cmStringPool::Intern(cm::string_view value)
+{
+  if (value.size() > MaxPooledSize) {
+    return cm::String(std::string(value));
+  }
+
+  auto it = this->Strings.find(cm::String::borrow(value));
+  if (it != this->Strings.end()) {
+    return *it;
+  }
+
+  cm::String str = std::string(value);
+  this->Bytes += str.size();
+  this->Strings.insert(str);
+  if (this->Bytes > this->SweepBytes) {
+    this->Sweep();
+  }
+  return str;
+}
+
+void cmStringPool::Release(cm::String value)
+{
+  // The pool holds one reference and the argument another.
+  if (value.size() > MaxPooledSize || value.use_count() != 2) {
+    return;
+  }
+  auto it = this->Strings.find(value);
+  if (it != this->Strings.end() && it->data() == value.data()) {
+    this->Bytes -= it->size();
+    this->Strings.erase(it);
+  }
+}
+
+void cmStringPool::Sweep()
+{
+  for (auto it = this->Strings.begin(); it != this->Strings.end();) {
+    // The pool holds one reference.  A caller holding a value it just
+    // got from Intern holds another.
+    if (it->use_count() == 1) {
+      this->Bytes -= it->size();
+      it = this->Strings.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  this->SweepBytes = std::max<std::size_t>(2 * this->Bytes, 1 << 20);
+}
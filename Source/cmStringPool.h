@@ -0,0 +1,50 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#pragma once
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <cstddef>
+#include <unordered_set>
+
+#include <cm/string_view>
+
+#include "cmString.hxx"
+
+/** \class cmStringPool
+ * \brief Share the storage of equal strings.
+ *
+ * Variables of a project hold the same values over and over: every
+ * directory that finds a package defines the same result variables.
+ * The pool hands out cm::String instances that share one copy of each
+ * distinct value of at most MaxPooledSize bytes.  Longer values, such
+ * as lists grown one element at a time, rarely repeat and are not
+ * pooled.  A value replaced by its last user is dropped right away, and
+ * values no longer used outside the pool for other reasons are dropped
+ * whenever the pool has grown to twice its size after the last sweep.
+ */
+class cmStringPool
+{
+public:
+  /** Longest value shared through the pool.  */
+  static std::size_t const MaxPooledSize = 256;
+
+  /** Get a string with the given value, sharing the pooled copy if the
+      value is short enough to be pooled.  */
+  cm::String Intern(cm::string_view value);
+
+  /** Drop the pooled copy of a value if the given string was its last
+      use outside the pool.  */
+  void Release(cm::String value);
+
+  /** Drop the values no longer used outside the pool.  */
+  void Sweep();
+
+  std::size_t GetCount() const { return this->Strings.size(); }
+  std::size_t GetBytes() const { return this->Bytes; }
+
+private:
+  std::unordered_set<cm::String> Strings;
+  std::size_t Bytes = 0;
+  std::size_t SweepBytes = 1 << 20;
+};
@@ -0,0 +1,75 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#include "cmThreadPool.h"
+
+cmThreadPool::~cmThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Stop = true;
+  }
+  this->Wake.notify_all();
+  for (std::thread& worker : this->Workers) {
+    worker.join();
+  }
+}
+
+void cmThreadPool::ForEach(std::size_t count, unsigned int threads,
+                           std::function<void(std::size_t)> const& task)
+{
+  if (threads > count) {
+    threads = static_cast<unsigned int>(count);
+  }
+  if (threads <= 1) {
+    for (std::size_t i = 0; i < count; ++i) {
+      task(i);
+    }
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(this->Mutex);
+  while (this->Workers.size() < threads - 1) {
+    this->Workers.emplace_back(&cmThreadPool::Work, this);
+  }
+  this->Task = &task;
+  this->Count = count;
+  this->Next = 0;
+  this->Slots = threads - 1;
+  lock.unlock();
+  this->Wake.notify_all();
+
+  this->Drain();
+
+  // Threads that did not join the batch yet have nothing left to do.
+  lock.lock();
+  this->Slots = 0;
+  this->Done.wait(lock, [this] { return this->Running == 0; });
+  this->Task = nullptr;
+  this->Count = 0;
+}
+
+void cmThreadPool::Work()
+{
+  std::unique_lock<std::mutex> lock(this->Mutex);
+  for (;;) {
+    this->Wake.wait(lock, [this] { return this->Stop || this->Slots > 0; });
+    if (this->Stop) {
+      return;
+    }
+    --this->Slots;
+    ++this->Running;
+    lock.unlock();
+    this->Drain();
+    lock.lock();
+    if (--this->Running == 0) {
+      this->Done.notify_all();
+    }
+  }
+}
+
+void cmThreadPool::Drain()
+{
+  for (std::size_t i = this->Next++; i < this->Count; i = this->Next++) {
+    (*this->Task)(i);
+  }
+}
@@ -0,0 +1,58 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#pragma once
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** \class cmThreadPool
+ * \brief Threads kept alive to run short batches of independent tasks.
+ *
+ * Commands that read many paths from disk run once per call and would
+ * otherwise start and join their own threads every time.  The pool starts
+ * its threads on first use and reuses them for every later batch until it
+ * is destroyed.  Batches are run one at a time by the thread owning the
+ * pool, which takes part in each of them.
+ */
+class cmThreadPool
+{
+public:
+  cmThreadPool() = default;
+  ~cmThreadPool();
+
+  cmThreadPool(cmThreadPool const&) = delete;
+  cmThreadPool& operator=(cmThreadPool const&) = delete;
+
+  /**
+   * Call the task with every index below count on up to the given number
+   * of threads, the calling one included, and return when all calls have
+   * returned.
+   */
+  void ForEach(std::size_t count, unsigned int threads,
+               std::function<void(std::size_t)> const& task);
+
+  //! Number of threads started so far, the calling one excluded.
+  std::size_t GetNumberOfThreads() const { return this->Workers.size(); }
+
+private:
+  void Work();
+  void Drain();
+
+  std::mutex Mutex;
+  std::condition_variable Wake;
+  std::condition_variable Done;
+  std::vector<std::thread> Workers;
+  std::function<void(std::size_t)> const* Task = nullptr;
+  std::size_t Count = 0;
+  std::atomic<std::size_t> Next{ 0 };
+  unsigned int Slots = 0;
+  unsigned int Running = 0;
+  bool Stop = false;
+};
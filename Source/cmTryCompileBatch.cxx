@@ -0,0 +1,308 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#include "cmTryCompileBatch.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+#include <cm/memory>
+#include <cm/vector>
+#include <cmext/algorithm>
+
+#include <cm3p/uv.h>
+
+#include "cmProcessOutput.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+#include "cmUVProcessChain.h"
+#include "cmUVStream.h"
+
+struct cmTryCompileBatch::Check
+{
+  std::string Directory;
+  std::vector<cmGlobalGenerator::GeneratedMakeCommand> Commands;
+  std::vector<std::string> Environment;
+  std::size_t NextCommand = 0;
+  Callback Finish;
+
+  int ExitCode = 0;
+  std::string Output;
+  std::string Error;
+  bool Started = false;
+  bool Finished = false;
+
+  // The command running, if any.
+  std::unique_ptr<cmUVProcessChain> Chain;
+  cm::uv_pipe_ptr OutputPipe;
+  std::unique_ptr<cmUVStreamReadHandle> OutputHandle;
+  std::vector<char> CommandOutput;
+  bool OutputFinished = false;
+  cm::uv_timer_ptr Timer;
+  bool TimedOut = false;
+};
+
+cmTryCompileBatch::cmTryCompileBatch(std::size_t jobs, bool watcomWMake,
+                                     cmDuration timeout)
+  : Jobs(std::max<std::size_t>(jobs, 1))
+  , WatcomWMake(watcomWMake)
+  , Timeout(timeout)
+{
+  this->Loop.init();
+}
+
+cmTryCompileBatch::~cmTryCompileBatch()
+{
+  // Do not leave build tools running in the directories of checks whose
+  // results are dropped, but do not hand the results out or start the
+  // remaining checks either.
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    this->Stopping = true;
+    if (this->Wakeup) {
+      this->Wakeup.send();
+    }
+  }
+#ifndef CMAKE_BOOTSTRAP
+  if (this->Thread.joinable()) {
+    this->Thread.join();
+    return;
+  }
+#endif
+  this->Run();
+}
+
+void cmTryCompileBatch::Add(
+  std::string bindir,
+  std::vector<cmGlobalGenerator::GeneratedMakeCommand> commands, int exitCode,
+  std::string output, Callback finish)
+{
+  auto check = cm::make_unique<Check>();
+  check->Directory = std::move(bindir);
+  check->Commands = std::move(commands);
+  check->Finish = std::move(finish);
+  if (check->Commands.empty()) {
+    check->ExitCode = exitCode;
+    check->Output = std::move(output);
+    check->Started = true;
+    check->Finished = true;
+  } else {
+    // Match the output of cmGlobalGenerator::Build.
+    check->Output = cmStrCat("Change Dir: '", check->Directory,
+                             "'\n\nRun Build Command(s): ");
+    // The builds start in another thread, which must not read the
+    // environment while this one may change it.  The output is parsed,
+    // so do not let Ninja decorate it.
+    check->Environment = cmSystemTools::GetEnvironmentVariables();
+    cm::erase_if(check->Environment, [](std::string const& var) {
+      return cmHasLiteralPrefix(var, "NINJA_STATUS=");
+    });
+    check->Environment.emplace_back("NINJA_STATUS=");
+  }
+  bool const build = !check->Finished;
+
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  this->Checks.push_back(std::move(check));
+  if (!build) {
+    return;
+  }
+#ifndef CMAKE_BOOTSTRAP
+  if (!this->Thread.joinable()) {
+    this->Wakeup.init(*this->Loop, [](uv_async_t*) {});
+    this->Thread = std::thread([this]() { this->Run(); });
+  }
+  this->Wakeup.send();
+#else
+  // Collect the builds done since the last check and start new ones.
+  uv_run(this->Loop, UV_RUN_NOWAIT);
+  this->Poll();
+#endif
+}
+
+bool cmTryCompileBatch::IsEmpty() const
+{
+  std::lock_guard<std::mutex> lock(this->Mutex);
+  return this->Checks.empty();
+}
+
+void cmTryCompileBatch::Run()
+{
+  std::unique_lock<std::mutex> lock(this->Mutex);
+  for (;;) {
+    this->Poll();
+    if (this->Stopping && this->Running == 0) {
+      break;
+    }
+    lock.unlock();
+    uv_run(this->Loop, UV_RUN_ONCE);
+    lock.lock();
+  }
+  this->Wakeup.reset();
+  lock.unlock();
+  uv_run(this->Loop, UV_RUN_DEFAULT);
+}
+
+void cmTryCompileBatch::Poll()
+{
+  while (this->StartChecks()) {
+  }
+}
+
+bool cmTryCompileBatch::StartChecks()
+{
+  bool changed = false;
+  for (auto const& check : this->Checks) {
+    if (check->Chain &&
+        (check->TimedOut ||
+         (check->OutputFinished && check->Chain->Finished()))) {
+      this->OnCommandFinished(*check);
+      changed = true;
+    }
+  }
+  for (auto const& check : this->Checks) {
+    if (this->Stopping || this->Running >= this->Jobs) {
+      break;
+    }
+    if (!check->Started) {
+      check->Started = true;
+      ++this->Running;
+      this->StartCommand(*check);
+      changed = true;
+    }
+  }
+  return changed;
+}
+
+void cmTryCompileBatch::StartCommand(Check& check)
+{
+  cmGlobalGenerator::GeneratedMakeCommand const& command =
+    check.Commands[check.NextCommand];
+  check.Output += command.QuotedPrintable();
+  if (check.NextCommand + 1 < check.Commands.size()) {
+    check.Output += " && ";
+  }
+  check.Output += '\n';
+
+  cmUVProcessChainBuilder builder;
+  builder.AddCommand(command.PrimaryCommand)
+    .SetExternalLoop(*this->Loop)
+    .SetMergedBuiltinStreams()
+    .SetWorkingDirectory(check.Directory)
+    .SetEnvironment(check.Environment);
+  check.Chain = cm::make_unique<cmUVProcessChain>(builder.Start());
+
+  Check* c = &check;
+  c->CommandOutput.clear();
+  c->OutputFinished = c->Chain->OutputStream() < 0;
+  if (c->OutputFinished) {
+    // The command could not be started.
+    return;
+  }
+  if (this->Timeout.count() > 0) {
+    // Stop waiting for the command once it timed out, as TryCompile()
+    // does, and do not let it build on.
+    c->Timer.init(*this->Loop, c);
+    c->Timer.start(
+      [](uv_timer_t* timer) {
+        auto* timedOut = static_cast<Check*>(timer->data);
+        timedOut->TimedOut = true;
+        timedOut->Chain->Terminate();
+      },
+      static_cast<uint64_t>(this->Timeout.count() * 1000.0), 0);
+  }
+  c->OutputPipe.init(*this->Loop, 0);
+  uv_pipe_open(c->OutputPipe, c->Chain->OutputStream());
+  c->OutputHandle = cmUVStreamRead(
+    c->OutputPipe,
+    [c](std::vector<char> data) {
+      // Translate NULL characters in the output into valid text.
+      std::replace(data.begin(), data.end(), '\0', ' ');
+      cm::append(c->CommandOutput, data);
+    },
+    [c]() { c->OutputFinished = true; });
+}
+
+void cmTryCompileBatch::OnCommandFinished(Check& check)
+{
+  std::string output(check.CommandOutput.begin(), check.CommandOutput.end());
+  cmProcessOutput processOutput(cmProcessOutput::Auto);
+  processOutput.DecodeText(output, output);
+
+  std::pair<cmUVProcessChain::ExceptionCode, std::string> exception;
+  if (!check.TimedOut) {
+    auto const& status = check.Chain->GetStatus(0);
+    exception = status.GetException();
+    if (exception.first == cmUVProcessChain::ExceptionCode::None) {
+      check.ExitCode = static_cast<int>(status.ExitStatus);
+    }
+  }
+  if (!check.TimedOut &&
+      exception.first == cmUVProcessChain::ExceptionCode::None) {
+    check.Output += output;
+  } else {
+    std::string const command =
+      check.Commands[check.NextCommand].QuotedPrintable();
+    check.ExitCode = 1;
+    check.Output += cmStrCat(output, exception.second,
+                             "\nGenerator: build tool execution failed, "
+                             "command was: ",
+                             command, '\n');
+    check.Error =
+      cmStrCat("Generator: build tool execution failed, command was: ",
+               check.Commands[check.NextCommand].Printable());
+  }
+
+  // The OpenWatcom tools do not return an error code when a link
+  // library is not found!
+  if (this->WatcomWMake && check.ExitCode == 0 &&
+      output.find("W1008: cannot open") != std::string::npos) {
+    check.ExitCode = 1;
+  }
+
+  check.Timer.reset();
+  check.OutputHandle.reset();
+  check.OutputPipe.reset();
+  check.Chain.reset();
+
+  ++check.NextCommand;
+  if (check.ExitCode == 0 && check.Error.empty() &&
+      check.NextCommand < check.Commands.size()) {
+    this->StartCommand(check);
+    return;
+  }
+  if (check.Error.empty()) {
+    check.Output += '\n';
+  }
+  check.Finished = true;
+  --this->Running;
+  this->CheckFinished.notify_all();
+}
+
+void cmTryCompileBatch::Wait()
+{
+  std::unique_lock<std::mutex> lock(this->Mutex);
+  while (!this->Checks.empty()) {
+    if (!this->Checks.front()->Finished) {
+#ifndef CMAKE_BOOTSTRAP
+      this->CheckFinished.wait(lock);
+#else
+      this->Poll();
+      if (!this->Checks.front()->Finished) {
+        uv_run(this->Loop, UV_RUN_ONCE);
+      }
+#endif
+      continue;
+    }
+
+    // Hand the result out of the batch first in case the callback adds
+    // more checks.
+    std::unique_ptr<Check> done = std::move(this->Checks.front());
+    this->Checks.pop_front();
+    lock.unlock();
+    if (!done->Error.empty()) {
+      cmSystemTools::Error(done->Error);
+    }
+    done->Finish(done->ExitCode, std::move(done->Output));
+    lock.lock();
+  }
+}
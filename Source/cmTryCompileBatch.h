@@ -0,0 +1,93 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#pragma once
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifndef CMAKE_BOOTSTRAP
+#  include <thread>
+#endif
+
+#include "cmDuration.h"
+#include "cmGlobalGenerator.h"
+#include "cmUVHandlePtr.h"
+
+/** \class cmTryCompileBatch
+ * \brief Build the projects of asynchronous try_compile checks.
+ *
+ * The projects of try_compile(ASYNC) checks are configured and generated
+ * when the checks are called, which cannot run concurrently.  Their build
+ * tools are then run in the background by a thread of the batch, several
+ * at a time, while the calling project goes on.  The results are handed
+ * to the checks in the order they were added when the batch is waited for.
+ */
+class cmTryCompileBatch
+{
+public:
+  using Callback = std::function<void(int exitCode, std::string output)>;
+
+  /**
+   * Run up to \p jobs builds at a time.  Each build command is terminated
+   * after \p timeout unless it is zero, like those of TryCompile().
+   */
+  cmTryCompileBatch(std::size_t jobs, bool watcomWMake, cmDuration timeout);
+  ~cmTryCompileBatch();
+
+  cmTryCompileBatch(cmTryCompileBatch const&) = delete;
+  cmTryCompileBatch& operator=(cmTryCompileBatch const&) = delete;
+
+  /**
+   * Add the build of a project in \p bindir by the given \p commands, run
+   * one after the other.  Without commands, the check is complete and
+   * \p exitCode and \p output are its result.  The \p finish callback
+   * receives the result in Wait().
+   */
+  void Add(std::string bindir,
+           std::vector<cmGlobalGenerator::GeneratedMakeCommand> commands,
+           int exitCode, std::string output, Callback finish);
+
+  //! Whether no check waits for its result.
+  bool IsEmpty() const;
+
+  //! Wait for all builds and hand the results out in order.
+  void Wait();
+
+private:
+  struct Check;
+
+  // Run the loop until the batch stops and no build runs anymore.
+  void Run();
+  // Collect finished commands and start new ones until nothing changes.
+  void Poll();
+  bool StartChecks();
+  void StartCommand(Check& check);
+  void OnCommandFinished(Check& check);
+
+  std::size_t const Jobs;
+  bool const WatcomWMake;
+  cmDuration const Timeout;
+  cm::uv_loop_ptr Loop;
+  // Wakes the loop up to start added checks or to stop.
+  cm::uv_async_ptr Wakeup;
+#ifndef CMAKE_BOOTSTRAP
+  std::thread Thread;
+#endif
+
+  // Guards the members below and the checks, which the thread running
+  // the loop works on.
+  mutable std::mutex Mutex;
+  std::condition_variable CheckFinished;
+  // Checks not handed out yet, in the order they were added.
+  std::deque<std::unique_ptr<Check>> Checks;
+  std::size_t Running = 0;
+  bool Stopping = false;
+};
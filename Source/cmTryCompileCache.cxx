@@ -0,0 +1,135 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#include "cmTryCompileCache.h"
+
+#include <cstdlib>
+#include <ios>
+#include <iterator>
+#include <utility>
+
+#include "cmsys/FStream.hxx"
+
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+namespace {
+char const* const ResultFileName = "result.txt";
+char const* const OutputFileName = "output.txt";
+}
+
+cmTryCompileCache::cmTryCompileCache(std::string directory)
+  : Directory(std::move(directory))
+  , Hash(cmCryptoHash::AlgoSHA256)
+{
+  this->Hash.Initialize();
+}
+
+void cmTryCompileCache::AddReplacement(std::string value,
+                                       std::string placeholder)
+{
+  if (!value.empty()) {
+    this->Replacements.emplace_back(std::move(value), std::move(placeholder));
+  }
+}
+
+void cmTryCompileCache::AddKey(cm::string_view name, cm::string_view value)
+{
+  std::string normalized(value);
+  for (auto const& replacement : this->Replacements) {
+    cmSystemTools::ReplaceString(normalized, replacement.first,
+                                 replacement.second);
+  }
+  // Prefix values by their size so that no two keys hash the same bytes.
+  this->Hash.Append(cmStrCat(name, ' ', normalized.size(), '\n'));
+  this->Hash.Append(normalized);
+}
+
+void cmTryCompileCache::AddFileKey(cm::string_view name,
+                                   std::string const& path)
+{
+  std::string content;
+  cmsys::ifstream fin(path.c_str(), std::ios::in | std::ios::binary);
+  if (fin) {
+    content.assign(std::istreambuf_iterator<char>(fin),
+                   std::istreambuf_iterator<char>());
+  }
+  this->AddKey(name, content);
+}
+
+cm::optional<cmTryCompileCache::Entry> cmTryCompileCache::Load(
+  std::string const& outputDirectory, std::string const& outputName)
+{
+  std::string const key = this->Hash.FinalizeHex();
+  this->EntryDirectory =
+    cmStrCat(this->Directory, '/', key.substr(0, 2), '/', key);
+
+  cmsys::ifstream fin(
+    cmStrCat(this->EntryDirectory, '/', ResultFileName).c_str());
+  std::string exitCode;
+  std::string outputFile;
+  if (!fin || !cmSystemTools::GetLineFromStream(fin, exitCode) ||
+      !cmSystemTools::GetLineFromStream(fin, outputFile)) {
+    return cm::nullopt;
+  }
+
+  Entry entry;
+  entry.ExitCode = std::atoi(exitCode.c_str());
+  cmsys::ifstream output(
+    cmStrCat(this->EntryDirectory, '/', OutputFileName).c_str(),
+    std::ios::in | std::ios::binary);
+  if (!output) {
+    return cm::nullopt;
+  }
+  entry.Output.assign(std::istreambuf_iterator<char>(output),
+                      std::istreambuf_iterator<char>());
+  if (!outputFile.empty()) {
+    entry.OutputFile = cmStrCat(outputDirectory, '/', outputName,
+                                cmSystemTools::GetFilenameExtension(
+                                  outputFile));
+    if (!cmSystemTools::CopyFileAlways(
+          cmStrCat(this->EntryDirectory, '/', outputFile), entry.OutputFile)) {
+      return cm::nullopt;
+    }
+  }
+  return cm::optional<Entry>(std::move(entry));
+}
+
+void cmTryCompileCache::Store(Entry const& entry) const
+{
+  std::string const parent = cmSystemTools::GetFilenamePath(
+    this->EntryDirectory);
+  if (!cmSystemTools::MakeDirectory(parent)) {
+    return;
+  }
+  std::string temp = cmStrCat(parent, "/tmp-XXXXXX");
+  if (!cmSystemTools::MakeTempDirectory(temp)) {
+    return;
+  }
+
+  // Write the entry aside, then move it in place at once.
+  bool written = true;
+  std::string outputFile;
+  if (!entry.OutputFile.empty()) {
+    outputFile = cmStrCat(
+      "output", cmSystemTools::GetFilenameExtension(entry.OutputFile));
+    written = static_cast<bool>(cmSystemTools::CopyFileAlways(
+      entry.OutputFile, cmStrCat(temp, '/', outputFile)));
+  }
+  if (written) {
+    cmsys::ofstream fout(cmStrCat(temp, '/', OutputFileName).c_str(),
+                         std::ios::out | std::ios::binary);
+    fout << entry.Output;
+    fout.close();
+    written = !fout.fail();
+  }
+  if (written) {
+    cmsys::ofstream fout(cmStrCat(temp, '/', ResultFileName).c_str());
+    fout << entry.ExitCode << '\n' << outputFile << '\n';
+    fout.close();
+    written = !fout.fail();
+  }
+  // Renaming fails if another build tree stored the same entry meanwhile.
+  if (!written || !cmSystemTools::RenameFile(temp, this->EntryDirectory)) {
+    cmSystemTools::RemoveADirectory(temp);
+  }
+}
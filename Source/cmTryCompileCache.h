@@ -0,0 +1,66 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+#pragma once
+
+#include "cmConfigure.h" // IWYU pragma: keep
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <cm/optional>
+#include <cm/string_view>
+
+#include "cmCryptoHash.h"
+
+/** \class cmTryCompileCache
+ * \brief Results of try_compile stored by the content of their projects.
+ *
+ * Entries are keyed by a hash of everything the caller adds to the key:
+ * the generated project, the test sources, the flags and the identity of
+ * the toolchain.  An entry holds the exit code and output of the build,
+ * and a copy of the file it produced, if any.  Entries are written to a
+ * temporary directory renamed into place, so several build trees may
+ * share the cache directory concurrently.
+ */
+class cmTryCompileCache
+{
+public:
+  struct Entry
+  {
+    int ExitCode = 1;
+    std::string Output;
+    // Full path to the file produced by the build, or empty.
+    std::string OutputFile;
+  };
+
+  cmTryCompileCache(std::string directory);
+
+  /**
+   * Replace a string by a placeholder in the values added to the key
+   * afterwards, such as the names that differ between identical checks.
+   */
+  void AddReplacement(std::string value, std::string placeholder);
+
+  //! Add a named value to the key.
+  void AddKey(cm::string_view name, cm::string_view value);
+
+  //! Add the content of a file to the key.
+  void AddFileKey(cm::string_view name, std::string const& path);
+
+  /**
+   * Finish the key and look up its entry.  The file produced by the build
+   * is copied to the given directory, named after \p outputName.
+   */
+  cm::optional<Entry> Load(std::string const& outputDirectory,
+                           std::string const& outputName);
+
+  //! Store the entry of the key finished by Load().
+  void Store(Entry const& entry) const;
+
+private:
+  std::string Directory;
+  std::string EntryDirectory;
+  std::vector<std::pair<std::string, std::string>> Replacements;
+  cmCryptoHash Hash;
+};
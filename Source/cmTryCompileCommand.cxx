@@ -2,6 +2,9 @@
    file LICENSE.rst or https://cmake.org/licensing for details.  */
 #include "cmTryCompileCommand.h"
 
+#include <memory>
+#include <utility>
+
 #include <cm/optional>
 
 #include "cmConfigureLog.h"
@@ -13,6 +16,7 @@
 #include "cmState.h"
 #include "cmStateTypes.h"
 #include "cmStringAlgorithms.h"
+#include "cmTryCompileBatch.h"
 #include "cmValue.h"
 #include "cmake.h"
 
@@ -31,6 +35,42 @@ void WriteTryCompileEvent(cmConfigureLog& log, cmMakefile const& mf,
   }
 }
 #endif
+
+void FinishCheck(cmMakefile& mf, cmCoreTryCompile& tc,
+                 cmCoreTryCompile::Arguments const& arguments,
+                 cm::optional<cmTryCompileResult> const& compileResult)
+{
+#ifndef CMAKE_BOOTSTRAP
+  if (compileResult && !arguments.NoLog) {
+    if (cmConfigureLog* log = mf.GetCMakeInstance()->GetConfigureLog()) {
+      WriteTryCompileEvent(*log, mf, *compileResult);
+    }
+  }
+#else
+  static_cast<void>(arguments);
+  static_cast<void>(compileResult);
+#endif
+
+  // if They specified clean then we clean up what we can
+  if (tc.SrcFileSignature) {
+    if (!mf.GetCMakeInstance()->GetDebugTryCompile()) {
+      tc.CleanupFiles(tc.BinaryDirectory);
+    }
+  }
+}
+
+// A try_compile(ASYNC) check kept alive until its batch built it.
+struct AsyncCheck
+{
+  AsyncCheck(cmMakefile* mf, cmCoreTryCompile::Arguments arguments)
+    : TryCompile(mf)
+    , Arguments(std::move(arguments))
+  {
+  }
+
+  cmCoreTryCompile TryCompile;
+  cmCoreTryCompile::Arguments Arguments;
+};
 }
 
 bool cmTryCompileCommand(std::vector<std::string> const& args,
@@ -38,6 +78,11 @@ bool cmTryCompileCommand(std::vector<std::string> const& args,
 {
   cmMakefile& mf = status.GetMakefile();
 
+  if (args.size() == 1 && args[0] == "WAIT") {
+    mf.GetTryCompileBatch().Wait();
+    return true;
+  }
+
   if (args.size() < 3) {
     mf.IssueMessage(
       MessageType::FATAL_ERROR,
@@ -80,21 +125,23 @@ bool cmTryCompileCommand(std::vector<std::string> const& args,
     return true;
   }
 
-  cm::optional<cmTryCompileResult> compileResult =
-    tc.TryCompileCode(arguments, targetType);
-#ifndef CMAKE_BOOTSTRAP
-  if (compileResult && !arguments.NoLog) {
-    if (cmConfigureLog* log = mf.GetCMakeInstance()->GetConfigureLog()) {
-      WriteTryCompileEvent(*log, mf, *compileResult);
+  if (arguments.Async) {
+    auto check = std::make_shared<AsyncCheck>(&mf, std::move(arguments));
+    cmCoreTryCompile& atc = check->TryCompile;
+    cm::optional<cmTryCompileResult> compileResult = atc.TryCompileCode(
+      check->Arguments, targetType, &mf.GetTryCompileBatch(),
+      [check](cm::optional<cmTryCompileResult> result) {
+        FinishCheck(*check->TryCompile.Makefile, check->TryCompile,
+                    check->Arguments, result);
+      });
+    if (!atc.Deferred) {
+      FinishCheck(mf, atc, check->Arguments, compileResult);
     }
+    return true;
   }
-#endif
 
-  // if They specified clean then we clean up what we can
-  if (tc.SrcFileSignature) {
-    if (!mf.GetCMakeInstance()->GetDebugTryCompile()) {
-      tc.CleanupFiles(tc.BinaryDirectory);
-    }
-  }
+  cm::optional<cmTryCompileResult> compileResult =
+    tc.TryCompileCode(arguments, targetType);
+  FinishCheck(mf, tc, arguments, compileResult);
   return true;
 }
@@ -162,6 +162,14 @@ cmUVProcessChainBuilder& cmUVProcessChainBuilder::SetDetached()
   return *this;
 }
 
+cmUVProcessChainBuilder& cmUVProcessChainBuilder::SetEnvironment(
+  std::vector<std::string> env)
+{
+  this->Environment = std::move(env);
+  this->UseEnvironment = true;
+  return *this;
+}
+
 uv_loop_t* cmUVProcessChainBuilder::GetLoop() const
 {
   return this->Loop;
@@ -357,6 +365,15 @@ void cmUVProcessChain::InternalData::SpawnProcess(
   if (!this->Builder->WorkingDirectory.empty()) {
     options.cwd = this->Builder->WorkingDirectory.c_str();
   }
+  std::vector<char const*> environment;
+  if (this->Builder->UseEnvironment) {
+    environment.reserve(this->Builder->Environment.size() + 1);
+    for (auto const& var : this->Builder->Environment) {
+      environment.push_back(var.c_str());
+    }
+    environment.push_back(nullptr);
+    options.env = const_cast<char**>(environment.data());
+  }
 
   std::array<uv_stdio_container_t, 3> stdio;
   if (first) {
@@ -487,6 +504,15 @@ bool cmUVProcessChain::Finished() const
   return this->Data->ProcessesCompleted >= this->Data->Processes.size();
 }
 
+void cmUVProcessChain::Terminate()
+{
+  for (auto const& process : this->Data->Processes) {
+    if (!process->ProcessStatus.Finished && process->Process) {
+      uv_process_kill(process->Process, SIGKILL);
+    }
+  }
+}
+
 std::pair<cmUVProcessChain::ExceptionCode, std::string>
 cmUVProcessChain::Status::GetException() const
 {
@@ -39,6 +39,9 @@ public:
   cmUVProcessChainBuilder& SetExternalStream(Stream stdio, FILE* stream);
   cmUVProcessChainBuilder& SetWorkingDirectory(std::string dir);
   cmUVProcessChainBuilder& SetDetached();
+  // Run the commands with the given NAME=VALUE variables as their whole
+  // environment instead of the environment of this process.
+  cmUVProcessChainBuilder& SetEnvironment(std::vector<std::string> env);
 
   uv_loop_t* GetLoop() const;
 
@@ -68,6 +71,8 @@ private:
   std::array<StdioConfiguration, 3> Stdio;
   std::vector<ProcessConfiguration> Processes;
   std::string WorkingDirectory;
+  std::vector<std::string> Environment;
+  bool UseEnvironment = false;
   bool MergedBuiltinStreams = false;
   bool Detached = false;
   uv_loop_t* Loop = nullptr;
@@ -116,6 +121,8 @@ public:
   std::vector<Status const*> GetStatus() const;
   Status const& GetStatus(std::size_t index) const;
   bool Finished() const;
+  // Kill the processes that have not finished yet.
+  void Terminate();
 
 private:
   friend class cmUVProcessChainBuilder;
@@ -50,6 +50,7 @@
 #include "cmDuration.h"
 #include "cmExternalMakefileProjectGenerator.h"
 #include "cmFileTimeCache.h"
+#include "cmFindPackageCache.h"
 #include "cmGeneratorTarget.h"
 #include "cmGlobCacheEntry.h"
 #include "cmGlobalGenerator.h"
@@ -62,6 +63,7 @@
 #endif
 #include "cmJSONState.h"
 #include "cmList.h"
+#include "cmListFileCache.h"
 #include "cmMessenger.h"
 #ifndef CMAKE_BOOTSTRAP
 #  include "cmSarifLog.h"
@@ -88,6 +90,7 @@
 #  include "cmGraphVizWriter.h"
 #  include "cmInstrumentation.h"
 #  include "cmInstrumentationQuery.h"
+#  include "cmThreadPool.h"
 #  include "cmVariableWatch.h"
 #endif
 
@@ -365,6 +368,14 @@ cmake::cmake(Role role, cmState::Mode mode, cmState::ProjectKind projectKind)
 cmake::~cmake() = default;
 
 #if !defined(CMAKE_BOOTSTRAP)
+cmThreadPool& cmake::GetThreadPool()
+{
+  if (!this->ThreadPool) {
+    this->ThreadPool = cm::make_unique<cmThreadPool>();
+  }
+  return *this->ThreadPool;
+}
+
 Json::Value cmake::ReportVersionJson() const
 {
   Json::Value version = Json::objectValue;
@@ -2671,6 +2682,26 @@ int cmake::ActualConfigure()
   }
 #endif
 
+  // load the parsed list files of the previous run, if requested
+  this->ListFileCache.reset();
+  if (!this->GetIsInTryCompile() &&
+      this->State->GetCacheEntryValue("CMAKE_LIST_FILE_CACHE").IsOn()) {
+    this->ListFileCache = cm::make_unique<cmListFileCache>(cmStrCat(
+      this->GetHomeOutputDirectory(), "/CMakeFiles/ListFileCache.bin"));
+    this->ListFileCache->Load();
+  }
+
+  // load the find_package prefix searches of the previous run, if requested
+  this->FindPackageCache.reset();
+  if (!this->GetIsInTryCompile() &&
+      this->State->GetCacheEntryValue("CMAKE_FIND_PACKAGE_PREFIX_CACHE")
+        .IsOn()) {
+    this->FindPackageCache = cm::make_unique<cmFindPackageCache>(
+      cmStrCat(this->GetHomeOutputDirectory(),
+               "/CMakeFiles/FindPackagePrefixCache.bin"));
+    this->FindPackageCache->Load();
+  }
+
   // actually do the configure
   auto startTime = std::chrono::steady_clock::now();
 #if !defined(CMAKE_BOOTSTRAP)
@@ -2694,6 +2725,69 @@ int cmake::ActualConfigure()
 #endif
   auto endTime = std::chrono::steady_clock::now();
 
+  if (this->ListFileCache) {
+#if !defined(CMAKE_BOOTSTRAP)
+    if (this->IsProfilingEnabled()) {
+      Json::Value counters = Json::objectValue;
+      counters["hits"] =
+        static_cast<Json::UInt64>(this->ListFileCache->GetHits());
+      counters["misses"] =
+        static_cast<Json::UInt64>(this->ListFileCache->GetMisses());
+      this->GetProfilingOutput().CounterEntry("cmake", "list_file_cache",
+                                              std::move(counters));
+    }
+#endif
+    if (!this->ListFileCache->Save()) {
+      this->IssueMessage(MessageType::WARNING,
+                         "Failed to write the list file cache.");
+    }
+  }
+
+#if !defined(CMAKE_BOOTSTRAP)
+  if (this->IsProfilingEnabled()) {
+    unsigned long hits;
+    unsigned long misses;
+    cmListFile::GetMemoCounts(hits, misses);
+    Json::Value counters = Json::objectValue;
+    counters["hits"] = static_cast<Json::UInt64>(hits);
+    counters["misses"] = static_cast<Json::UInt64>(misses);
+    this->GetProfilingOutput().CounterEntry("cmake", "parsed_list_file_memo",
+                                            std::move(counters));
+  }
+#endif
+
+#if !defined(CMAKE_BOOTSTRAP)
+  if (this->IsProfilingEnabled() &&
+      this->State->GetInitializedCacheValue("CMAKE_CACHE_SIDECAR").IsOn()) {
+    unsigned long sidecarLoads;
+    unsigned long textLoads;
+    this->State->GetCacheSidecarCounts(sidecarLoads, textLoads);
+    Json::Value counters = Json::objectValue;
+    counters["sidecar_loads"] = static_cast<Json::UInt64>(sidecarLoads);
+    counters["text_loads"] = static_cast<Json::UInt64>(textLoads);
+    this->GetProfilingOutput().CounterEntry("cmake", "cache_sidecar",
+                                            std::move(counters));
+  }
+#endif
+
+  if (this->FindPackageCache) {
+#if !defined(CMAKE_BOOTSTRAP)
+    if (this->IsProfilingEnabled()) {
+      Json::Value counters = Json::objectValue;
+      counters["hits"] =
+        static_cast<Json::UInt64>(this->FindPackageCache->GetHits());
+      counters["misses"] =
+        static_cast<Json::UInt64>(this->FindPackageCache->GetMisses());
+      this->GetProfilingOutput().CounterEntry(
+        "cmake", "find_package_prefix_cache", std::move(counters));
+    }
+#endif
+    if (!this->FindPackageCache->Save()) {
+      this->IssueMessage(MessageType::WARNING,
+                         "Failed to write the find_package prefix cache.");
+    }
+  }
+
   // configure result
   if (this->GetWorkingMode() == cmake::NORMAL_MODE) {
     std::ostringstream msg;
@@ -3197,6 +3291,12 @@ void cmake::AddGlobCacheEntry(cmGlobCacheEntry const& entry,
                                  this->Messenger.get());
 }
 
+void cmake::AddGlobDirectories(std::string const& expression, bool recurse,
+                               bool followSymlinks)
+{
+  this->State->AddGlobDirectories(expression, recurse, followSymlinks);
+}
+
 std::vector<cmGlobCacheEntry> cmake::GetGlobCacheEntries() const
 {
   return this->State->GetGlobCacheEntries();
@@ -51,9 +51,11 @@ class cmExternalMakefileProjectGeneratorFactory;
 class cmFileAPI;
 class cmInstrumentation;
 class cmFileTimeCache;
+class cmFindPackageCache;
 class cmGlobalGenerator;
 class cmMakefile;
 class cmMessenger;
+class cmThreadPool;
 class cmVariableWatch;
 struct cmBuildOptions;
 struct cmGlobCacheEntry;
@@ -370,6 +372,8 @@ public:
   void AddGlobCacheEntry(cmGlobCacheEntry const& entry,
                          std::string const& variable,
                          cmListFileBacktrace const& bt);
+  void AddGlobDirectories(std::string const& expression, bool recurse,
+                          bool followSymlinks);
   std::vector<cmGlobCacheEntry> GetGlobCacheEntries() const;
 
   /**
@@ -478,6 +482,19 @@ public:
    */
   cmFileTimeCache* GetFileTimeCache() { return this->FileTimeCache.get(); }
 
+  /**
+   * Get the persistent cache of parsed list files, if enabled
+   */
+  cmListFileCache* GetListFileCache() { return this->ListFileCache.get(); }
+
+  /**
+   * Get the persistent cache of find_package prefix searches, if enabled
+   */
+  cmFindPackageCache* GetFindPackageCache()
+  {
+    return this->FindPackageCache.get();
+  }
+
   bool WasLogLevelSetViaCLI() const { return this->LogLevelWasSetViaCLI; }
 
   //! Get the selected log level for `message()` commands during the cmake run.
@@ -553,6 +570,10 @@ public:
 
 #ifndef CMAKE_BOOTSTRAP
   cmConfigureLog* GetConfigureLog() const { return this->ConfigureLog.get(); }
+
+  /** Get the threads shared by the commands of this instance that read
+      from disk concurrently.  They are started on first use.  */
+  cmThreadPool& GetThreadPool();
 #endif
 
   //! Use trace from another ::cmake instance.
@@ -813,6 +834,7 @@ private:
   cmake* TraceRedirect = nullptr;
 #ifndef CMAKE_BOOTSTRAP
   std::unique_ptr<cmConfigureLog> ConfigureLog;
+  std::unique_ptr<cmThreadPool> ThreadPool;
 #endif
   bool WarnUninitialized = false;
   bool WarnUnusedCli = true;
@@ -840,6 +862,8 @@ private:
   bool RegenerateDuringBuild = false;
   std::string CMakeListName;
   std::unique_ptr<cmFileTimeCache> FileTimeCache;
+  std::unique_ptr<cmListFileCache> ListFileCache;
+  std::unique_ptr<cmFindPackageCache> FindPackageCache;
   std::string GraphVizFile;
   InstalledFilesMap InstalledFiles;
 #ifndef CMAKE_BOOTSTRAP
@@ -15,6 +15,8 @@
 #include "cmCommandLineArgument.h"
 #include "cmCryptoHash.h"
 #include "cmDuration.h"
+#include "cmFileTime.h"
+#include "cmFileTimeCache.h"
 #include "cmGlobalGenerator.h"
 #include "cmList.h"
 #include "cmLocalGenerator.h"
@@ -40,8 +42,10 @@
 #include "cmake.h"
 
 #if !defined(CMAKE_BOOTSTRAP)
+#  include <thread>
+
 #  include "cmDependsFortran.h" // For -E cmake_copy_f90_mod callback.
-#  include "cmFileTime.h"
+#  include "cmGlobDirectorySnapshot.h"
 
 #  include "bindexplib.h"
 #endif
@@ -1294,6 +1298,11 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string> const& args,
       } else {
         count = atoi(args[3].c_str());
       }
+      // A build starts or ends.  File times shared by its helper processes
+      // may change before the next one.
+      cmFileTimeCache::ResetSharedCache(
+        cmStrCat(args[2], "/SharedFileTimes.bin"));
+
       if (count) {
         cmSystemTools::MakeDirectory(dirName);
         // write the count into the directory
@@ -1480,9 +1489,21 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string> const& args,
         lgd->SetRelativePathTop(homeDir, homeOutDir);
 
         // Actually scan dependencies.
-        return lgd->UpdateDependencies(depInfo, targetName, verbose, color)
-          ? 0
-          : 2;
+        bool const updated =
+          lgd->UpdateDependencies(depInfo, targetName, verbose, color);
+
+        cmFileTimeCache* ftc = cm.GetFileTimeCache();
+        if (ftc->HasSharedCache()) {
+          ftc->WriteSharedCache();
+          if (verbose) {
+            cmFileTimeCache::Statistics const& stats = ftc->GetStatistics();
+            cmSystemTools::Stdout(
+              cmStrCat("File times: ", stats.Stats, " stat calls, ",
+                       stats.Hits + stats.SharedHits, " saved (",
+                       stats.SharedHits, " by the shared cache).\n"));
+          }
+        }
+        return updated ? 0 : 2;
       }
       return 1;
     }
@@ -1499,6 +1520,11 @@ int cmcmd::ExecuteCMakeCommand(std::vector<std::string> const& args,
       return cmcmd::ExecuteLinkScript(args);
     }
 
+    // Internal CMake glob verification support.
+    if (args[1] == "cmake_verify_globs" && args.size() == 3) {
+      return cmcmd::VerifyGlobs(args[2]);
+    }
+
 #if !defined(CMAKE_BOOTSTRAP)
     // Internal CMake ninja dependency scanning support.
     if (args[1] == "cmake_ninja_depends") {
@@ -1990,6 +2016,48 @@ int cmcmd::ExecuteEchoColor(std::vector<std::string> const& args)
   return 0;
 }
 
+int cmcmd::VerifyGlobs(std::string const& script)
+{
+  std::string const dir = cmSystemTools::GetFilenamePath(script);
+  std::string const stampFile = cmStrCat(dir, "/cmake.verify_globs");
+
+#ifndef CMAKE_BOOTSTRAP
+  // The globs cannot have changed if none of the directories they list did.
+  std::string const directoriesFile = cmStrCat(dir, "/VerifyGlobs.dirs");
+  unsigned int const threads = std::thread::hardware_concurrency();
+  cmGlobDirectorySnapshot directories;
+  bool const haveDirectories = directories.Load(directoriesFile);
+  if (haveDirectories) {
+    if (directories.IsUpToDate(threads)) {
+      return 0;
+    }
+    // Record the directories before the script lists them.
+    directories.Refresh(threads);
+  }
+#endif
+
+  cmFileTime stampTime;
+  stampTime.Load(stampFile);
+
+  int ret = 0;
+  if (!cmSystemTools::RunSingleCommand(
+        { cmSystemTools::GetCMakeCommand(), "-P", script }, nullptr, nullptr,
+        &ret, nullptr, cmSystemTools::OUTPUT_PASSTHROUGH)) {
+    return 1;
+  }
+
+#ifndef CMAKE_BOOTSTRAP
+  // If the script did not touch the stamp file, the globs have the same
+  // results and the new directory times can be trusted.
+  cmFileTime newStampTime;
+  if (ret == 0 && haveDirectories && newStampTime.Load(stampFile) &&
+      newStampTime.Compare(stampTime) == 0) {
+    directories.Save(directoriesFile);
+  }
+#endif
+  return ret;
+}
+
 int cmcmd::ExecuteLinkScript(std::vector<std::string> const& args)
 {
   // The arguments are
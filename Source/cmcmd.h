@@ -39,6 +39,7 @@ protected:
                                        std::string const& link);
   static int ExecuteEchoColor(std::vector<std::string> const& args);
   static int ExecuteLinkScript(std::vector<std::string> const& args);
+  static int VerifyGlobs(std::string const& script);
   static int WindowsCEEnvironment(char const* version,
                                   std::string const& name);
   static int RunPreprocessor(std::vector<std::string> const& command,
@@ -148,6 +148,8 @@ cmDocumentationEntry const cmDocumentationOptions[] = {
   { "--overwrite", "Overwrite CTest configuration option." },
   { "--extra-submit <file>[;<file>]", "Submit extra files to the dashboard." },
   { "--http-header <header>", "Append HTTP header when submitting" },
+  { "--schedule-critical-path",
+    "Start the longest chains of dependent tests first" },
   { "--schedule-random", "Use a random order for scheduling tests" },
   { "--schedule-random-seed", "Override seed for random order of tests" },
   { "--submit-index",
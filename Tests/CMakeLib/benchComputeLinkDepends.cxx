@@ -0,0 +1,134 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+
+/* Measure computation of link dependencies shared among targets.
+
+   Usage: benchComputeLinkDepends [<executables> [<depth>]]
+
+   A project of executables linking to the last of a chain of interface
+   libraries is generated and configured in the current working
+   directory.  The link dependencies of every executable are computed
+   once with each target following its dependencies, and once sharing
+   the closures through cmComputeLinkDependsCache.  This program is built
+   only if the CMake_BUILD_BENCHMARKS option is enabled.  */
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "cmsys/FStream.hxx"
+
+#include "cmComputeLinkDepends.h"
+#include "cmGeneratorTarget.h"
+#include "cmGlobalGenerator.h"
+#include "cmLocalGenerator.h"
+#include "cmState.h"
+#include "cmStateTypes.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+#include "cmake.h"
+
+namespace {
+
+void GenerateProject(std::string const& dir, unsigned long executables,
+                     unsigned long depth)
+{
+  cmSystemTools::MakeDirectory(dir);
+  cmsys::ofstream fout(cmStrCat(dir, "/CMakeLists.txt").c_str());
+  fout << "cmake_minimum_required(VERSION 4.0)\n"
+          "project(BenchComputeLinkDepends NONE)\n"
+          "add_library(iface0 INTERFACE)\n"
+          "target_link_libraries(iface0 INTERFACE ext0)\n"
+          "foreach(i RANGE 1 "
+       << depth
+       << ")\n"
+          "  math(EXPR j \"${i} - 1\")\n"
+          "  add_library(iface${i} INTERFACE)\n"
+          "  target_link_libraries(iface${i} INTERFACE iface${j} ext${i})\n"
+          "endforeach()\n"
+          "foreach(i RANGE 1 "
+       << executables
+       << ")\n"
+          "  add_executable(exe${i} main.c)\n"
+          "  target_link_libraries(exe${i} PRIVATE iface"
+       << depth
+       << ")\n"
+          "endforeach()\n";
+  cmsys::ofstream(cmStrCat(dir, "/main.c").c_str()) << "int main() {}\n";
+}
+
+double ComputeAll(std::vector<cmGeneratorTarget const*> const& targets,
+                  std::size_t& entries)
+{
+  auto const start = std::chrono::steady_clock::now();
+  entries = 0;
+  for (cmGeneratorTarget const* target : targets) {
+    cmComputeLinkDepends cld(target, "", "C",
+                             LinkLibrariesStrategy::REORDER_MINIMALLY);
+    entries += cld.Compute().size();
+  }
+  std::chrono::duration<double, std::milli> const elapsed =
+    std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+  unsigned long executables = 1000;
+  unsigned long depth = 400;
+  if ((argc > 1 && !cmStrToULong(argv[1], &executables)) ||
+      (argc > 2 && !cmStrToULong(argv[2], &depth))) {
+    std::cerr << "Usage: " << argv[0] << " [<executables> [<depth>]]\n";
+    return 1;
+  }
+
+  cmSystemTools::InitializeLibUV();
+  cmSystemTools::FindCMakeResources(argv[0]);
+  std::string const dir = cmStrCat(
+    cmSystemTools::GetLogicalWorkingDirectory(), "/benchComputeLinkDepends");
+  GenerateProject(cmStrCat(dir, "/src"), executables, depth);
+
+  cmake cm(cmake::RoleProject, cmState::Project);
+  cm.SetHomeDirectory(cmStrCat(dir, "/src"));
+  cm.SetHomeOutputDirectory(cmStrCat(dir, "/build"));
+  cm.SetGlobalGenerator(cm.CreateGlobalGenerator("Unix Makefiles"));
+  if (cm.AddCMakePaths() == 0 || cm.Configure() != 0) {
+    std::cerr << "Failed to configure the project in " << dir << '\n';
+    return 1;
+  }
+  cmGlobalGenerator* gg = cm.GetGlobalGenerator();
+  if (!gg->Compute()) {
+    std::cerr << "Failed to compute the project in " << dir << '\n';
+    return 1;
+  }
+
+  std::vector<cmGeneratorTarget const*> targets;
+  for (auto const& lg : gg->GetLocalGenerators()) {
+    for (auto const& target : lg->GetGeneratorTargets()) {
+      if (target->GetType() == cmStateEnums::EXECUTABLE) {
+        targets.push_back(target.get());
+      }
+    }
+  }
+
+  // Warm up the link interface caches of the targets.
+  std::size_t entries = 0;
+  ComputeAll(targets, entries);
+
+  double const plain = ComputeAll(targets, entries);
+  std::cout << "Computed " << targets.size() << " targets with " << entries
+            << " entries in " << plain << " ms\n";
+
+  gg->SetShareLinkDepends(true);
+  double const shared = ComputeAll(targets, entries);
+  cmComputeLinkDependsCache const* cache = gg->GetLinkDependsCache();
+  std::cout << "Computed " << targets.size() << " targets with " << entries
+            << " entries in " << shared << " ms sharing closures ("
+            << cache->Hits << " hits, " << cache->Misses << " misses)\n";
+  gg->SetShareLinkDepends(false);
+  return 0;
+}
@@ -0,0 +1,77 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+
+/* Measure variable lookups from nested scopes.
+
+   Usage: benchDefinitions [<depth>...]
+
+   A variable of a directory scope is read repeatedly from the innermost
+   of the given number of nested function scopes, by default 1, 5 and 20.
+   The time per lookup is printed.  This program is built only if the
+   CMake_BUILD_BENCHMARKS option is enabled.  */
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "cmDefinitions.h"
+#include "cmLinkedTree.h"
+#include "cmStringAlgorithms.h"
+#include "cmStringPool.h"
+#include "cmValue.h"
+
+namespace {
+
+using Tree = cmLinkedTree<cmDefinitions>;
+
+int const NumberOfLookups = 100000;
+
+double Lookup(std::size_t depth)
+{
+  Tree varTree;
+  cmStringPool pool;
+  Tree::iterator scope = varTree.Push(varTree.Root());
+  scope->Set("A", "a", pool);
+  for (std::size_t i = 0; i < depth; ++i) {
+    scope = varTree.Push(scope);
+  }
+
+  std::size_t const epoch = 1;
+  std::size_t n = 0;
+  auto const start = std::chrono::steady_clock::now();
+  for (int i = 0; i < NumberOfLookups; ++i) {
+    n += cmDefinitions::Get("A", scope, varTree.Root(), epoch)->size();
+  }
+  auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+  if (n != NumberOfLookups) {
+    std::cerr << "Unexpected lookup result\n";
+  }
+  return static_cast<double>(ns) / NumberOfLookups;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+  std::vector<unsigned long> depths;
+  for (int i = 1; i < argc; ++i) {
+    unsigned long depth = 0;
+    if (!cmStrToULong(argv[i], &depth)) {
+      std::cerr << "Invalid depth: " << argv[i] << '\n';
+      return 1;
+    }
+    depths.push_back(depth);
+  }
+  if (depths.empty()) {
+    depths = { 1, 5, 20 };
+  }
+
+  for (unsigned long depth : depths) {
+    std::cout << "depth " << depth << ": " << Lookup(depth) << " ns\n";
+  }
+  return 0;
+}
@@ -0,0 +1,66 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+
+/* Measure variable reference expansion.
+
+   Usage: benchExpandVariables [<string>...]
+
+   Each string, by default a typical flags string without references and
+   one with references, is expanded repeatedly in a directory scope that
+   defines the variables A, B and L.  The time per expansion is printed.
+   This program is built only if the CMake_BUILD_BENCHMARKS option is
+   enabled.  */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "cmGlobalGenerator.h"
+#include "cmMakefile.h"
+#include "cmState.h"
+#include "cmStateDirectory.h"
+#include "cmStateSnapshot.h"
+#include "cmake.h"
+
+namespace {
+
+int const NumberOfExpansions = 100000;
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+  std::vector<std::string> sources;
+  if (argc > 1) {
+    sources.assign(argv + 1, argv + argc);
+  } else {
+    sources.emplace_back("-DPROJECT_DEFINITION=1 -Wall -Wextra "
+                         "/some/long/include/directory/of/a/project");
+    sources.emplace_back("-D${A}=1 ${L} /some/directory/${B}/include");
+  }
+
+  cmake cm(cmake::RoleScript, cmState::Script);
+  cmGlobalGenerator gg(&cm);
+  cmStateSnapshot snapshot = cm.GetState()->CreateBaseSnapshot();
+  snapshot.GetDirectory().SetCurrentSource("/CurrentSourceDirectory");
+  snapshot.GetDirectory().SetCurrentBinary("/CurrentBinaryDirectory");
+  cmMakefile mf(&gg, snapshot);
+  mf.AddDefinition("A", "a");
+  mf.AddDefinition("B", "A");
+  mf.AddDefinition("L", "x;y");
+
+  for (std::string const& source : sources) {
+    auto const start = std::chrono::steady_clock::now();
+    std::string value;
+    for (int i = 0; i < NumberOfExpansions; ++i) {
+      value = source;
+      mf.ExpandVariablesInString(value);
+    }
+    auto const ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - start)
+                      .count();
+    std::cout << ns / NumberOfExpansions << " ns: " << source << '\n';
+  }
+  return 0;
+}
@@ -0,0 +1,105 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+
+/* Measure reading of GCC-style dependencies files.
+
+   Usage: benchGccDepfileReader [<depfile>...]
+
+   Without arguments, a corpus of large dependencies files resembling
+   those written by GCC and Clang for a C++ project is generated in the
+   current working directory.  Each file of the corpus is read once
+   normalizing every path, and once sharing a path table between files
+   as the Makefile generators do.  This program is built only if the
+   CMake_BUILD_BENCHMARKS option is enabled.  */
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <cm/optional>
+
+#include "cmsys/FStream.hxx"
+
+#include "cmGccDepfileReader.h"
+#include "cmGccDepfileReaderTypes.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+
+namespace {
+
+std::size_t const NumberOfDepfiles = 500;
+std::size_t const NumberOfSystemHeaders = 600;
+std::size_t const NumberOfProjectHeaders = 200;
+
+std::vector<std::string> GenerateCorpus(std::string const& dir)
+{
+  cmSystemTools::MakeDirectory(dir);
+  std::vector<std::string> depfiles;
+  for (std::size_t i = 0; i < NumberOfDepfiles; ++i) {
+    std::string const depfile =
+      cmStrCat(dir, "/source", std::to_string(i), ".cxx.o.d");
+    cmsys::ofstream fout(depfile.c_str());
+    fout << "CMakeFiles/bench.dir/source" << i << ".cxx.o: \\\n"
+         << "  ../src/source" << i << ".cxx \\\n";
+    for (std::size_t h = 0; h < NumberOfSystemHeaders; ++h) {
+      fout << "  /usr/lib/gcc/x86_64-linux-gnu/13/../../../../include/c++/13/"
+           << "bits/header" << h << ".h \\\n";
+    }
+    for (std::size_t h = 0; h < NumberOfProjectHeaders; ++h) {
+      fout << "  ../src/module" << (h % 10) << "/../include/header" << h
+           << ".h \\\n";
+    }
+    fout << "  ../src/last.h\n";
+    depfiles.push_back(depfile);
+  }
+  return depfiles;
+}
+
+double ReadAll(std::vector<std::string> const& depfiles,
+               std::string const& prefix, cmGccDepfilePathTable* pathTable,
+               std::size_t& paths)
+{
+  auto const start = std::chrono::steady_clock::now();
+  paths = 0;
+  for (std::string const& depfile : depfiles) {
+    auto const content = cmReadGccDepfile(
+      depfile.c_str(), prefix, GccDepfilePrependPaths::Deps, pathTable);
+    if (!content) {
+      std::cerr << "Failed to read " << depfile << '\n';
+      continue;
+    }
+    for (cmGccStyleDependency const& dep : *content) {
+      paths += dep.paths.size();
+    }
+  }
+  std::chrono::duration<double, std::milli> const elapsed =
+    std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+  std::string const prefix = cmSystemTools::GetLogicalWorkingDirectory();
+  std::vector<std::string> depfiles;
+  if (argc > 1) {
+    depfiles.assign(argv + 1, argv + argc);
+  } else {
+    depfiles = GenerateCorpus(cmStrCat(prefix, "/benchGccDepfileReader"));
+  }
+
+  std::size_t paths = 0;
+  double const plain = ReadAll(depfiles, prefix, nullptr, paths);
+  std::cout << "Read " << depfiles.size() << " files with " << paths
+            << " paths in " << plain << " ms\n";
+
+  cmGccDepfilePathTable pathTable;
+  double const shared = ReadAll(depfiles, prefix, &pathTable, paths);
+  std::cout << "Read " << depfiles.size() << " files with " << paths
+            << " paths in " << shared << " ms sharing a table of "
+            << pathTable.size() << " paths\n";
+  return 0;
+}
@@ -0,0 +1,112 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+
+/* Measure writing of Ninja build statements.
+
+   Usage: benchNinjaWriteBuild [<statements>]
+
+   Build statements resembling those compiling the sources of a C++
+   target, each binding several flag variables, are written to a file in
+   the current working directory.  They are written once by WriteBuild,
+   which appends the variables to the statement buffer, and once more
+   writing their variables one by one by WriteVariable.  This program is
+   built only if the CMake_BUILD_BENCHMARKS option is enabled.  */
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cmsys/FStream.hxx"
+
+#include "cmGlobalNinjaGenerator.h"
+#include "cmNinjaTypes.h"
+#include "cmState.h"
+#include "cmStringAlgorithms.h"
+#include "cmSystemTools.h"
+#include "cmake.h"
+
+namespace {
+
+std::vector<cmNinjaBuild> GenerateStatements(unsigned long count)
+{
+  std::string includes;
+  for (int i = 0; i < 20; ++i) {
+    includes += cmStrCat(" -I/home/user/project/module", i, "/include");
+  }
+
+  std::vector<cmNinjaBuild> statements;
+  statements.reserve(count);
+  for (unsigned long i = 0; i < count; ++i) {
+    std::string const source = cmStrCat("src/source", i, ".cxx");
+    cmNinjaBuild build("CXX_COMPILER__bench_unscanned_Debug");
+    build.Comment = cmStrCat("Compile ", source);
+    build.Outputs.push_back(cmStrCat("CMakeFiles/bench.dir/", source, ".o"));
+    build.ExplicitDeps.push_back(cmStrCat("/home/user/project/", source));
+    build.OrderOnlyDeps.emplace_back(
+      "cmake_object_order_depends_target_bench");
+    build.Variables["DEFINES"] = "-DBENCH_DEFINITION=1 -DBENCH_SHARED";
+    build.Variables["DEP_FILE"] = cmStrCat(build.Outputs.front(), ".d");
+    build.Variables["FLAGS"] = "-g -std=gnu++17 -fPIC -Wall -Wextra";
+    build.Variables["INCLUDES"] = includes;
+    build.Variables["OBJECT_DIR"] = "CMakeFiles/bench.dir";
+    build.Variables["OBJECT_FILE_DIR"] = "CMakeFiles/bench.dir/src";
+    statements.emplace_back(std::move(build));
+  }
+  return statements;
+}
+
+double Elapsed(std::chrono::steady_clock::time_point start)
+{
+  std::chrono::duration<double, std::milli> const elapsed =
+    std::chrono::steady_clock::now() - start;
+  return elapsed.count();
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[])
+{
+  unsigned long count = 20000;
+  if (argc > 1 && !cmStrToULong(argv[1], &count)) {
+    std::cerr << "Invalid number of statements: " << argv[1] << '\n';
+    return 1;
+  }
+
+  cmake cm(cmake::RoleScript, cmState::Script);
+  cmGlobalNinjaGenerator gg(&cm);
+  std::vector<cmNinjaBuild> const statements = GenerateStatements(count);
+  std::string const file =
+    cmStrCat(cmSystemTools::GetLogicalWorkingDirectory(),
+             "/benchNinjaWriteBuild.ninja");
+
+  {
+    cmsys::ofstream fout(file.c_str());
+    auto const start = std::chrono::steady_clock::now();
+    for (cmNinjaBuild const& build : statements) {
+      gg.WriteBuild(fout, build);
+    }
+    fout.flush();
+    double const ms = Elapsed(start);
+    std::cout << "Wrote " << count << " statements with WriteBuild in " << ms
+              << " ms (" << fout.tellp() << " bytes)\n";
+  }
+
+  {
+    cmsys::ofstream fout(file.c_str());
+    auto const start = std::chrono::steady_clock::now();
+    for (cmNinjaBuild const& build : statements) {
+      for (auto const& variable : build.Variables) {
+        cmGlobalNinjaGenerator::WriteVariable(fout, variable.first,
+                                              variable.second, "", 1);
+      }
+    }
+    fout.flush();
+    double const ms = Elapsed(start);
+    std::cout << "Wrote the variables of " << count
+              << " statements with WriteVariable in " << ms << " ms ("
+              << fout.tellp() << " bytes)\n";
+  }
+  return 0;
+}
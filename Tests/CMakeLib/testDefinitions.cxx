@@ -0,0 +1,144 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "cmDefinitions.h"
+#include "cmLinkedTree.h"
+#include "cmState.h"
+#include "cmStateSnapshot.h"
+#include "cmStringPool.h"
+#include "cmValue.h"
+
+#include "testCommon.h"
+
+namespace {
+
+using Tree = cmLinkedTree<cmDefinitions>;
+
+// A directory scope with nested function scopes.
+struct Scopes
+{
+  Tree VarTree;
+  cmStringPool Pool;
+  std::size_t Epoch = 1;
+  std::vector<Tree::iterator> Stack;
+
+  explicit Scopes(std::size_t depth)
+  {
+    this->Stack.push_back(this->VarTree.Push(this->VarTree.Root()));
+    this->Stack.front()->Set("A", "a", this->Pool);
+    this->Stack.front()->Set("B", "b", this->Pool);
+    for (std::size_t i = 0; i < depth; ++i) {
+      this->Stack.push_back(this->VarTree.Push(this->Stack.back()));
+    }
+  }
+
+  cmValue Get(std::string const& key, std::size_t level = ~std::size_t(0))
+  {
+    if (level >= this->Stack.size()) {
+      level = this->Stack.size() - 1;
+    }
+    return cmDefinitions::Get(key, this->Stack[level], this->VarTree.Root(),
+                              this->Epoch);
+  }
+};
+
+bool testNested()
+{
+  std::cout << "testNested()\n";
+
+  Scopes scopes(20);
+  ASSERT_TRUE(scopes.Get("A") && *scopes.Get("A") == "a");
+  ASSERT_TRUE(!scopes.Get("C"));
+
+  // A definition in the innermost scope hides cached lookups.
+  scopes.Stack.back()->Set("A", "inner", scopes.Pool);
+  scopes.Stack.back()->Set("C", "c", scopes.Pool);
+  ASSERT_EQUAL(*scopes.Get("A"), "inner");
+  ASSERT_EQUAL(*scopes.Get("C"), "c");
+  scopes.Stack.back()->Unset("A", scopes.Pool);
+  ASSERT_TRUE(!scopes.Get("A"));
+
+  // Changing an enclosing scope requires a new epoch.
+  ASSERT_EQUAL(*scopes.Get("B", 19), "b");
+  scopes.Stack[10]->Set("B", "middle", scopes.Pool);
+  ++scopes.Epoch;
+  ASSERT_EQUAL(*scopes.Get("B", 19), "middle");
+  ASSERT_EQUAL(*scopes.Get("B", 5), "b");
+  return true;
+}
+
+bool testRaise()
+{
+  std::cout << "testRaise()\n";
+
+  Scopes scopes(20);
+  ASSERT_EQUAL(*scopes.Get("A"), "a");
+
+  // Setting a variable in the parent scope does not affect the
+  // current scope.
+  Tree::iterator inner = scopes.Stack.back();
+  cmDefinitions::Raise("A", inner, scopes.VarTree.Root(), scopes.Epoch,
+                       scopes.Pool);
+  cmDefinitions::Raise("D", inner, scopes.VarTree.Root(), scopes.Epoch,
+                       scopes.Pool);
+  scopes.Stack[19]->Set("A", "parent", scopes.Pool);
+  scopes.Stack[19]->Set("D", "d", scopes.Pool);
+  ASSERT_EQUAL(*scopes.Get("A"), "a");
+  ASSERT_TRUE(!scopes.Get("D"));
+  ASSERT_EQUAL(*scopes.Get("A", 19), "parent");
+  ASSERT_EQUAL(*scopes.Get("D", 19), "d");
+
+  std::vector<std::string> keys =
+    cmDefinitions::ClosureKeys(inner, scopes.VarTree.Root());
+  ASSERT_EQUAL(keys.size(), 2u);
+  return true;
+}
+
+bool testParentScopeChange()
+{
+  std::cout << "testParentScopeChange()\n";
+
+  cmState state(cmState::Project);
+  cmStateSnapshot dir = state.CreateBaseSnapshot();
+  dir.SetDefinition("A", "a");
+  cmStateSnapshot outer = state.CreateFunctionCallSnapshot(dir, "f.cmake");
+  cmStateSnapshot middle =
+    state.CreateFunctionCallSnapshot(outer, "g.cmake");
+  cmStateSnapshot inner =
+    state.CreateFunctionCallSnapshot(middle, "h.cmake");
+
+  // The innermost scope caches what it reads from the directory.
+  ASSERT_EQUAL(*inner.GetDefinition("A"), "a");
+  ASSERT_EQUAL(*inner.GetDefinition("A"), "a");
+
+  // Changes of enclosing scopes invalidate the cache.
+  dir.SetDefinition("A", "b");
+  ASSERT_EQUAL(*inner.GetDefinition("A"), "b");
+  outer.SetDefinition("A", "c");
+  ASSERT_EQUAL(*inner.GetDefinition("A"), "c");
+  outer.RemoveDefinition("A");
+  ASSERT_TRUE(!inner.GetDefinition("A"));
+  dir.RemoveDefinition("A");
+  outer.SetDefinition("A", "d");
+  ASSERT_EQUAL(*inner.GetDefinition("A"), "d");
+
+  // Setting a variable in the parent scope keeps the current value.
+  ASSERT_TRUE(inner.RaiseScope("A", "e"));
+  ASSERT_EQUAL(*inner.GetDefinition("A"), "d");
+  ASSERT_EQUAL(*middle.GetDefinition("A"), "e");
+  return true;
+}
+}
+
+int testDefinitions(int /*unused*/, char* /*unused*/[])
+{
+  return runTests({
+    testNested,
+    testRaise,
+    testParentScopeChange,
+  });
+}
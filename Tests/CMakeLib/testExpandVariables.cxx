@@ -0,0 +1,97 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+
+#include <memory>
+#include <string>
+
+#include <cm/memory>
+
+#include "cmGlobalGenerator.h"
+#include "cmMakefile.h"
+#include "cmState.h"
+#include "cmStateDirectory.h"
+#include "cmStateSnapshot.h"
+#include "cmSystemTools.h"
+#include "cmake.h"
+
+#include "testCommon.h"
+
+namespace {
+
+struct Dummies
+{
+  std::unique_ptr<cmake> CMake;
+  std::unique_ptr<cmGlobalGenerator> GlobalGenerator;
+  std::unique_ptr<cmMakefile> Makefile;
+};
+
+Dummies CreateDummies()
+{
+  Dummies dummies;
+  dummies.CMake = cm::make_unique<cmake>(cmake::RoleScript, cmState::Script);
+  dummies.GlobalGenerator =
+    cm::make_unique<cmGlobalGenerator>(dummies.CMake.get());
+  cmStateSnapshot snapshot =
+    dummies.CMake->GetState()->CreateBaseSnapshot();
+  snapshot.GetDirectory().SetCurrentSource("/CurrentSourceDirectory");
+  snapshot.GetDirectory().SetCurrentBinary("/CurrentBinaryDirectory");
+  dummies.Makefile =
+    cm::make_unique<cmMakefile>(dummies.GlobalGenerator.get(), snapshot);
+  dummies.Makefile->AddDefinition("A", "a");
+  dummies.Makefile->AddDefinition("B", "A");
+  dummies.Makefile->AddDefinition("L", "x;y");
+  return dummies;
+}
+
+std::string Expand(cmMakefile const& mf, std::string source,
+                   bool noEscapes = false, bool atOnly = false,
+                   bool replaceAt = false)
+{
+  mf.ExpandVariablesInString(source, false, noEscapes, atOnly, nullptr, -1,
+                             atOnly, replaceAt);
+  return source;
+}
+
+bool testNoReferences()
+{
+  std::cout << "testNoReferences()\n";
+
+  Dummies dummies = CreateDummies();
+  cmMakefile const& mf = *dummies.Makefile;
+  ASSERT_EQUAL(Expand(mf, ""), "");
+  ASSERT_EQUAL(Expand(mf, "plain text"), "plain text");
+  ASSERT_EQUAL(Expand(mf, "a}b{c\nd;e"), "a}b{c\nd;e");
+  ASSERT_EQUAL(Expand(mf, "user@host"), "user@host");
+  ASSERT_EQUAL(Expand(mf, "${A}", true, true, true), "${A}");
+  ASSERT_EQUAL(Expand(mf, std::string("a\0b", 3)), "a");
+  return true;
+}
+
+bool testReferences()
+{
+  std::cout << "testReferences()\n";
+
+  Dummies dummies = CreateDummies();
+  cmMakefile const& mf = *dummies.Makefile;
+  cmSystemTools::PutEnv("testExpandVariables=e");
+  ASSERT_EQUAL(Expand(mf, "${A}"), "a");
+  ASSERT_EQUAL(Expand(mf, "<${A}${L}>"), "<ax;y>");
+  ASSERT_EQUAL(Expand(mf, "${${B}}"), "a");
+  ASSERT_EQUAL(Expand(mf, "${undefined}"), "");
+  ASSERT_EQUAL(Expand(mf, "$ENV{testExpandVariables}"), "e");
+  ASSERT_EQUAL(Expand(mf, "$<CONFIG>"), "$<CONFIG>");
+  ASSERT_EQUAL(Expand(mf, "@A@ ${A}", true, true, true), "a ${A}");
+  ASSERT_EQUAL(Expand(mf, "@A@ ${A}", false, false, true), "a a");
+  ASSERT_EQUAL(Expand(mf, "\\t\\${A}\\;"), "\t${A}\\;");
+  ASSERT_EQUAL(Expand(mf, "\\t", true), "\\t");
+  return true;
+}
+}
+
+int testExpandVariables(int /*unused*/, char* /*unused*/[])
+{
+  return runTests({
+    testNoReferences,
+    testReferences,
+  });
+}
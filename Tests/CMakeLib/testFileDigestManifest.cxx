@@ -0,0 +1,136 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+
+#include <ios>
+#include <string>
+
+#include "cmsys/FStream.hxx"
+
+#include "cmFileDigestManifest.h"
+#include "cmFileTimes.h"
+#include "cmGlobalGenerator.h"
+#include "cmMakefile.h"
+#include "cmState.h"
+#include "cmStateSnapshot.h"
+#include "cmake.h"
+
+#include "testCommon.h"
+
+namespace {
+
+std::string const manifest = "testFileDigestManifest.txt";
+std::string const file = "testFileDigestManifest.data";
+
+bool writeFile(std::ios::openmode mode, char const* content = "content\n")
+{
+  cmsys::ofstream fout(file.c_str(), std::ios::out | mode);
+  fout << content;
+  return static_cast<bool>(fout);
+}
+
+bool recordFile()
+{
+  cmsys::ofstream fout(manifest.c_str(), std::ios::out | std::ios::trunc);
+  cmFileDigestManifest::Digests const digests = {
+    { "MD5", "0123" },
+    { "SHA1", "4567" },
+  };
+  return cmFileDigestManifest::Append(fout, file, digests);
+}
+
+bool testRecord()
+{
+  std::cout << "testRecord()\n";
+  ASSERT_TRUE(writeFile(std::ios::trunc));
+  ASSERT_TRUE(recordFile());
+
+  cmFileDigestManifest digests;
+  digests.Load(manifest);
+  ASSERT_EQUAL(digests.GetCount(), 1u);
+  ASSERT_EQUAL(digests.GetDigest(file, "MD5"), "0123");
+  ASSERT_EQUAL(digests.GetDigest(file, "SHA1"), "4567");
+  ASSERT_EQUAL(digests.GetDigest(file, "SHA256"), "");
+  ASSERT_EQUAL(digests.GetDigest("missing", "MD5"), "");
+  return true;
+}
+
+bool testModified()
+{
+  std::cout << "testModified()\n";
+  ASSERT_TRUE(writeFile(std::ios::trunc));
+  ASSERT_TRUE(recordFile());
+
+  cmFileDigestManifest digests;
+  digests.Load(manifest);
+  ASSERT_TRUE(writeFile(std::ios::app));
+  ASSERT_EQUAL(digests.GetDigest(file, "MD5"), "");
+  return true;
+}
+
+bool testModifiedInPlace()
+{
+  std::cout << "testModifiedInPlace()\n";
+  ASSERT_TRUE(writeFile(std::ios::trunc));
+  ASSERT_TRUE(recordFile());
+
+  // Rewrite the content with the same size and restore the times, as
+  // tools editing an installed file in place do.
+  cmFileTimes times;
+  ASSERT_TRUE(times.Load(file));
+  ASSERT_TRUE(writeFile(std::ios::trunc, "CONTENT\n"));
+  ASSERT_TRUE(times.Store(file));
+
+  cmFileDigestManifest digests;
+  digests.Load(manifest);
+  ASSERT_EQUAL(digests.GetCount(), 1u);
+  ASSERT_EQUAL(digests.GetDigest(file, "MD5"), "");
+  return true;
+}
+
+bool testForgotten()
+{
+  std::cout << "testForgotten()\n";
+  ASSERT_TRUE(writeFile(std::ios::trunc));
+  ASSERT_TRUE(recordFile());
+
+  cmake cm(cmake::RoleScript, cmState::Script);
+  cmGlobalGenerator gg(&cm);
+  cmMakefile mf(&gg, cm.GetState()->CreateBaseSnapshot());
+
+  // Nothing is dropped unless a manifest is being recorded.
+  cmFileDigestManifest::Forget(mf, file);
+  cmFileDigestManifest digests;
+  digests.Load(manifest);
+  ASSERT_EQUAL(digests.GetCount(), 1u);
+
+  mf.AddDefinition("CMAKE_INSTALL_DIGEST_MANIFEST", manifest);
+  cmFileDigestManifest::Forget(mf, file);
+  digests.Load(manifest);
+  ASSERT_EQUAL(digests.GetCount(), 0u);
+  ASSERT_EQUAL(digests.GetDigest(file, "MD5"), "");
+
+  // A later record of the file is used again.
+  {
+    cmsys::ofstream fout(manifest.c_str(), std::ios::out | std::ios::app);
+    cmFileDigestManifest::Digests const md5 = { { "MD5", "89ab" } };
+    ASSERT_TRUE(cmFileDigestManifest::Append(fout, file, md5));
+  }
+  digests.Load(manifest);
+  ASSERT_EQUAL(digests.GetDigest(file, "MD5"), "89ab");
+  return true;
+}
+}
+
+int testFileDigestManifest(int /*unused*/, char* /*unused*/[])
+{
+  if (!cmFileDigestManifest::IsSupported()) {
+    std::cout << "Digests of installed files are not recorded here.\n";
+    return 0;
+  }
+  return runTests({
+    testRecord,
+    testModified,
+    testModifiedInPlace,
+    testForgotten,
+  });
+}
@@ -114,6 +114,7 @@ int testGccDepfileReader(int argc, char* argv[])
   std::string dataDirPath = argv[1];
   dataDirPath += "/testGccDepfileReader_data";
   int const numberOfTestFiles = 7; // 6th file doesn't exist
+  cmGccDepfilePathTable pathTable;
   for (int i = 1; i <= numberOfTestFiles; ++i) {
     std::string const base = dataDirPath + "/deps" + std::to_string(i);
     std::string const depfile = base + ".d";
@@ -131,6 +132,16 @@ int testGccDepfileReader(int argc, char* argv[])
         dump("expected", expected);
         return 1;
       }
+      // Read twice with a shared path table to use its entries.
+      for (int pass = 0; pass < 2; ++pass) {
+        auto const shared = cmReadGccDepfile(
+          depfile.c_str(), {}, GccDepfilePrependPaths::All, &pathTable);
+        if (!shared || !compare(*shared, expected)) {
+          std::cerr << "Reading " << depfile
+                    << " with a path table should match\n";
+          return 1;
+        }
+      }
     } else if (actual) {
       std::cerr << "Reading " << depfile << " should have failed\n";
       return 1;
@@ -0,0 +1,113 @@
+/* Distributed under the OSI-approved BSD 3-Clause License.  See accompanying
+   file LICENSE.rst or https://cmake.org/licensing for details.  */
+
+#include <string>
+#include <utility>
+
+#include "cmString.hxx"
+#include "cmStringPool.h"
+
+#include "testCommon.h"
+
+namespace {
+
+bool testShare()
+{
+  std::cout << "testShare()\n";
+
+  cmStringPool pool;
+  std::string const value = "a value long enough to be allocated";
+  cm::String a = pool.Intern(value);
+  cm::String b = pool.Intern(std::string(value));
+  ASSERT_TRUE(a == value);
+  ASSERT_TRUE(a.data() == b.data());
+  ASSERT_TRUE(a.is_stable());
+  ASSERT_EQUAL(pool.GetCount(), 1);
+  ASSERT_EQUAL(pool.GetBytes(), value.size());
+
+  cm::String empty = pool.Intern("");
+  ASSERT_TRUE(empty);
+  ASSERT_TRUE(empty.empty());
+  ASSERT_EQUAL(pool.GetCount(), 2);
+  return true;
+}
+
+bool testSweep()
+{
+  std::cout << "testSweep()\n";
+
+  cmStringPool pool;
+  cm::String kept = pool.Intern("kept");
+  pool.Intern("dropped");
+  ASSERT_EQUAL(pool.GetCount(), 2);
+
+  pool.Sweep();
+  ASSERT_EQUAL(pool.GetCount(), 1);
+  ASSERT_EQUAL(pool.GetBytes(), 4);
+  ASSERT_TRUE(pool.Intern("kept").data() == kept.data());
+  return true;
+}
+
+bool testBounded()
+{
+  std::cout << "testBounded()\n";
+
+  // Values no longer used are dropped as the pool grows.
+  cmStringPool pool;
+  std::string value(cmStringPool::MaxPooledSize, 'x');
+  for (int i = 0; i < 16384; ++i) {
+    value.replace(0, 5, std::to_string(10000 + i));
+    pool.Intern(value);
+  }
+  ASSERT_TRUE(pool.GetBytes() <= (1 << 20) + value.size());
+  return true;
+}
+
+bool testLong()
+{
+  std::cout << "testLong()\n";
+
+  // Values too long to be likely to repeat are not pooled.
+  cmStringPool pool;
+  std::string const value(cmStringPool::MaxPooledSize + 1, 'x');
+  cm::String a = pool.Intern(value);
+  cm::String b = pool.Intern(value);
+  ASSERT_TRUE(a == value);
+  ASSERT_TRUE(a.data() != b.data());
+  ASSERT_EQUAL(pool.GetCount(), 0);
+  ASSERT_EQUAL(pool.GetBytes(), 0);
+  return true;
+}
+
+bool testRelease()
+{
+  std::cout << "testRelease()\n";
+
+  cmStringPool pool;
+  cm::String shared = pool.Intern("shared");
+  cm::String other = shared;
+  cm::String single = pool.Intern("single");
+  ASSERT_EQUAL(pool.GetCount(), 2);
+
+  // A value still used elsewhere is kept.
+  pool.Release(std::move(shared));
+  ASSERT_EQUAL(pool.GetCount(), 2);
+  ASSERT_TRUE(pool.Intern("shared").data() == other.data());
+
+  // The last use of a value drops it right away.
+  pool.Release(std::move(single));
+  ASSERT_EQUAL(pool.GetCount(), 1);
+  ASSERT_EQUAL(pool.GetBytes(), 6);
+
+  // Releasing an equal string that is not the pooled copy keeps it.
+  pool.Release(cm::String(std::string("shared")));
+  ASSERT_EQUAL(pool.GetCount(), 1);
+  return true;
+}
+}
+
+int testStringPool(int /*unused*/, char* /*unused*/[])
+{
+  return runTests(
+    { testShare, testSweep, testBounded, testLong, testRelease });
+}
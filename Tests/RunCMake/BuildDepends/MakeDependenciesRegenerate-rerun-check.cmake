@@ -0,0 +1,5 @@
+file(READ "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/main.dir/compiler_depend.make" deps)
+if(NOT deps MATCHES "MakeDependenciesRegenerate\\.h")
+  set(RunCMake_TEST_FAILED
+    "Consolidated dependencies were discarded by regeneration:\n${deps}")
+endif()
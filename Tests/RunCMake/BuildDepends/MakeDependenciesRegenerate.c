@@ -0,0 +1,6 @@
+#include "MakeDependenciesRegenerate.h"
+
+int main(void)
+{
+  return VALUE;
+}
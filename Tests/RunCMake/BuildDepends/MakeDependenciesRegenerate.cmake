@@ -0,0 +1,6 @@
+enable_language(C)
+
+add_executable(main MakeDependenciesRegenerate.c)
+if(ADD_SOURCE)
+  target_sources(main PRIVATE MakeDependenciesRegenerateExtra.c)
+endif()
@@ -0,0 +1,6 @@
+file(READ "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/main.dir/depend.make" deps)
+if(NOT deps MATCHES "MakeDependenciesRegenerate\\.h" OR
+   NOT deps MATCHES "MakeDependenciesRegenerateExtra\\.c")
+  set(RunCMake_TEST_FAILED
+    "Dependencies of the added source are missing:\n${deps}")
+endif()
@@ -0,0 +1,10 @@
+if(actual_stdout MATCHES "Scanning dependencies of target main")
+  set(RunCMake_TEST_FAILED
+    "Dependencies were scanned again after regeneration:\n${actual_stdout}")
+  return()
+endif()
+file(READ "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/main.dir/depend.make" deps)
+if(NOT deps MATCHES "MakeDependenciesRegenerate\\.h")
+  set(RunCMake_TEST_FAILED
+    "Scanned dependencies were discarded by regeneration:\n${deps}")
+endif()
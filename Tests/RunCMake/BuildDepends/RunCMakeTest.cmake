@@ -200,6 +200,44 @@ endif()
 
 if(RunCMake_GENERATOR MATCHES "Make")
   run_BuildDepends(MakeDependencies)
+
+  block()
+    set(RunCMake_TEST_BINARY_DIR
+      ${RunCMake_BINARY_DIR}/MakeDependenciesRegenerate-build)
+    run_cmake(MakeDependenciesRegenerate)
+    set(RunCMake_TEST_NO_CLEAN 1)
+    run_cmake_command(MakeDependenciesRegenerate-build
+      ${CMAKE_COMMAND} --build .)
+    # The dependencies are consolidated by the build after compilation.
+    run_cmake_command(MakeDependenciesRegenerate-build
+      ${CMAKE_COMMAND} --build .)
+    run_cmake_command(MakeDependenciesRegenerate-rerun
+      ${CMAKE_COMMAND} . -DADD_SOURCE=OFF)
+    run_cmake_command(MakeDependenciesRegenerate-add
+      ${CMAKE_COMMAND} . -DADD_SOURCE=1)
+  endblock()
+
+  # Dependencies scanned by CMake itself are checked against the
+  # DependInfo.cmake and CMakeDirectoryInformation.cmake files, which
+  # regeneration writes only if they change.
+  block()
+    set(RunCMake_TEST_VARIANT_DESCRIPTION "-scanned")
+    set(RunCMake_TEST_BINARY_DIR
+      ${RunCMake_BINARY_DIR}/MakeDependenciesRegenerateScanned-build)
+    set(RunCMake_TEST_OPTIONS -DCMAKE_DEPENDS_USE_COMPILER=FALSE)
+    run_cmake(MakeDependenciesRegenerate)
+    set(RunCMake_TEST_NO_CLEAN 1)
+    run_cmake_command(MakeDependenciesRegenerateScanned-build
+      ${CMAKE_COMMAND} --build .)
+    run_cmake_command(MakeDependenciesRegenerateScanned-rerun
+      ${CMAKE_COMMAND} . -DADD_SOURCE=OFF)
+    run_cmake_command(MakeDependenciesRegenerateScanned-nowork
+      ${CMAKE_COMMAND} -E env VERBOSE=1 ${CMAKE_COMMAND} --build .)
+    run_cmake_command(MakeDependenciesRegenerateScanned-rerun
+      ${CMAKE_COMMAND} . -DADD_SOURCE=1)
+    run_cmake_command(MakeDependenciesRegenerateScanned-add
+      ${CMAKE_COMMAND} -E env VERBOSE=1 ${CMAKE_COMMAND} --build .)
+  endblock()
 endif()
 
 if(RunCMake_GENERATOR MATCHES "Ninja" AND ninja_version VERSION_LESS 1.7)
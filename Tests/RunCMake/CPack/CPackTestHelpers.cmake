@@ -79,7 +79,8 @@ function(run_cpack_test_common_ TEST_NAME types build SUBTEST_SUFFIX source PACK
     if(package_target)
       set(cpack_command_ ${CMAKE_COMMAND} --build "${RunCMake_TEST_BINARY_DIR}" --target package)
     else()
-      set(cpack_command_ ${CMAKE_CPACK_COMMAND} ${pack_params_} -C Debug)
+      set(cpack_command_ ${CMAKE_CPACK_COMMAND} ${pack_params_} -C Debug
+        ${RunCMake_TEST_CPACK_OPTIONS})
     endif()
 
     # execute cpack
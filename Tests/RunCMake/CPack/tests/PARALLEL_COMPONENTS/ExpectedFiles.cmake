@@ -0,0 +1,20 @@
+if(PACKAGING_TYPE STREQUAL "COMPONENT")
+  set(EXPECTED_FILES_COUNT "4")
+  foreach(i RANGE 1 4)
+    set(EXPECTED_FILE_${i} "*-comp${i}.*")
+    set(EXPECTED_FILE_CONTENT_${i}_LIST "/foo${i};/foo${i}/CMakeLists.txt")
+  endforeach()
+elseif(PACKAGING_TYPE STREQUAL "GROUP")
+  set(EXPECTED_FILES_COUNT "3")
+  set(EXPECTED_FILE_1 "*-group1.*")
+  set(EXPECTED_FILE_CONTENT_1_LIST
+    "/foo1"
+    "/foo1/CMakeLists.txt"
+    "/foo2"
+    "/foo2/CMakeLists.txt"
+  )
+  set(EXPECTED_FILE_2 "*-group2.*")
+  set(EXPECTED_FILE_CONTENT_2_LIST "/foo3;/foo3/CMakeLists.txt")
+  set(EXPECTED_FILE_3 "*-comp4.*")
+  set(EXPECTED_FILE_CONTENT_3_LIST "/foo4;/foo4/CMakeLists.txt")
+endif()
@@ -0,0 +1,21 @@
+foreach(i RANGE 1 4)
+  install(FILES CMakeLists.txt DESTINATION foo${i} COMPONENT comp${i})
+endforeach()
+
+# CPACK_THREADS keeps its default of one compression thread.
+set(CPACK_COMPONENTS_PARALLEL 2)
+
+if(PACKAGING_TYPE STREQUAL "GROUP")
+  set(CPACK_COMPONENTS_GROUPING ONE_PER_GROUP)
+  foreach(gen IN ITEMS ARCHIVE DEB)
+    set(CPACK_${gen}_COMPONENT_INSTALL ON)
+  endforeach()
+  include(CPackComponent)
+
+  cpack_add_component_group(group1)
+  cpack_add_component_group(group2)
+  cpack_add_component(comp1 GROUP group1)
+  cpack_add_component(comp2 GROUP group1)
+  cpack_add_component(comp3 GROUP group2)
+  cpack_add_component(comp4)
+endif()
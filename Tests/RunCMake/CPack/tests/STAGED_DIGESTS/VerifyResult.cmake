@@ -0,0 +1,5 @@
+set(whitespaces_ "[\t\n\r ]*")
+set(hashsyms_ "[a-f0-9]+")
+string(MD5 edited_ "modified\n")
+set(md5sums_md5sums "^${hashsyms_}  usr/bar/CMakeLists\.txt${whitespaces_}${hashsyms_}  usr/foo/CMakeLists\.txt${whitespaces_}${edited_}  usr/foo/edited\.txt${whitespaces_}$")
+verifyDebControl("${FOUND_FILE_1}" "md5sums" "md5sums")
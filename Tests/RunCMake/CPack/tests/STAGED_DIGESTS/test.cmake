@@ -0,0 +1,11 @@
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/edited.txt" "original\n")
+install(FILES "${CMAKE_CURRENT_BINARY_DIR}/edited.txt" CMakeLists.txt
+  DESTINATION foo)
+install(FILES CMakeLists.txt DESTINATION bar)
+
+# Rewrite an installed file with content of the same size after its
+# digest was recorded.  The md5sums file must not use the stale digest.
+install(CODE [[
+  file(WRITE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/foo/edited.txt"
+    "modified\n")
+]])
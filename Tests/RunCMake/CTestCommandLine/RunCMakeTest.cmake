@@ -703,3 +703,28 @@ endforeach()
   run_cmake_command(ScheduleRandomSeed1 ${CMAKE_CTEST_COMMAND} --schedule-random --schedule-random-seed 42)
   run_cmake_command(ScheduleRandomSeed2 ${CMAKE_CTEST_COMMAND} --schedule-random --schedule-random-seed 42)
 endblock()
+
+block()
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/ScheduleCriticalPath)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/CTestTestfile.cmake" "
+foreach(t chain1 chain2 chain3 chain4 deep1 deep2 deep3 deep4 deep5 wide1 wide2)
+  add_test(\${t} \"${CMAKE_COMMAND}\" -E true)
+endforeach()
+# A long chain of cheap tests outweighs each expensive independent test.
+set_tests_properties(chain1 chain2 chain3 chain4 PROPERTIES COST 2)
+set_tests_properties(chain2 PROPERTIES DEPENDS chain1)
+set_tests_properties(chain3 PROPERTIES DEPENDS chain2)
+set_tests_properties(chain4 PROPERTIES DEPENDS chain3)
+set_tests_properties(wide1 wide2 PROPERTIES COST 3)
+# A deeper chain of nearly free tests is started first by default.
+set_tests_properties(deep1 deep2 deep3 deep4 deep5 PROPERTIES COST 0.01)
+set_tests_properties(deep2 PROPERTIES DEPENDS deep1)
+set_tests_properties(deep3 PROPERTIES DEPENDS deep2)
+set_tests_properties(deep4 PROPERTIES DEPENDS deep3)
+set_tests_properties(deep5 PROPERTIES DEPENDS deep4)
+")
+  run_cmake_command(ScheduleCriticalPath ${CMAKE_CTEST_COMMAND} -j2 --schedule-critical-path)
+endblock()
@@ -0,0 +1,8 @@
+# The head of the long chain starts before the expensive independent tests
+# and before the head of the deeper chain of nearly free tests.
+string(REGEX MATCHALL "Start +[0-9]+: [a-z0-9]+" starts "${actual_stdout}")
+list(TRANSFORM starts REPLACE "^Start +[0-9]+: " "")
+list(SUBLIST starts 0 2 first)
+if(NOT first STREQUAL "chain1;wide1")
+  set(RunCMake_TEST_FAILED "Tests started in unexpected order:\n  ${starts}")
+endif()
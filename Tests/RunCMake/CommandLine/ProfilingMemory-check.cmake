@@ -0,0 +1,14 @@
+file(READ "${ProfilingTestOutput}" profile)
+set(ws "[ \t\r\n]*")
+set(number "${ws}:${ws}([0-9]+)${ws}")
+if(NOT profile MATCHES "\"target_properties\"${number},${ws}\"variables\"${number}}${ws},[^}]*\"name\"${ws}:${ws}\"memory \\.\"")
+  set(RunCMake_TEST_FAILED "Directory memory counters not found in profile.\n")
+elseif(CMAKE_MATCH_1 EQUAL 0 OR CMAKE_MATCH_2 EQUAL 0)
+  set(RunCMake_TEST_FAILED "Directory memory not estimated: "
+    "target_properties=${CMAKE_MATCH_1} variables=${CMAKE_MATCH_2}\n")
+elseif(NOT profile MATCHES "\"string_pool\"${number},${ws}\"string_pool_strings\"${number},[^}]*}${ws},[^}]*\"configure_memory\"")
+  set(RunCMake_TEST_FAILED "Configure memory counters not found in profile.\n")
+elseif(CMAKE_MATCH_1 EQUAL 0 OR CMAKE_MATCH_2 EQUAL 0)
+  set(RunCMake_TEST_FAILED "String pool not used: "
+    "bytes=${CMAKE_MATCH_1} strings=${CMAKE_MATCH_2}\n")
+endif()
@@ -0,0 +1,3 @@
+set(shared_value "a value set by every directory")
+add_custom_target(memory_target)
+set_property(TARGET memory_target PROPERTY SHARED_VALUE "${shared_value}")
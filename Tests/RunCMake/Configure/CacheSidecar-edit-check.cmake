@@ -0,0 +1,2 @@
+set(expected_text_loads 1)
+include("${CMAKE_CURRENT_LIST_DIR}/CacheSidecar-read-check.cmake")
@@ -0,0 +1,12 @@
+# Every load of the unchanged cache file reads the sidecar.
+if(NOT DEFINED expected_text_loads)
+  set(expected_text_loads 0)
+endif()
+file(READ "${ProfilingOutput}" profile)
+set(ws "[ \t\r\n]*")
+if(NOT profile MATCHES "\"sidecar_loads\"${ws}:${ws}([0-9]+)${ws},${ws}\"text_loads\"${ws}:${ws}([0-9]+)${ws}}[^}]*\"cache_sidecar\"")
+  set(RunCMake_TEST_FAILED "Cache sidecar counters not found in profile.")
+elseif(CMAKE_MATCH_1 EQUAL 0 OR NOT CMAKE_MATCH_2 EQUAL expected_text_loads)
+  set(RunCMake_TEST_FAILED
+    "Unexpected cache sidecar counters: sidecar_loads=${CMAKE_MATCH_1} text_loads=${CMAKE_MATCH_2}")
+endif()
@@ -0,0 +1,6 @@
+set(SIDECAR_VALUE "first" CACHE STRING "Value kept in the sidecar")
+set_property(CACHE SIDECAR_VALUE PROPERTY STRINGS "first;second")
+mark_as_advanced(SIDECAR_VALUE)
+get_property(strings CACHE SIDECAR_VALUE PROPERTY STRINGS)
+get_property(advanced CACHE SIDECAR_VALUE PROPERTY ADVANCED)
+message(STATUS "value='${SIDECAR_VALUE}' strings='${strings}' advanced='${advanced}'")
@@ -0,0 +1,10 @@
+file(READ "${ProfilingOutput}" profile)
+set(ws "[ \t\r\n]*")
+if(NOT profile MATCHES "\"hits\"${ws}:${ws}([0-9]+)${ws},${ws}\"misses\"${ws}:${ws}([0-9]+)${ws}}[^}]*\"find_package_prefix_cache\"")
+  set(RunCMake_TEST_FAILED "find_package prefix cache counters not found in profile.")
+elseif(NOT CMAKE_MATCH_1 EQUAL 1)
+  # The package redirects directory is created anew by every run, so its
+  # search is a miss.
+  set(RunCMake_TEST_FAILED
+    "Unexpected find_package prefix cache counters: hits=${CMAKE_MATCH_1} misses=${CMAKE_MATCH_2}")
+endif()
@@ -0,0 +1,3 @@
+if(NOT EXISTS "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/FindPackagePrefixCache.bin")
+  set(RunCMake_TEST_FAILED "find_package prefix cache was not written.")
+endif()
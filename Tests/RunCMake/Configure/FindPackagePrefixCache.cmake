@@ -0,0 +1,2 @@
+find_package(Foo CONFIG PATHS "${CMAKE_BINARY_DIR}/prefix" NO_DEFAULT_PATH)
+message(STATUS "Foo_FOUND='${Foo_FOUND}'")
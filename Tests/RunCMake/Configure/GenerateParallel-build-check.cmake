@@ -0,0 +1,5 @@
+foreach(i RANGE 1 8)
+  if(NOT EXISTS "${RunCMake_TEST_BINARY_DIR}/target${i}.txt")
+    string(APPEND RunCMake_TEST_FAILED "target${i} was not built.\n")
+  endif()
+endforeach()
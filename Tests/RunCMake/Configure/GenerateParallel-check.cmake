@@ -0,0 +1,41 @@
+file(READ "${ProfilingOutput}" profile)
+set(ws "[ \t\r\n]*")
+string(CONCAT counters "\"deferred\"${ws}:${ws}([0-9]+)${ws},${ws}"
+  "\"replaced\"${ws}:${ws}([0-9]+)${ws}}${ws},${ws}"
+  "\"cat\"${ws}:${ws}\"generate\"${ws},${ws}"
+  "\"name\"${ws}:${ws}\"generated_file_batch\"")
+if(RunCMake_TEST_VARIANT_DESCRIPTION STREQUAL "-serial")
+  if(profile MATCHES "generated_file_batch")
+    string(APPEND RunCMake_TEST_FAILED
+      "Generated files were deferred without CMAKE_GENERATE_PARALLEL_LEVEL.\n")
+  endif()
+elseif(NOT profile MATCHES "${counters}")
+  string(APPEND RunCMake_TEST_FAILED
+    "Generated file batch counters not found in profile.\n")
+elseif(CMAKE_MATCH_1 EQUAL 0 OR NOT CMAKE_MATCH_2 EQUAL CMAKE_MATCH_1)
+  string(APPEND RunCMake_TEST_FAILED
+    "Unexpected generated file batch counters: "
+    "deferred=${CMAKE_MATCH_1} replaced=${CMAKE_MATCH_2}\n")
+endif()
+
+# The generated tree must not depend on the parallel level.
+file(GLOB_RECURSE files LIST_DIRECTORIES false
+  RELATIVE "${RunCMake_TEST_BINARY_DIR}" "${RunCMake_TEST_BINARY_DIR}/*")
+list(REMOVE_ITEM files CMakeCache.txt CMakeFiles/CMakeConfigureLog.yaml)
+list(SORT files)
+set(tree "")
+foreach(file IN LISTS files)
+  file(SHA256 "${RunCMake_TEST_BINARY_DIR}/${file}" hash)
+  string(APPEND tree "${hash} ${file}\n")
+endforeach()
+set(serialTree "${RunCMake_BINARY_DIR}/GenerateParallel-serial-tree.txt")
+if(RunCMake_TEST_VARIANT_DESCRIPTION STREQUAL "-serial")
+  file(WRITE "${serialTree}" "${tree}")
+else()
+  file(READ "${serialTree}" expect)
+  if(NOT tree STREQUAL expect)
+    string(APPEND RunCMake_TEST_FAILED
+      "The generated tree differs from that of a serial run.\n"
+      "Serial:\n${expect}Parallel:\n${tree}")
+  endif()
+endif()
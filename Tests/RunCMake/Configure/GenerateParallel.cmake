@@ -0,0 +1,7 @@
+enable_testing()
+foreach(i RANGE 1 8)
+  add_custom_target(target${i} ALL
+    COMMAND ${CMAKE_COMMAND} -E touch ${CMAKE_CURRENT_BINARY_DIR}/target${i}.txt
+    )
+  add_test(NAME test${i} COMMAND ${CMAKE_COMMAND} -E true)
+endforeach()
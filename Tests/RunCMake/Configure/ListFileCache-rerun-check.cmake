@@ -0,0 +1,8 @@
+file(READ "${ProfilingOutput}" profile)
+set(ws "[ \t\r\n]*")
+if(NOT profile MATCHES "\"hits\"${ws}:${ws}([0-9]+)${ws},${ws}\"misses\"${ws}:${ws}([0-9]+)")
+  set(RunCMake_TEST_FAILED "List file cache counters not found in profile.")
+elseif(CMAKE_MATCH_1 EQUAL 0 OR CMAKE_MATCH_2 EQUAL 0)
+  set(RunCMake_TEST_FAILED
+    "Unexpected list file cache counters: hits=${CMAKE_MATCH_1} misses=${CMAKE_MATCH_2}")
+endif()
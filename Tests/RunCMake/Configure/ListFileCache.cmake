@@ -0,0 +1,2 @@
+include(${CMAKE_BINARY_DIR}/ListFileCacheInclude.cmake)
+message(STATUS "value='${value}'")
@@ -67,6 +67,80 @@ block()
   run_cmake(RemoveCache)
 endblock()
 
+block()
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/ListFileCache-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}")
+  set(include "${RunCMake_TEST_BINARY_DIR}/ListFileCacheInclude.cmake")
+  file(WRITE "${include}" "set(value 1)\n")
+  set(RunCMake_TEST_OPTIONS -DCMAKE_LIST_FILE_CACHE=ON)
+  run_cmake(ListFileCache)
+  # A change in size is detected even within the file time resolution.
+  file(WRITE "${include}" "set(value 22)\n")
+  set(ProfilingOutput "${RunCMake_TEST_BINARY_DIR}/profile.json")
+  run_cmake_command(ListFileCache-rerun ${CMAKE_COMMAND} .
+    --profiling-format=google-trace --profiling-output=${ProfilingOutput})
+endblock()
+
+block()
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/CacheSidecar-build)
+  set(RunCMake_TEST_OPTIONS -DCMAKE_CACHE_SIDECAR=ON)
+  run_cmake(CacheSidecar)
+  unset(RunCMake_TEST_OPTIONS)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  # The sidecar written by the first run is read in place of the cache
+  # file, whose content is checked since it was written less than a
+  # second before.
+  set(ProfilingOutput "${RunCMake_TEST_BINARY_DIR}/profile.json")
+  run_cmake_command(CacheSidecar-read ${CMAKE_COMMAND} .
+    --profiling-format=google-trace --profiling-output=${ProfilingOutput})
+  # An edit of the cache file that keeps its size is seen even within the
+  # file time resolution.
+  file(READ "${RunCMake_TEST_BINARY_DIR}/CMakeCache.txt" cache)
+  string(REPLACE "SIDECAR_VALUE:STRING=first" "SIDECAR_VALUE:STRING=final"
+    cache "${cache}")
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/CMakeCache.txt" "${cache}")
+  run_cmake_command(CacheSidecar-edit ${CMAKE_COMMAND} .
+    --profiling-format=google-trace --profiling-output=${ProfilingOutput})
+endblock()
+
+block()
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/FindPackagePrefixCache-build)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+  file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}/prefix/lib/cmake")
+  set(RunCMake_TEST_OPTIONS -DCMAKE_FIND_PACKAGE_PREFIX_CACHE=ON)
+  run_cmake(FindPackagePrefixCache)
+  unset(RunCMake_TEST_OPTIONS)
+  # Searches are cached only once the probed directories are older than
+  # the file time resolution.
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1.1)
+  run_cmake_command(FindPackagePrefixCache-store ${CMAKE_COMMAND} .)
+  set(ProfilingOutput "${RunCMake_TEST_BINARY_DIR}/profile.json")
+  run_cmake_command(FindPackagePrefixCache-hit ${CMAKE_COMMAND} .
+    --profiling-format=google-trace --profiling-output=${ProfilingOutput})
+  # Installing the package into the prefix invalidates the cached search.
+  file(WRITE "${RunCMake_TEST_BINARY_DIR}/prefix/lib/cmake/Foo/FooConfig.cmake" "")
+  run_cmake_command(FindPackagePrefixCache-install ${CMAKE_COMMAND} .)
+endblock()
+
+block()
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/GenerateParallel-build)
+  set(ProfilingOutput "${RunCMake_BINARY_DIR}/GenerateParallel-profile.json")
+  set(profiling
+    --profiling-format=google-trace --profiling-output=${ProfilingOutput})
+  set(RunCMake_TEST_OPTIONS -DCMAKE_GENERATE_PARALLEL_LEVEL=1 ${profiling})
+  set(RunCMake_TEST_VARIANT_DESCRIPTION "-serial")
+  run_cmake(GenerateParallel)
+  set(RunCMake_TEST_OPTIONS -DCMAKE_GENERATE_PARALLEL_LEVEL=4 ${profiling})
+  set(RunCMake_TEST_VARIANT_DESCRIPTION "-parallel")
+  run_cmake(GenerateParallel)
+  unset(RunCMake_TEST_VARIANT_DESCRIPTION)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  run_cmake_command(GenerateParallel-build ${CMAKE_COMMAND} --build .)
+endblock()
+
 if(NOT RunCMake_GENERATOR MATCHES "^Ninja Multi-Config$")
   run_cmake(NoCMAKE_CROSS_CONFIGS)
   run_cmake(NoCMAKE_DEFAULT_BUILD_TYPE)
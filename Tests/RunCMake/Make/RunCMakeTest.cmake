@@ -64,6 +64,37 @@ run_VerboseBuildShort()
 
 run_cmake(IncludeRegexSubdir)
 
+function(run_SharedStatCache)
+  # Build a copy of the sources so that a header may be edited during the
+  # build, and include headers from outside of the source and build trees.
+  set(RunCMake_TEST_SOURCE_DIR ${RunCMake_BINARY_DIR}/SharedStatCache-src)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/SharedStatCache-build)
+  set(external ${RunCMake_BINARY_DIR}/SharedStatCache-external)
+  file(REMOVE_RECURSE ${RunCMake_TEST_SOURCE_DIR} ${external})
+  file(COPY
+    ${RunCMake_SOURCE_DIR}/CMakeLists.txt
+    ${RunCMake_SOURCE_DIR}/SharedStatCache.cmake
+    ${RunCMake_SOURCE_DIR}/SharedStatCache
+    DESTINATION ${RunCMake_TEST_SOURCE_DIR})
+  file(WRITE ${external}/external.h "#define SHARED_STAT_CACHE_EXTERNAL\n")
+  set(RunCMake_TEST_OPTIONS
+    -DCMAKE_DEPENDS_USE_COMPILER=FALSE
+    -DEXTERNAL_INCLUDE_DIR=${external})
+  run_cmake(SharedStatCache)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  run_cmake_command(SharedStatCache-build ${CMAKE_COMMAND} --build .)
+  # The headers scanned by the first build are checked by the second one,
+  # and the second target reuses the times read for the first one.
+  run_cmake_command(SharedStatCache-nowork
+    ${CMAKE_COMMAND} -E env VERBOSE=1 ${CMAKE_COMMAND} --build .)
+  # A header of the source tree edited after the first target was scanned
+  # is scanned again for the second target.
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 1.1)
+  file(WRITE ${RunCMake_TEST_BINARY_DIR}/edit-header "")
+  run_cmake_command(SharedStatCache-edit ${CMAKE_COMMAND} --build .)
+endfunction()
+run_SharedStatCache()
+
 function(run_MakefileConflict)
   run_cmake(MakefileConflict)
   set(RunCMake_TEST_NO_CLEAN 1)
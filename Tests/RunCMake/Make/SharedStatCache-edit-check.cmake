@@ -0,0 +1,13 @@
+set(dir "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/SharedStatCache2.dir")
+file(GLOB depends "${dir}/depend.*")
+set(found FALSE)
+foreach(depend IN LISTS depends)
+  file(READ "${depend}" content)
+  if(content MATCHES "extra\\.h")
+    set(found TRUE)
+  endif()
+endforeach()
+if(NOT found)
+  set(RunCMake_TEST_FAILED
+    "The header edited during the build was not scanned again.")
+endif()
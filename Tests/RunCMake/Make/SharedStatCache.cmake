@@ -0,0 +1,17 @@
+enable_language(C)
+set(CMAKE_DEPENDS_SHARED_STAT_CACHE ON)
+include_directories(${EXTERNAL_INCLUDE_DIR})
+
+add_library(SharedStatCache1 STATIC SharedStatCache/source1.c)
+add_library(SharedStatCache2 STATIC SharedStatCache/source2.c)
+
+# Edit a header of the source tree between the scans of the two targets
+# when requested.
+add_custom_target(SharedStatCacheEdit
+  COMMAND ${CMAKE_COMMAND}
+    -DHEADER=${CMAKE_CURRENT_SOURCE_DIR}/SharedStatCache/header.h
+    -DREQUEST=${CMAKE_CURRENT_BINARY_DIR}/edit-header
+    -P ${CMAKE_CURRENT_SOURCE_DIR}/SharedStatCache/edit.cmake
+  )
+add_dependencies(SharedStatCacheEdit SharedStatCache1)
+add_dependencies(SharedStatCache2 SharedStatCacheEdit)
@@ -0,0 +1,4 @@
+if(EXISTS "${REQUEST}")
+  file(WRITE "${HEADER}" "#include \"extra.h\"\n")
+  file(REMOVE "${REQUEST}")
+endif()
@@ -0,0 +1 @@
+#define SHARED_STAT_CACHE_VALUE 1
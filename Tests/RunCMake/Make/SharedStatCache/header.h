@@ -0,0 +1,3 @@
+#include "external.h"
+
+#define SHARED_STAT_CACHE_VALUE 1
@@ -0,0 +1,6 @@
+#include "header.h"
+
+int source1(void)
+{
+  return SHARED_STAT_CACHE_VALUE;
+}
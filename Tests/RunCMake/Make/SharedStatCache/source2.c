@@ -0,0 +1,6 @@
+#include "header.h"
+
+int source2(void)
+{
+  return SHARED_STAT_CACHE_VALUE + 1;
+}
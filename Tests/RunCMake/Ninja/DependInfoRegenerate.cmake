@@ -0,0 +1,6 @@
+enable_language(Fortran)
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/hello.f90" [[
+program hello
+end program
+]])
+add_executable(hello "${CMAKE_CURRENT_BINARY_DIR}/hello.f90")
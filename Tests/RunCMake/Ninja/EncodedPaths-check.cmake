@@ -0,0 +1,16 @@
+file(READ "${RunCMake_TEST_BINARY_DIR}/build.ninja" build_file)
+if(NOT build_file MATCHES "\nbuild dir\\$ with\\$ space/out\\$ put\\.txt")
+  string(APPEND RunCMake_TEST_FAILED
+    "build.ninja does not have the encoded custom command output.\n")
+endif()
+
+file(READ "${RunCMake_TEST_BINARY_DIR}/profile.json" profile)
+set(ws "[ \t\r\n]*")
+if(NOT profile MATCHES "\"bytes\"${ws}:${ws}([0-9]+)${ws},${ws}\"microseconds\"${ws}:${ws}[0-9]+${ws},${ws}\"statements\"${ws}:${ws}([0-9]+)${ws}}${ws},[^}]*\"ninja_build_statements\"")
+  string(APPEND RunCMake_TEST_FAILED
+    "Ninja build statement counters not found in profile.\n")
+elseif(CMAKE_MATCH_1 EQUAL 0 OR CMAKE_MATCH_2 EQUAL 0)
+  string(APPEND RunCMake_TEST_FAILED
+    "No build statements counted: bytes=${CMAKE_MATCH_1} "
+    "statements=${CMAKE_MATCH_2}\n")
+endif()
@@ -0,0 +1,8 @@
+add_custom_command(
+  OUTPUT "${CMAKE_CURRENT_BINARY_DIR}/dir with space/out put.txt"
+  COMMAND "${CMAKE_COMMAND}" -E make_directory "dir with space"
+  COMMAND "${CMAKE_COMMAND}" -E touch "dir with space/out put.txt"
+  WORKING_DIRECTORY "${CMAKE_CURRENT_BINARY_DIR}"
+  )
+add_custom_target(encoded ALL
+  DEPENDS "${CMAKE_CURRENT_BINARY_DIR}/dir with space/out put.txt")
@@ -82,6 +82,16 @@ endfunction()
 run_WithBuild(CommentsWithDollars)
 run_WithBuild(CommentsWithNewlines)
 
+function(run_EncodedPaths)
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/EncodedPaths-build)
+  set(RunCMake_TEST_OPTIONS --profiling-format=google-trace
+    --profiling-output=${RunCMake_TEST_BINARY_DIR}/profile.json)
+  run_cmake(EncodedPaths)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  run_cmake_command(EncodedPaths-build ${CMAKE_COMMAND} --build .)
+endfunction()
+run_EncodedPaths()
+
 function(run_VerboseBuild)
   run_cmake(VerboseBuild)
   set(RunCMake_TEST_NO_CLEAN 1)
@@ -289,6 +299,24 @@ function(sleep delay)
   endif()
 endfunction(sleep)
 
+if(CMake_TEST_Fortran)
+  function(run_DependInfoRegenerate)
+    set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/DependInfoRegenerate-build)
+    run_cmake(DependInfoRegenerate)
+    set(RunCMake_TEST_NO_CLEAN 1)
+    set(tdi "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/hello.dir/FortranDependInfo.json")
+    file(TIMESTAMP "${tdi}" mtime_before UTC)
+    sleep(1.1)
+    run_cmake_command(DependInfoRegenerate-rerun ${CMAKE_COMMAND} .)
+    file(TIMESTAMP "${tdi}" mtime_after UTC)
+    if(NOT mtime_before STREQUAL mtime_after)
+      message(SEND_ERROR
+        "Regenerating without changes rewrote ${tdi}")
+    endif()
+  endfunction()
+  run_DependInfoRegenerate()
+endif()
+
 macro(ninja_escape_path path out)
   string(REPLACE "\$ " "\$\$" "${out}" "${path}")
   string(REPLACE " " "\$ " "${out}" "${${out}}")
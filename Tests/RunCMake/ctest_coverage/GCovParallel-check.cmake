@@ -0,0 +1,33 @@
+# Extract the coverage results, which do not depend on the time of the run.
+function(read_coverage case var)
+  set(dir "${RunCMake_BINARY_DIR}/${case}-build/Testing")
+  file(STRINGS "${dir}/TAG" tag LIMIT_COUNT 1)
+  file(GLOB logs "${dir}/${tag}/Coverage.xml" "${dir}/${tag}/CoverageLog-*.xml")
+  list(SORT logs)
+  set(results "")
+  foreach(log IN LISTS logs)
+    file(READ "${log}" content)
+    string(REGEX MATCHALL
+      "<File [^>]*>|<LOCTested>[0-9]+|<LOCUnTested>[0-9]+|<Line Number=\"[0-9]+\" Count=\"-?[0-9]+\""
+      matches "${content}")
+    list(APPEND results ${matches})
+  endforeach()
+  set("${var}" "${results}" PARENT_SCOPE)
+endfunction()
+
+read_coverage(GCovSerial serial)
+read_coverage(GCovParallel parallel)
+if(NOT serial MATCHES "LOCTested>4")
+  string(APPEND RunCMake_TEST_FAILED "Serial coverage results not found.\n")
+elseif(NOT parallel STREQUAL serial)
+  string(APPEND RunCMake_TEST_FAILED
+    "Parallel coverage results differ from serial ones:\n"
+    "  ${parallel}\nexpected:\n  ${serial}\n")
+endif()
+
+# The directories of the concurrent jobs are removed.
+file(GLOB jobDirs
+  "${RunCMake_BINARY_DIR}/GCovParallel-build/Testing/CoverageInfo/gcov*")
+if(jobDirs)
+  string(APPEND RunCMake_TEST_FAILED "Job directories left: ${jobDirs}\n")
+endif()
@@ -1,10 +1,34 @@
 include(RunCTest)
 
 set(CASE_CTEST_COVERAGE_ARGS "")
+set(COVERAGE_EXTRA_FLAGS "")
 
 function(run_ctest_coverage CASE_NAME)
   set(CASE_CTEST_COVERAGE_ARGS "${ARGN}")
   run_ctest(${CASE_NAME})
 endfunction()
 
-run_ctest_coverage(CoverageQuiet QUIET)
+if(COVERAGE_COMMAND)
+  run_ctest_coverage(CoverageQuiet QUIET)
+endif()
+
+# Process the coverage data files of a target with a fake gcov, once
+# serially and once with several concurrent jobs.
+function(run_GCovParallel)
+  set(COVERAGE_COMMAND "${CMAKE_COMMAND}")
+  set(COVERAGE_EXTRA_FLAGS "-P ${RunCMake_SOURCE_DIR}/fakegcov.cmake")
+  set(CASE_CMAKELISTS_SUFFIX_CODE [[
+add_custom_target(covered)
+foreach(i RANGE 1 8)
+  set(source "${CMAKE_CURRENT_SOURCE_DIR}/source${i}.c")
+  string(REPEAT "int line;\n" ${i} content)
+  file(WRITE "${source}" "${content}")
+  file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/covered.dir/source${i}.gcda"
+    "${source}")
+endforeach()
+]])
+  set(RunCTest_VERBOSE_FLAG -VV)
+  run_ctest(GCovSerial -j1)
+  run_ctest(GCovParallel -j4)
+endfunction()
+run_GCovParallel()
@@ -0,0 +1,33 @@
+# Emulate gcov on the coverage data file named last on the command line.
+# It holds the path of its source file.  Write a .gcov file to the working
+# directory in which every other line of the source file is executed, and
+# print what gcov prints for it.
+math(EXPR last "${CMAKE_ARGC} - 1")
+set(gcda "${CMAKE_ARGV${last}}")
+file(READ "${gcda}" source)
+get_filename_component(name "${source}" NAME)
+file(STRINGS "${source}" lines)
+
+set(gcov "        -:    0:Source:${source}\n")
+set(number 0)
+set(executed 0)
+foreach(line IN LISTS lines)
+  math(EXPR number "${number} + 1")
+  math(EXPR odd "${number} % 2")
+  if(odd)
+    set(count "        1")
+    math(EXPR executed "${executed} + 1")
+  else()
+    set(count "    #####")
+  endif()
+  string(LENGTH "${number}" length)
+  math(EXPR length "5 - ${length}")
+  string(REPEAT " " ${length} pad)
+  string(APPEND gcov "${count}:${pad}${number}:${line}\n")
+endforeach()
+file(WRITE "${name}.gcov" "${gcov}")
+
+execute_process(COMMAND ${CMAKE_COMMAND} -E echo "File '${source}'")
+execute_process(COMMAND ${CMAKE_COMMAND} -E echo
+  "Lines executed:${executed}.00% of ${number}")
+execute_process(COMMAND ${CMAKE_COMMAND} -E echo "Creating '${name}.gcov'")
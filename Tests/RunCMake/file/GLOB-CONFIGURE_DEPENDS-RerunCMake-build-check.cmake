@@ -0,0 +1,9 @@
+set(dirs_file "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/VerifyGlobs.dirs")
+if(NOT EXISTS "${dirs_file}")
+  set(RunCMake_TEST_FAILED "Glob directories file not written:\n  ${dirs_file}")
+  return()
+endif()
+file(STRINGS "${dirs_file}" dirs REGEX "^d ")
+if(NOT dirs MATCHES "/test(;|$)")
+  set(RunCMake_TEST_FAILED "Globbed directory not recorded in:\n  ${dirs_file}\nRecorded:\n  ${dirs}")
+endif()
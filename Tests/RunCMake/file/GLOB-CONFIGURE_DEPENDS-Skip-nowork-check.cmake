@@ -0,0 +1,3 @@
+if(actual_stdout MATCHES "CONTENT_LIST")
+  set(RunCMake_TEST_FAILED "CMake reran although no directory changed.")
+endif()
@@ -0,0 +1,3 @@
+if(NOT EXISTS "${RunCMake_TEST_BINARY_DIR}/verify/verify-globs-ran")
+  set(RunCMake_TEST_FAILED "Globs not verified after a file was added.")
+endif()
@@ -0,0 +1,3 @@
+if(EXISTS "${RunCMake_TEST_BINARY_DIR}/verify/verify-globs-ran")
+  set(RunCMake_TEST_FAILED "Globs verified although no directory changed.")
+endif()
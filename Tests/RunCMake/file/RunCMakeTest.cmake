@@ -182,6 +182,36 @@ else()
     run_cmake_command(GLOB-CONFIGURE_DEPENDS-CMP0009-RerunCMake-rebuild ${CMAKE_COMMAND} --build .)
   endif()
 
+  if(RunCMake_GENERATOR MATCHES "Make|Ninja")
+    # The verification is skipped while the globbed directories keep their
+    # times, which must be old enough to be trusted.
+    set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/GLOB-CONFIGURE_DEPENDS-Skip-build)
+    file(REMOVE_RECURSE "${RunCMake_TEST_BINARY_DIR}")
+    file(MAKE_DIRECTORY "${RunCMake_TEST_BINARY_DIR}/test/sub")
+    file(WRITE "${RunCMake_TEST_BINARY_DIR}/test/sub/1.txt" "1")
+    execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 2.125)
+    run_cmake(GLOB-CONFIGURE_DEPENDS-Skip)
+
+    run_cmake_command(GLOB-CONFIGURE_DEPENDS-Skip-nowork ${CMAKE_COMMAND} --build .)
+
+    # Run a copy of the verification script that leaves a marker when it
+    # runs.  Changing the script itself would regenerate the build system.
+    set(verify "${RunCMake_TEST_BINARY_DIR}/verify")
+    set(marker "${verify}/verify-globs-ran")
+    file(COPY
+      "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/VerifyGlobs.cmake"
+      "${RunCMake_TEST_BINARY_DIR}/CMakeFiles/VerifyGlobs.dirs"
+      DESTINATION "${verify}")
+    file(APPEND "${verify}/VerifyGlobs.cmake" "file(TOUCH \"${marker}\")\n")
+    run_cmake_command(GLOB-CONFIGURE_DEPENDS-Skip-verify
+      ${CMAKE_COMMAND} -E cmake_verify_globs "${verify}/VerifyGlobs.cmake")
+
+    file(WRITE "${RunCMake_TEST_BINARY_DIR}/test/sub/2.txt" "2")
+    run_cmake_command(GLOB-CONFIGURE_DEPENDS-Skip-reverify
+      ${CMAKE_COMMAND} -E cmake_verify_globs "${verify}/VerifyGlobs.cmake")
+    run_cmake_command(GLOB-CONFIGURE_DEPENDS-Skip-rerun ${CMAKE_COMMAND} --build .)
+  endif()
+
   unset(RunCMake_TEST_BINARY_DIR)
   unset(RunCMake_TEST_NO_CLEAN)
   unset(RunCMake_DEFAULT_stderr)
@@ -15,6 +15,7 @@ endif()
 run_cmake(PrefixInPATH)
 run_cmake(Required)
 run_cmake(Optional)
+run_cmake(Parallel)
 run_cmake(NO_CACHE)
 run_cmake(REGISTRY_VIEW-no-view)
 run_cmake(REGISTRY_VIEW-wrong-view)
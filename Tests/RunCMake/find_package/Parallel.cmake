@@ -0,0 +1,15 @@
+set(CMAKE_FIND_PARALLEL_LEVEL 4)
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/prefix/lib/cmake/Foo/FooConfig.cmake" "")
+find_package(Foo CONFIG
+  PATHS ${CMAKE_CURRENT_BINARY_DIR}/does_not_exist ${CMAKE_CURRENT_BINARY_DIR}/prefix
+  NO_DEFAULT_PATH
+  )
+message(STATUS "Foo_DIR='${Foo_DIR}'")
+
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/prefix/bar-1.0/lib/cmake/bar-1.0/bar-config.cmake" "")
+find_package(Bar CONFIG PATHS ${CMAKE_CURRENT_BINARY_DIR}/prefix NO_DEFAULT_PATH)
+message(STATUS "Bar_DIR='${Bar_DIR}'")
+
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/prefix/baz/sub/BazConfig.cmake" "")
+find_package(Baz CONFIG PATHS ${CMAKE_CURRENT_BINARY_DIR}/prefix PATH_SUFFIXES sub NO_DEFAULT_PATH)
+message(STATUS "Baz_DIR='${Baz_DIR}'")
@@ -5,6 +5,12 @@ run_cmake(CMP0074-OLD)
 run_cmake(ComponentRecursion)
 run_cmake(ComponentRequiredAndOptional)
 run_cmake(ConfigureLog)
+block()
+  # Reading the prefixes ahead must not change the recorded candidates.
+  set(RunCMake_TEST_VARIANT_DESCRIPTION "-parallel")
+  set(RunCMake_TEST_OPTIONS -DCMAKE_FIND_PARALLEL_LEVEL=4)
+  run_cmake(ConfigureLog)
+endblock()
 # Two tests because the stderr regex otherwise takes way too long to load.
 run_cmake(ConfigureLogParameters1)
 run_cmake(ConfigureLogParameters2)
@@ -40,6 +46,7 @@ run_cmake(PackageRoot)
 run_cmake(PackageRootNestedConfig)
 run_cmake(PackageRootNestedModule)
 run_cmake(PackageVarOverridesOptional)
+run_cmake(Parallel)
 run_cmake(PolicyPush)
 run_cmake(PolicyPop)
 run_cmake(RequiredOptionValuesClash)
@@ -0,0 +1,24 @@
+function(show)
+  message(STATUS "show ${ARGC}: ${ARGV}")
+endfunction()
+
+set(list "x;y")
+set(ENV{RunCMake_Redefine} "env")
+foreach(i RANGE 1 3)
+  # The call runs before and after its arguments are compiled, and each
+  # time after its command has been redefined.
+  show(a;b "q;${i}" ${list} "${list}" $<CONFIG> \${i} $ENV{RunCMake_Redefine} ${undefined})
+  function(show)
+    message(STATUS "show ${i} ${ARGC}: ${ARGV}")
+  endfunction()
+endforeach()
+
+macro(m)
+  message(STATUS "m 1")
+endmacro()
+foreach(i RANGE 2 4)
+  m()
+  macro(m)
+    message(STATUS "m ${i}")
+  endmacro()
+endforeach()
@@ -0,0 +1,12 @@
+# The repeated inclusions of repeatedInclude.cmake are served by the memo.
+if(NOT DEFINED expected_hits)
+  set(expected_hits 2)
+endif()
+file(READ "${ProfilingOutput}" profile)
+set(ws "[ \t\r\n]*")
+if(NOT profile MATCHES "\"hits\"${ws}:${ws}([0-9]+)${ws},${ws}\"misses\"${ws}:${ws}[0-9]+${ws}}${ws},${ws}\"cat\"${ws}:${ws}\"cmake\"${ws},${ws}\"name\"${ws}:${ws}\"parsed_list_file_memo\"")
+  set(RunCMake_TEST_FAILED "Parsed list file memo counters not found in profile.")
+elseif(CMAKE_MATCH_1 LESS ${expected_hits})
+  set(RunCMake_TEST_FAILED
+    "Expected at least ${expected_hits} memo hits, got ${CMAKE_MATCH_1}.")
+endif()
@@ -0,0 +1,3 @@
+# The second inclusion of editedInclude.cmake is served by the memo, too.
+set(expected_hits 3)
+include(${CMAKE_CURRENT_LIST_DIR}/IncludeRepeated-check.cmake)
@@ -0,0 +1,30 @@
+set(count 0)
+foreach(i RANGE 1 3)
+  include(repeatedInclude.cmake)
+endforeach()
+message(STATUS "count='${count}'")
+
+set(rewritten "${CMAKE_CURRENT_BINARY_DIR}/rewrittenInclude.cmake")
+file(WRITE "${rewritten}" "set(value 1)\n")
+include("${rewritten}")
+file(WRITE "${rewritten}" "set(value 2)\n")
+include("${rewritten}")
+message(STATUS "value='${value}'")
+
+# Diagnostics from parsing are reported for every inclusion.
+include(warningInclude.cmake)
+include(warningInclude.cmake)
+
+# A file reused from the memo is parsed again once it is edited.  The
+# file is written by the first run so that it is old enough to be reused
+# by the second.
+set(editedFile "${CMAKE_CURRENT_BINARY_DIR}/editedInclude.cmake")
+if(EXISTS "${editedFile}")
+  include("${editedFile}")
+  include("${editedFile}")
+  file(WRITE "${editedFile}" "set(edited 2)\n")
+  include("${editedFile}")
+  message(STATUS "edited='${edited}'")
+else()
+  file(WRITE "${editedFile}" "set(edited 1)\n")
+endif()
@@ -6,6 +6,18 @@ run_cmake(CMP0024-NEW)
 run_cmake(ExportExportInclude)
 run_cmake(IncludeIsDirectory)
 run_cmake(IncludeMalformed)
+block()
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/IncludeRepeated-build)
+  set(ProfilingOutput "${RunCMake_TEST_BINARY_DIR}/profile.json")
+  set(RunCMake_TEST_OPTIONS
+    --profiling-format=google-trace --profiling-output=${ProfilingOutput})
+  run_cmake(IncludeRepeated)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  # Let the edited file become old enough to be reused from the memo.
+  execute_process(COMMAND ${CMAKE_COMMAND} -E sleep 2.1)
+  run_cmake_command(IncludeRepeated-rerun ${CMAKE_COMMAND} .
+    --profiling-format=google-trace --profiling-output=${ProfilingOutput})
+endblock()
 run_cmake(ParentVariableRoot)
 run_cmake(ParentVariableSubDir)
 run_cmake_script(ParentVariableScript)
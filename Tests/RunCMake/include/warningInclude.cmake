@@ -0,0 +1 @@
+message(STATUS "warning"" include")
@@ -11,3 +11,15 @@ run_cmake(ImportedTarget)
 run_cmake(CMP0021)
 run_cmake(install_config)
 run_cmake(incomplete-genex)
+
+if(RunCMake_GENERATOR MATCHES "Make|Ninja")
+  block()
+    set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/SharedIncludeDirs-build)
+    set(ProfilingOutput "${RunCMake_TEST_BINARY_DIR}/profile.json")
+    list(APPEND RunCMake_TEST_OPTIONS -DCMAKE_BUILD_TYPE=Debug
+      --profiling-format=google-trace --profiling-output=${ProfilingOutput})
+    run_cmake(SharedIncludeDirs)
+    set(RunCMake_TEST_NO_CLEAN 1)
+    run_cmake_command(SharedIncludeDirs-build ${CMAKE_COMMAND} --build .)
+  endblock()
+endif()
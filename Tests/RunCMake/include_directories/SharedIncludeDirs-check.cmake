@@ -0,0 +1,9 @@
+file(READ "${ProfilingOutput}" profile)
+set(ws "[ \t\r\n]*")
+set(counters "\"hits\"${ws}:${ws}([0-9]+)${ws},${ws}\"misses\"${ws}:${ws}([0-9]+)${ws},${ws}\"paths\"${ws}:${ws}([0-9]+)")
+if(NOT profile MATCHES "${counters}${ws}}${ws},[^}]*\"path_table\"")
+  set(RunCMake_TEST_FAILED "Path table counters not found in profile.\n")
+elseif(CMAKE_MATCH_1 EQUAL 0)
+  set(RunCMake_TEST_FAILED
+    "Path table was not used: misses=${CMAKE_MATCH_2}\n")
+endif()
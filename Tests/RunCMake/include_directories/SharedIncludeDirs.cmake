@@ -0,0 +1,11 @@
+enable_language(C)
+
+# Targets that use the same include directories share their converted forms.
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/inc dir/shared.h"
+  "#define SHARED_VALUE 0\n")
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/shared.c"
+  "#include \"shared.h\"\nint shared(void) { return SHARED_VALUE; }\n")
+include_directories("${CMAKE_CURRENT_BINARY_DIR}/inc dir")
+foreach(i RANGE 1 4)
+  add_library(shared${i} STATIC "${CMAKE_CURRENT_BINARY_DIR}/shared.c")
+endforeach()
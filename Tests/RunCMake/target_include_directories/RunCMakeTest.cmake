@@ -4,3 +4,13 @@ run_cmake(empty_keyword_args)
 run_cmake(include_before)
 run_cmake(include_after)
 run_cmake(include_default)
+
+if(RunCMake_GENERATOR MATCHES "Make|Ninja")
+  block()
+    set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/interface_memo-build)
+    set(ProfilingOutput "${RunCMake_TEST_BINARY_DIR}/profile.json")
+    set(RunCMake_TEST_OPTIONS
+      --profiling-format=google-trace --profiling-output=${ProfilingOutput})
+    run_cmake(interface_memo)
+  endblock()
+endif()
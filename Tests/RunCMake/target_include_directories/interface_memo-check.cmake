@@ -0,0 +1,28 @@
+file(READ "${RunCMake_TEST_BINARY_DIR}/compile_commands.json" compile_commands)
+string(JSON num_commands LENGTH "${compile_commands}")
+if(NOT num_commands EQUAL 3)
+  set(RunCMake_TEST_FAILED "Expected 3 compile commands, got ${num_commands}.")
+  return()
+endif()
+math(EXPR last "${num_commands} - 1")
+foreach(i RANGE ${last})
+  string(JSON command GET "${compile_commands}" ${i} command)
+  foreach(dir IN ITEMS base_dir genex_dir mid_dir)
+    string(REGEX MATCHALL "/${dir}" matches "${command}")
+    list(LENGTH matches count)
+    if(NOT count EQUAL 1)
+      string(APPEND RunCMake_TEST_FAILED
+        "Expected ${dir} once in compile command:\n  ${command}\n")
+    endif()
+  endforeach()
+endforeach()
+
+file(READ "${ProfilingOutput}" profile)
+set(ws "[ \t\r\n]*")
+if(NOT profile MATCHES "\"hits\"${ws}:${ws}([0-9]+)${ws},${ws}\"misses\"${ws}:${ws}([0-9]+)")
+  string(APPEND RunCMake_TEST_FAILED
+    "Interface property memo counters not found in profile.\n")
+elseif(CMAKE_MATCH_1 EQUAL 0)
+  string(APPEND RunCMake_TEST_FAILED
+    "Interface property memo was not used: misses=${CMAKE_MATCH_2}\n")
+endif()
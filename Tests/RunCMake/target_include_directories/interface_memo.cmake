@@ -0,0 +1,22 @@
+enable_language(C)
+set(CMAKE_EXPORT_COMPILE_COMMANDS ON)
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/lib.c" "int lib(void) { return 0; }\n")
+
+add_library(base INTERFACE)
+target_include_directories(base INTERFACE "${CMAKE_CURRENT_BINARY_DIR}/base_dir")
+
+add_library(genex INTERFACE)
+target_include_directories(genex INTERFACE
+  "$<BUILD_INTERFACE:${CMAKE_CURRENT_BINARY_DIR}/genex_dir>")
+
+add_library(mid INTERFACE)
+target_include_directories(mid INTERFACE "${CMAKE_CURRENT_BINARY_DIR}/mid_dir")
+target_link_libraries(mid INTERFACE base)
+
+add_library(top INTERFACE)
+target_link_libraries(top INTERFACE genex mid)
+
+foreach(i RANGE 1 3)
+  add_library(consumer${i} STATIC "${CMAKE_CURRENT_BINARY_DIR}/lib.c")
+  target_link_libraries(consumer${i} PRIVATE top base mid)
+endforeach()
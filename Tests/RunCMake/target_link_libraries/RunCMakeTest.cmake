@@ -30,3 +30,15 @@ run_cmake(StaticPrivateDepNotExported)
 run_cmake(StaticPrivateDepNotTarget)
 run_cmake(UNKNOWN-IMPORTED-GLOBAL)
 run_cmake(empty_keyword_args)
+
+if(RunCMake_GENERATOR MATCHES "Make|Ninja")
+  block()
+    set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/SharedClosure-build)
+    set(ProfilingOutput "${RunCMake_TEST_BINARY_DIR}/profile.json")
+    set(RunCMake_TEST_OPTIONS -DCMAKE_BUILD_TYPE=Debug
+      --profiling-format=google-trace --profiling-output=${ProfilingOutput})
+    run_cmake(SharedClosure)
+    set(RunCMake_TEST_NO_CLEAN 1)
+    run_cmake_command(SharedClosure-build ${CMAKE_COMMAND} --build .)
+  endblock()
+endif()
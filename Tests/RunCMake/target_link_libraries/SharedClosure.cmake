@@ -0,0 +1,34 @@
+enable_language(C)
+
+# Each static library calls into the one below it, so the link line of
+# every executable must list them in order.
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/a.c" "int a(void) { return 0; }\n")
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/b.c"
+  "extern int a(void);\nint b(void) { return a(); }\n")
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/c.c"
+  "extern int b(void);\nint c(void) { return b(); }\n")
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/main.c"
+  "extern int c(void);\nint main(void) { return c(); }\n")
+
+foreach(lib IN ITEMS a b c)
+  add_library(${lib} STATIC "${CMAKE_CURRENT_BINARY_DIR}/${lib}.c")
+  add_library(iface_${lib} INTERFACE)
+endforeach()
+target_link_libraries(iface_a INTERFACE a)
+target_link_libraries(iface_b INTERFACE b iface_a)
+target_link_libraries(iface_c INTERFACE c iface_b)
+
+foreach(i RANGE 1 3)
+  add_executable(main${i} "${CMAKE_CURRENT_BINARY_DIR}/main.c")
+  target_link_libraries(main${i} PRIVATE iface_c)
+endforeach()
+
+# A link interface referring to the target being linked is not shared.
+add_library(iface_head INTERFACE)
+target_link_libraries(iface_head INTERFACE
+  "$<$<BOOL:$<TARGET_PROPERTY:LINK_C>>:iface_c>")
+foreach(i RANGE 4 5)
+  add_executable(main${i} "${CMAKE_CURRENT_BINARY_DIR}/main.c")
+  set_property(TARGET main${i} PROPERTY LINK_C 1)
+  target_link_libraries(main${i} PRIVATE iface_head)
+endforeach()
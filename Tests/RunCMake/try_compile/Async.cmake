@@ -0,0 +1,38 @@
+enable_language(C)
+
+try_compile(RESULT_GOOD
+  SOURCE_FROM_CONTENT src.c "int main(void) { return 0; }\n"
+  OUTPUT_VARIABLE out_good
+  COPY_FILE "${CMAKE_CURRENT_BINARY_DIR}/out_good.bin"
+  NO_CACHE
+  ASYNC
+  )
+try_compile(RESULT_BAD
+  SOURCE_FROM_CONTENT src.c "does-not-compile\n"
+  OUTPUT_VARIABLE out_bad
+  NO_CACHE
+  ASYNC
+  )
+if(DEFINED RESULT_GOOD OR DEFINED RESULT_BAD)
+  message(FATAL_ERROR "try_compile(ASYNC) results set before WAIT")
+endif()
+
+try_compile(WAIT)
+if(NOT RESULT_GOOD)
+  message(FATAL_ERROR "try_compile(ASYNC) failed:\n${out_good}")
+endif()
+if(NOT EXISTS "${CMAKE_CURRENT_BINARY_DIR}/out_good.bin")
+  message(FATAL_ERROR "try_compile(ASYNC) did not copy its output file")
+endif()
+if(RESULT_BAD)
+  message(FATAL_ERROR "try_compile(ASYNC) of bad source succeeded")
+endif()
+if(NOT out_bad MATCHES "does-not-compile")
+  message(FATAL_ERROR "try_compile(ASYNC) output lacks the error:\n${out_bad}")
+endif()
+
+# Checks not waited for are done at the end of their directory.
+add_subdirectory(Async)
+if(NOT RESULT_SUBDIR)
+  message(FATAL_ERROR "try_compile(ASYNC) in subdirectory not done")
+endif()
@@ -47,6 +47,13 @@ run_cmake(NonSourceCopyFile)
 run_cmake(NonSourceCompileDefinitions)
 
 run_cmake(Verbose)
+block()
+  set(RunCMake_TEST_BINARY_DIR ${RunCMake_BINARY_DIR}/TryCompileCache-build)
+  run_cmake(TryCompileCache)
+  set(RunCMake_TEST_NO_CLEAN 1)
+  run_cmake_command(TryCompileCache-module ${CMAKE_COMMAND} . -DTryCompileCache_MODULE_VERSION=2)
+endblock()
+run_cmake(Async)
 
 run_cmake(ProjectVars)
 
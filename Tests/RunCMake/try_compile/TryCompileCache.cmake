@@ -0,0 +1,78 @@
+enable_language(C)
+set(CMAKE_TRY_COMPILE_CACHE_DIR "${CMAKE_CURRENT_BINARY_DIR}/cache")
+
+# The second check is answered by the cache, with the same output.
+foreach(i 1 2)
+  try_compile(RESULT_${i}
+    SOURCE_FROM_CONTENT src.c "int main(void) { return 0; }\n"
+    OUTPUT_VARIABLE out_${i}
+    COPY_FILE "${CMAKE_CURRENT_BINARY_DIR}/out_${i}.bin"
+    NO_CACHE
+    )
+  if(NOT RESULT_${i})
+    message(FATAL_ERROR "try_compile ${i} failed:\n${out_${i}}")
+  endif()
+  if(NOT EXISTS "${CMAKE_CURRENT_BINARY_DIR}/out_${i}.bin")
+    message(FATAL_ERROR "try_compile ${i} did not copy its output file")
+  endif()
+endforeach()
+if(NOT out_1 STREQUAL out_2)
+  message(FATAL_ERROR "try_compile 2 was not answered by the cache")
+endif()
+
+# A check run with a different compiler environment or modules is not
+# answered by the cache.  The modules are read once per configure, so
+# the second configure of this test modifies them.
+if(NOT DEFINED TryCompileCache_MODULE_VERSION)
+  set(TryCompileCache_MODULE_VERSION 1)
+endif()
+set(ENV{CPATH} "${CMAKE_CURRENT_BINARY_DIR}")
+file(WRITE "${CMAKE_CURRENT_BINARY_DIR}/modules/TryCompileCacheModule.cmake"
+  "# version ${TryCompileCache_MODULE_VERSION}\n")
+set(CMAKE_MODULE_PATH "${CMAKE_CURRENT_BINARY_DIR}/modules")
+foreach(i 3 4)
+  try_compile(RESULT_${i}
+    SOURCE_FROM_CONTENT src.c "int main(void) { return 0; }\n"
+    OUTPUT_VARIABLE out_${i}
+    NO_CACHE
+    )
+  if(NOT RESULT_${i})
+    message(FATAL_ERROR "try_compile ${i} failed:\n${out_${i}}")
+  endif()
+endforeach()
+unset(ENV{CPATH})
+unset(CMAKE_MODULE_PATH)
+if(out_3 STREQUAL out_1)
+  message(FATAL_ERROR "try_compile 3 ignored the CPATH environment variable")
+endif()
+if(NOT out_4 STREQUAL out_3)
+  message(FATAL_ERROR "try_compile 4 was not answered by the cache")
+endif()
+set(module_out "${CMAKE_CURRENT_BINARY_DIR}/out_module_1.txt")
+if(TryCompileCache_MODULE_VERSION EQUAL 1)
+  file(WRITE "${module_out}" "${out_3}")
+else()
+  file(READ "${module_out}" out_module_1)
+  if(out_3 STREQUAL out_module_1)
+    message(FATAL_ERROR "try_compile 3 ignored the modified module")
+  endif()
+endif()
+
+# Failures are not cached, since they may be fixed by installing headers
+# or libraries that are not part of the key.
+try_compile(RESULT_BAD
+  SOURCE_FROM_CONTENT src.c "does-not-compile\n"
+  OUTPUT_VARIABLE out_bad
+  NO_CACHE
+  )
+if(RESULT_BAD)
+  message(FATAL_ERROR "try_compile bad succeeded")
+endif()
+
+file(GLOB_RECURSE entries "${CMAKE_TRY_COMPILE_CACHE_DIR}/*/result.txt")
+list(LENGTH entries count)
+math(EXPR expected "${TryCompileCache_MODULE_VERSION} + 1")
+if(NOT count EQUAL expected)
+  message(FATAL_ERROR "Expected ${expected} cache entries, found ${count}:\n"
+    " ${entries}")
+endif()